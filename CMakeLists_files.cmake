@@ -14,19 +14,28 @@ list(APPEND MAIN_SOURCE_FILES
   lib/eclipse/EclipseState/EclipseConfig.cpp
   lib/eclipse/EclipseState/EclipseState.cpp
   lib/eclipse/EclipseState/EndpointScaling.cpp
+  lib/eclipse/EclipseState/Grid/ActiveIndex.cpp
   lib/eclipse/EclipseState/Grid/Box.cpp
   lib/eclipse/EclipseState/Grid/BoxManager.cpp
+  lib/eclipse/EclipseState/Grid/CellLocator.cpp
+  lib/eclipse/EclipseState/Grid/ConnectionGraph.cpp
   lib/eclipse/EclipseState/Grid/EclipseGrid.cpp
   lib/eclipse/EclipseState/Grid/FaceDir.cpp
+  lib/eclipse/EclipseState/Grid/FaceMultipliers.cpp
   lib/eclipse/EclipseState/Grid/FaultCollection.cpp
   lib/eclipse/EclipseState/Grid/Fault.cpp
   lib/eclipse/EclipseState/Grid/FaultFace.cpp
+  lib/eclipse/EclipseState/Grid/FaultIndex.cpp
   lib/eclipse/EclipseState/Grid/GridDims.cpp
+  lib/eclipse/EclipseState/Grid/GridGeometry.cpp
   lib/eclipse/EclipseState/Grid/GridProperties.cpp
   lib/eclipse/EclipseState/Grid/GridProperty.cpp
   lib/eclipse/EclipseState/Grid/MULTREGTScanner.cpp
   lib/eclipse/EclipseState/Grid/NNC.cpp
+  lib/eclipse/EclipseState/Grid/NNCIndex.cpp
+  lib/eclipse/EclipseState/Grid/Partition.cpp
   lib/eclipse/EclipseState/Grid/PinchMode.cpp
+  lib/eclipse/EclipseState/Grid/PinchProcessor.cpp
   lib/eclipse/EclipseState/Grid/SatfuncPropertyInitializers.cpp
   lib/eclipse/EclipseState/Grid/setKeywordBox.cpp
   lib/eclipse/EclipseState/Grid/TransMult.cpp
@@ -57,6 +66,7 @@ list(APPEND MAIN_SOURCE_FILES
   lib/eclipse/EclipseState/Schedule/WellProductionProperties.cpp
   lib/eclipse/EclipseState/SimulationConfig/SimulationConfig.cpp
   lib/eclipse/EclipseState/SimulationConfig/ThresholdPressure.cpp
+  lib/eclipse/EclipseState/StateLoader.cpp
   lib/eclipse/EclipseState/SummaryConfig/SummaryConfig.cpp
   lib/eclipse/EclipseState/Tables/ColumnSchema.cpp
   lib/eclipse/EclipseState/Tables/JFunc.cpp
@@ -72,6 +82,7 @@ list(APPEND MAIN_SOURCE_FILES
   lib/eclipse/EclipseState/Tables/VFPProdTable.cpp
   lib/eclipse/Parser/MessageContainer.cpp
   lib/eclipse/Parser/ParseContext.cpp
+  lib/eclipse/Parser/ParseStatistics.cpp
   lib/eclipse/Parser/Parser.cpp
   lib/eclipse/Parser/ParserEnums.cpp
   lib/eclipse/Parser/ParserItem.cpp
@@ -82,8 +93,14 @@ list(APPEND MAIN_SOURCE_FILES
   lib/eclipse/RawDeck/StarToken.cpp
   lib/eclipse/Units/Dimension.cpp
   lib/eclipse/Units/UnitSystem.cpp
+  lib/eclipse/Utility/BinaryBuffer.cpp
+  lib/eclipse/Utility/EclipseArrayFile.cpp
   lib/eclipse/Utility/Functional.cpp
+  lib/eclipse/Utility/MappedFile.cpp
   lib/eclipse/Utility/Stringview.cpp
+  lib/eclipse/Utility/SyntheticDeck.cpp
+  lib/eclipse/Utility/TaskGraph.cpp
+  lib/eclipse/Utility/Trace.cpp
 )
 
 # For now, we use full directory installs from install_hook
@@ -91,35 +108,53 @@ list (APPEND PUBLIC_HEADER_FILES
 )
 
 list (APPEND EXAMPLE_SOURCE_FILES
+  applications/opmgen.cpp
   applications/opmi.cpp
 )
 
 # programs listed here will not only be compiled, but also marked for
 # installation
 list (APPEND PROGRAM_SOURCE_FILES
+  applications/opmgen.cpp
   applications/opmi.cpp
 )
 
+# benchmarks are only built when BUILD_BENCHMARKS is enabled
+list (APPEND BENCHMARK_SOURCE_FILES
+  benchmarks/AllocationReport.cpp
+  benchmarks/ParserBenchmarks.cpp
+  benchmarks/ScheduleBenchmarks.cpp
+  benchmarks/StateBenchmarks.cpp
+)
+
 list (APPEND TEST_SOURCE_FILES
+  lib/eclipse/tests/ActiveIndexTests.cpp
   lib/eclipse/tests/ADDREGTests.cpp
   lib/eclipse/tests/AqudimsTests.cpp
   lib/eclipse/tests/AquanconTests.cpp
+  lib/eclipse/tests/BinaryBufferTests.cpp
   lib/eclipse/tests/BoxTests.cpp
+  lib/eclipse/tests/CellLocatorTests.cpp
   lib/eclipse/tests/ColumnSchemaTests.cpp
   lib/eclipse/tests/CompletionTests.cpp
+  lib/eclipse/tests/ConcurrentAccessTests.cpp
+  lib/eclipse/tests/ConnectionGraphTests.cpp
   lib/eclipse/tests/COMPSEGUnits.cpp
   lib/eclipse/tests/CopyRegTests.cpp
   lib/eclipse/tests/DeckTests.cpp
   lib/eclipse/tests/DynamicStateTests.cpp
   lib/eclipse/tests/DynamicVectorTests.cpp
   lib/eclipse/tests/Eclipse3DPropertiesTests.cpp
+  lib/eclipse/tests/EclipseArrayFileTests.cpp
   lib/eclipse/tests/EclipseGridTests.cpp
   lib/eclipse/tests/EqualRegTests.cpp
   lib/eclipse/tests/EventTests.cpp
   lib/eclipse/tests/FaceDirTests.cpp
+  lib/eclipse/tests/FaceMultipliersTests.cpp
   lib/eclipse/tests/FaultTests.cpp
   lib/eclipse/tests/FunctionalTests.cpp
   lib/eclipse/tests/GeomodifierTests.cpp
+  lib/eclipse/tests/GridGeometryTests.cpp
   lib/eclipse/tests/GridPropertyTests.cpp
   lib/eclipse/tests/GroupTests.cpp
   lib/eclipse/tests/InitConfigTest.cpp
@@ -129,8 +164,11 @@ list (APPEND TEST_SOURCE_FILES
   lib/eclipse/tests/MultiRegTests.cpp
   lib/eclipse/tests/MultisegmentWellTests.cpp
   lib/eclipse/tests/MULTREGTScannerTests.cpp
+  lib/eclipse/tests/NNCIndexTests.cpp
   lib/eclipse/tests/OrderedMapTests.cpp
   lib/eclipse/tests/ParseContextTests.cpp
+  lib/eclipse/tests/PartitionTests.cpp
+  lib/eclipse/tests/PinchProcessorTests.cpp
   lib/eclipse/tests/PORVTests.cpp
   lib/eclipse/tests/RawKeywordTests.cpp
   lib/eclipse/tests/RestartConfigTests.cpp
@@ -141,15 +179,19 @@ list (APPEND TEST_SOURCE_FILES
   lib/eclipse/tests/SimpleTableTests.cpp
   lib/eclipse/tests/SimulationConfigTest.cpp
   lib/eclipse/tests/StarTokenTests.cpp
+  lib/eclipse/tests/StateLoaderTests.cpp
   lib/eclipse/tests/StringTests.cpp
   lib/eclipse/tests/SummaryConfigTests.cpp
+  lib/eclipse/tests/SyntheticDeckTests.cpp
   lib/eclipse/tests/TabdimsTests.cpp
   lib/eclipse/tests/TableColumnTests.cpp
   lib/eclipse/tests/TableContainerTests.cpp
   lib/eclipse/tests/TableManagerTests.cpp
   lib/eclipse/tests/TableSchemaTests.cpp
+  lib/eclipse/tests/TaskGraphTests.cpp
   lib/eclipse/tests/ThresholdPressureTest.cpp
   lib/eclipse/tests/TimeMapTest.cpp
+  lib/eclipse/tests/TraceTests.cpp
   lib/eclipse/tests/TransMultTests.cpp
   lib/eclipse/tests/TuningTests.cpp
   lib/eclipse/tests/UnitTests.cpp
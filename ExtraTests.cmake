@@ -46,6 +46,15 @@ opm_add_test(EclipseStateTests
              TEST_ARGS ${_testdir}/integration_tests/)
 list(APPEND EXTRA_TESTS EclipseStateTests)
 
+# The allocation budget tests count allocations with the operator new
+# replacement of the benchmarks.
+opm_add_test(AllocationBudgetTests
+             SOURCES lib/eclipse/tests/AllocationBudgetTests.cpp
+                     benchmarks/AllocationCounter.cpp
+             LIBRARIES ${TEST_LIBS})
+target_include_directories(AllocationBudgetTests PRIVATE ${PROJECT_SOURCE_DIR}/benchmarks)
+list(APPEND EXTRA_TESTS AllocationBudgetTests)
+
 foreach (test BoxTest
               CheckDeckValidity
               CompletionsFromDeck
@@ -17,6 +17,8 @@ set(genkw_SOURCES lib/eclipse/Parser/createDefaultKeywordList.cpp
                   lib/eclipse/RawDeck/StarToken.cpp
                   lib/eclipse/Units/Dimension.cpp
                   lib/eclipse/Units/UnitSystem.cpp
+                  lib/eclipse/Utility/BinaryBuffer.cpp
+                  lib/eclipse/Utility/MappedFile.cpp
                   lib/eclipse/Utility/Stringview.cpp
 )
 add_executable(genkw ${genkw_SOURCES})
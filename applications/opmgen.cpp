@@ -0,0 +1,95 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include <opm/parser/eclipse/Utility/SyntheticDeck.hpp>
+
+
+inline void usage( const char* program ) {
+    std::cerr << "Usage: " << program << " [options] OUTPUT.DATA" << std::endl
+              << std::endl
+              << "Generate a synthetic deck; the same options and seed always give the same deck." << std::endl
+              << std::endl
+              << "  --nx N --ny N --nz N   Grid dimensions (10 10 5)" << std::endl
+              << "  --wells N              Number of wells (4)" << std::endl
+              << "  --steps N              Number of report steps (12)" << std::endl
+              << "  --repeat N             Length of runs of equal property values (1)" << std::endl
+              << "  --regions N            Number of MULTNUM and FIPNUM regions (4)" << std::endl
+              << "  --faults N             Number of faults (1)" << std::endl
+              << "  --seed N               Random seed (1)" << std::endl
+              << "  --split                Write grid, properties and schedule to include files" << std::endl;
+}
+
+
+int main(int argc, char** argv) {
+    Opm::SyntheticDeck::Options options;
+    const std::map< std::string, size_t* > sizes = {
+        { "--nx",      &options.nx },
+        { "--ny",      &options.ny },
+        { "--nz",      &options.nz },
+        { "--wells",   &options.wells },
+        { "--steps",   &options.steps },
+        { "--repeat",  &options.repeat },
+        { "--regions", &options.regions },
+        { "--faults",  &options.faults }
+    };
+
+    bool split = false;
+    std::string output;
+    for (int iarg = 1; iarg < argc; iarg++) {
+        const std::string arg( argv[iarg] );
+        const auto size = sizes.find( arg );
+
+        if (size != sizes.end() && iarg + 1 < argc)
+            *size->second = std::strtoul( argv[++iarg], nullptr, 10 );
+        else if (arg == "--seed" && iarg + 1 < argc)
+            options.seed = std::strtoull( argv[++iarg], nullptr, 10 );
+        else if (arg == "--split")
+            split = true;
+        else if (arg.size() > 0 && arg[0] != '-' && output.empty())
+            output = arg;
+        else {
+            usage( argv[0] );
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (output.empty()) {
+        usage( argv[0] );
+        return EXIT_FAILURE;
+    }
+
+    try {
+        const Opm::SyntheticDeck deck( options );
+        if (split)
+            deck.writeSplit( output );
+        else
+            deck.write( output );
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -18,15 +18,22 @@
 */
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/MessageContainer.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/ParseStatistics.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
-#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
+
+#ifdef OPM_PARSE_PROFILING
+#include "AllocationCounter.hpp"
+#endif
 
 inline void dumpMessages( const Opm::MessageContainer& messageContainer) {
     auto extractMessage = [](const Opm::Message& msg) {
@@ -43,9 +50,10 @@ inline void dumpMessages( const Opm::MessageContainer& messageContainer) {
 }
 
 
-inline void loadDeck( const char * deck_file) {
+inline void loadDeck( const char * deck_file, bool profile) {
     Opm::ParseContext parseContext;
     Opm::Parser parser;
+    parser.setProfiling( profile );
 
     std::cout << "Loading deck: " << deck_file << " ..... "; std::cout.flush();
     auto deck = parser.parseFile(deck_file, parseContext);
@@ -56,11 +64,46 @@ inline void loadDeck( const char * deck_file) {
     std::cout << "complete." << std::endl;
 
     dumpMessages( deck.getMessageContainer() );
+
+    if (deck.hasParseStatistics()) {
+        std::cout << std::endl;
+        deck.getParseStatistics().report( std::cout );
+    }
 }
 
 
 int main(int argc, char** argv) {
-    for (int iarg = 1; iarg < argc; iarg++)
-        loadDeck( argv[iarg] );
+    bool profile = false;
+    std::vector< const char* > deck_files;
+    for (int iarg = 1; iarg < argc; iarg++) {
+        const std::string arg( argv[iarg] );
+        if (arg == "--profile") {
+#ifdef OPM_PARSE_PROFILING
+            profile = true;
+#else
+            std::cerr << "--profile is not available: parse profiling is not compiled in" << std::endl;
+            return 1;
+#endif
+        } else if (arg == "--trace" && iarg + 1 < argc)
+            Opm::Trace::enable( argv[++iarg] );
+        else
+            deck_files.push_back( argv[iarg] );
+    }
+
+#ifdef OPM_PARSE_PROFILING
+    /*
+      The allocations for the --profile report are counted by the operator
+      new replacement in benchmarks/AllocationCounter.cpp, which is only
+      linked when parse profiling is compiled in.
+    */
+    Opm::Benchmark::setCounting( profile );
+    if (profile)
+        Opm::Benchmark::installParseStatisticsCounter();
+#endif
+
+    for (const auto* deck_file : deck_files)
+        loadDeck( deck_file, profile );
+
+    if (Opm::Trace::enabled())
+        Opm::Trace::flush();
 }
-
@@ -0,0 +1,190 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <ostream>
+
+#include <opm/parser/eclipse/Parser/ParseStatistics.hpp>
+
+#include "AllocationCounter.hpp"
+
+namespace {
+
+    std::atomic< bool > count_allocations( true );
+    std::atomic< size_t > allocation_count( 0 );
+    std::atomic< size_t > allocation_bytes( 0 );
+
+    void* allocate( std::size_t size ) {
+        if( count_allocations.load( std::memory_order_relaxed ) ) {
+            allocation_count.fetch_add( 1, std::memory_order_relaxed );
+            allocation_bytes.fetch_add( size, std::memory_order_relaxed );
+        }
+
+        void* ptr = std::malloc( size == 0 ? 1 : size );
+        if( !ptr )
+            throw std::bad_alloc();
+
+        return ptr;
+    }
+
+    size_t countAllocations() {
+        return allocation_count.load( std::memory_order_relaxed );
+    }
+
+    size_t countAllocatedBytes() {
+        return allocation_bytes.load( std::memory_order_relaxed );
+    }
+
+}
+
+void* operator new( std::size_t size ) {
+    return allocate( size );
+}
+
+void* operator new[]( std::size_t size ) {
+    return allocate( size );
+}
+
+void* operator new( std::size_t size, const std::nothrow_t& ) noexcept {
+    try {
+        return allocate( size );
+    } catch( const std::bad_alloc& ) {
+        return nullptr;
+    }
+}
+
+void* operator new[]( std::size_t size, const std::nothrow_t& ) noexcept {
+    try {
+        return allocate( size );
+    } catch( const std::bad_alloc& ) {
+        return nullptr;
+    }
+}
+
+/*
+  The replacement deletes are not inlined into the callers in this file,
+  where gcc would otherwise pair the free() with the standard operator new
+  and warn with -Wmismatched-new-delete.
+*/
+#ifdef __GNUC__
+#define OPM_NOINLINE __attribute__((noinline))
+#else
+#define OPM_NOINLINE
+#endif
+
+OPM_NOINLINE void operator delete( void* ptr ) noexcept {
+    std::free( ptr );
+}
+
+OPM_NOINLINE void operator delete[]( void* ptr ) noexcept {
+    std::free( ptr );
+}
+
+OPM_NOINLINE void operator delete( void* ptr, std::size_t ) noexcept {
+    std::free( ptr );
+}
+
+OPM_NOINLINE void operator delete[]( void* ptr, std::size_t ) noexcept {
+    std::free( ptr );
+}
+
+#undef OPM_NOINLINE
+
+namespace Opm {
+namespace Benchmark {
+
+    Allocations Allocations::operator-( const Allocations& other ) const {
+        Allocations diff;
+        diff.count = this->count - other.count;
+        diff.bytes = this->bytes - other.bytes;
+        return diff;
+    }
+
+    Allocations& Allocations::operator+=( const Allocations& other ) {
+        this->count += other.count;
+        this->bytes += other.bytes;
+        return *this;
+    }
+
+    Allocations allocations() {
+        Allocations current;
+        current.count = countAllocations();
+        current.bytes = countAllocatedBytes();
+        return current;
+    }
+
+    void setCounting( bool enabled ) {
+        count_allocations.store( enabled, std::memory_order_relaxed );
+    }
+
+    void installParseStatisticsCounter() {
+        ParseStatistics::setAllocationCounter( countAllocations, countAllocatedBytes );
+    }
+
+    AllocationScope::AllocationScope() :
+        m_start( allocations() )
+    {}
+
+    Allocations AllocationScope::elapsed() const {
+        return allocations() - this->m_start;
+    }
+
+    void AllocationReport::add( const std::string& phase, const Allocations& allocations ) {
+        this->m_phases.emplace_back( phase, allocations );
+    }
+
+    const std::vector< AllocationReport::entry >& AllocationReport::phases() const {
+        return this->m_phases;
+    }
+
+    Allocations AllocationReport::total() const {
+        Allocations sum;
+        for( const auto& phase : this->m_phases )
+            sum += phase.second;
+
+        return sum;
+    }
+
+    void AllocationReport::write( std::ostream& os ) const {
+        const auto row = [&os]( const std::string& name, const Allocations& a ) {
+            os << std::left << std::setw( 24 ) << name << std::right
+               << std::setw( 14 ) << a.count
+               << std::setw( 16 ) << a.bytes
+               << std::fixed << std::setprecision( 1 )
+               << std::setw( 12 ) << ( a.count == 0 ? 0.0 : double( a.bytes ) / a.count )
+               << std::endl;
+        };
+
+        os << std::left << std::setw( 24 ) << "Phase" << std::right
+           << std::setw( 14 ) << "allocs"
+           << std::setw( 16 ) << "bytes"
+           << std::setw( 12 ) << "bytes/alloc"
+           << std::endl;
+
+        for( const auto& phase : this->m_phases )
+            row( phase.first, phase.second );
+
+        row( "TOTAL", this->total() );
+    }
+
+}
+}
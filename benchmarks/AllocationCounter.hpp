@@ -0,0 +1,104 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_ALLOCATION_COUNTER_HPP
+#define OPM_ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+namespace Benchmark {
+
+    /*
+      The global operator new and operator delete are replaced in
+      AllocationCounter.cpp, and every program linking that file counts
+      the calls to operator new and the number of bytes requested. The
+      counters are global and shared between all threads.
+
+      Besides the benchmarks and the allocation budget tests, opmi links
+      this file for the allocation counts of its --profile report.
+    */
+    struct Allocations {
+        size_t count = 0;
+        size_t bytes = 0;
+
+        Allocations operator-( const Allocations& other ) const;
+        Allocations& operator+=( const Allocations& other );
+    };
+
+    /*
+      The allocations since program start.
+    */
+    Allocations allocations();
+
+    /*
+      Turn the counting on or off; it is on from program start. When it
+      is off operator new only checks a flag, which is what opmi does
+      unless it is run with --profile.
+    */
+    void setCounting( bool enabled );
+
+    /*
+      Install the counters in the ParseStatistics class, so that the
+      per-keyword statistics of the parser include the allocations.
+    */
+    void installParseStatisticsCounter();
+
+    /*
+      Counts the allocations between construction and the call to
+      elapsed(), e.g. to assert a budget in a test:
+
+          AllocationScope scope;
+          auto deck = parser.parseString( input, parseContext );
+          BOOST_CHECK( scope.elapsed().count <= 20 );
+    */
+    class AllocationScope {
+    public:
+        AllocationScope();
+        Allocations elapsed() const;
+
+    private:
+        Allocations m_start;
+    };
+
+    /*
+      A list of named phases and their allocations, written as a table
+      with write().
+    */
+    class AllocationReport {
+    public:
+        using entry = std::pair< std::string, Allocations >;
+
+        void add( const std::string& phase, const Allocations& allocations );
+        const std::vector< entry >& phases() const;
+        Allocations total() const;
+        void write( std::ostream& os ) const;
+
+    private:
+        std::vector< entry > m_phases;
+    };
+
+}
+}
+
+#endif
@@ -0,0 +1,141 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Utility/SyntheticDeck.hpp>
+
+#include "AllocationCounter.hpp"
+#include "Benchmark.hpp"
+
+/*
+  Report the number of allocations and allocated bytes of each phase of
+  loading a deck, and of each keyword while parsing:
+
+    AllocationReport [--keywords N] [deck options] [DECK]
+
+  If no DECK is given a SyntheticDeck is generated from the --nx, --ny,
+  --nz, --wells, --steps, --repeat, --regions, --faults and --seed
+  options. Only the N keywords with the largest parse time are listed,
+  all keywords if N is zero; the per keyword table requires that the
+  library has been compiled with OPM_PARSE_PROFILING.
+*/
+
+using namespace Opm;
+
+namespace {
+
+    template< typename T, typename... Args >
+    std::unique_ptr< T > measure( Benchmark::AllocationReport& report,
+                                  const std::string& phase,
+                                  Args&&... args ) {
+        const Benchmark::AllocationScope scope;
+        std::unique_ptr< T > result( new T( std::forward< Args >( args )... ) );
+        report.add( phase, scope.elapsed() );
+        return result;
+    }
+
+    int run( int argc, char** argv ) {
+        SyntheticDeck::Options options;
+        std::string deck_file;
+        size_t max_keywords = 20;
+
+        for( int iarg = 1; iarg < argc; iarg++ ) {
+            const std::string arg( argv[ iarg ] );
+            if( arg.compare( 0, 2, "--" ) != 0 ) {
+                deck_file = arg;
+                continue;
+            }
+
+            if( iarg + 1 == argc )
+                throw std::invalid_argument( "Missing value for option: " + arg );
+
+            const std::string value( argv[ ++iarg ] );
+            if( Benchmark::setDeckOption( options, arg, value ) )
+                continue;
+
+            if( arg == "--keywords" )
+                max_keywords = std::stoul( value );
+            else
+                throw std::invalid_argument( "Unknown option: " + arg );
+        }
+
+        Benchmark::installParseStatisticsCounter();
+
+        Parser parser;
+        ParseContext parseContext;
+        parser.setProfiling( true );
+
+        const std::string input = deck_file.empty() ? SyntheticDeck( options ).str() : "";
+
+        Benchmark::AllocationReport report;
+        const Benchmark::AllocationScope parse_scope;
+        const auto deck = deck_file.empty() ? parser.parseString( input, parseContext )
+                                            : parser.parseFile( deck_file, parseContext );
+        report.add( "parse", parse_scope.elapsed() );
+
+        const auto state = measure< EclipseState >( report, "EclipseState", deck, parseContext );
+        const auto schedule = measure< Schedule >( report, "Schedule", deck, *state, parseContext );
+        measure< SummaryConfig >( report, "SummaryConfig", deck, *schedule,
+                                  state->getTableManager(), parseContext );
+
+        /*
+          The EclipseState members are constructed again on their own; they
+          are already included in the EclipseState phase above.
+        */
+        Benchmark::AllocationReport components;
+        const auto tables = measure< TableManager >( components, "TableManager", deck );
+        const auto grid = measure< EclipseGrid >( components, "EclipseGrid", deck );
+        measure< Eclipse3DProperties >( components, "Eclipse3DProperties", deck, *tables, *grid );
+
+        report.write( std::cout );
+        std::cout << std::endl;
+        components.write( std::cout );
+
+        if( deck.hasParseStatistics() ) {
+            std::cout << std::endl;
+            deck.getParseStatistics().report( std::cout, max_keywords );
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+}
+
+int main( int argc, char** argv ) {
+    try {
+        return run( argc, argv );
+    } catch( const std::exception& e ) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
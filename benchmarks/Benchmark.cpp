@@ -0,0 +1,228 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+#include <sys/resource.h>
+
+#include "AllocationCounter.hpp"
+#include "Benchmark.hpp"
+
+namespace Opm {
+namespace Benchmark {
+
+namespace {
+
+    long peak_rss_kb() {
+        struct rusage usage;
+        if( getrusage( RUSAGE_SELF, &usage ) != 0 ) return 0;
+        return usage.ru_maxrss;
+    }
+
+    double now() {
+        using namespace std::chrono;
+        return duration_cast< duration< double > >( steady_clock::now().time_since_epoch() ).count();
+    }
+
+}
+
+    bool setDeckOption( SyntheticDeck::Options& options,
+                        const std::string& arg,
+                        const std::string& value ) {
+        const std::map< std::string, size_t* > sizes = {
+            { "--nx",      &options.nx },
+            { "--ny",      &options.ny },
+            { "--nz",      &options.nz },
+            { "--wells",   &options.wells },
+            { "--steps",   &options.steps },
+            { "--repeat",  &options.repeat },
+            { "--regions", &options.regions },
+            { "--faults",  &options.faults }
+        };
+
+        const auto size = sizes.find( arg );
+        if( size != sizes.end() ) {
+            *size->second = std::stoul( value );
+            return true;
+        }
+
+        if( arg == "--seed" ) {
+            options.seed = std::stoull( value );
+            return true;
+        }
+
+        return false;
+    }
+
+    Suite::Suite( const std::string& name, int argc, char** argv ) :
+        m_name( name )
+    {
+        /* The default benchmark deck is larger than the SyntheticDeck default. */
+        this->m_deck_options.nx = 50;
+        this->m_deck_options.ny = 50;
+        this->m_deck_options.nz = 20;
+        this->m_deck_options.wells = 50;
+        this->m_deck_options.steps = 100;
+
+        for( int iarg = 1; iarg < argc; iarg++ ) {
+            const std::string arg( argv[ iarg ] );
+            if( iarg + 1 == argc )
+                throw std::invalid_argument( "Missing value for option: " + arg );
+
+            const std::string value( argv[ ++iarg ] );
+
+            if( setDeckOption( this->m_deck_options, arg, value ) )
+                continue;
+
+            if( arg == "--filter" )
+                this->m_filter = value;
+            else if( arg == "--min-time" )
+                this->m_min_time = std::stod( value );
+            else if( arg == "--json" )
+                this->m_json = value;
+            else
+                throw std::invalid_argument( "Unknown option: " + arg );
+        }
+    }
+
+    const SyntheticDeck::Options& Suite::deckOptions() const {
+        return this->m_deck_options;
+    }
+
+    void Suite::run( const std::string& name,
+                     const std::function< void() >& body,
+                     const std::vector< Work >& work ) {
+        this->run( name, []{}, body, work );
+    }
+
+    void Suite::run( const std::string& name,
+                     const std::function< void() >& setup,
+                     const std::function< void() >& body,
+                     const std::vector< Work >& work ) {
+        if( name.find( this->m_filter ) == std::string::npos ) return;
+
+        /* warm up caches and lazily initialized state */
+        setup();
+        body();
+
+        Result result;
+        result.name = name;
+        result.min_time = std::numeric_limits< double >::max();
+
+        double elapsed = 0;
+        do {
+            setup();
+            const AllocationScope scope;
+            const double iteration_start = now();
+            body();
+            const double iteration_time = now() - iteration_start;
+            const auto allocated = scope.elapsed();
+
+            result.allocations = allocated.count;
+            result.allocated_bytes = allocated.bytes;
+
+            result.min_time = std::min( result.min_time, iteration_time );
+            result.iterations++;
+            elapsed += iteration_time;
+        } while( elapsed < this->m_min_time );
+
+        result.mean_time = elapsed / result.iterations;
+        result.peak_rss_kb = peak_rss_kb();
+        for( const auto& w : work )
+            result.throughput.emplace_back( w.first + "/s", w.second / result.mean_time );
+
+        auto& log = this->m_json == "-" ? std::cerr : std::cout;
+        log << std::left << std::setw( 36 ) << name << std::right
+            << std::setw( 8 ) << result.iterations
+            << std::fixed << std::setprecision( 3 )
+            << std::setw( 12 ) << result.mean_time * 1000 << " ms"
+            << std::setw( 12 ) << result.min_time * 1000 << " ms";
+        for( const auto& t : result.throughput )
+            log << std::setprecision( 1 ) << "  " << t.second << " " << t.first;
+        log << "  allocs: " << result.allocations
+            << "  rss: " << result.peak_rss_kb << " kB" << std::endl;
+
+        this->m_results.push_back( result );
+    }
+
+    const std::vector< Result >& Suite::results() const {
+        return this->m_results;
+    }
+
+    void Suite::writeJson( std::ostream& os ) const {
+        const auto& d = this->m_deck_options;
+        os << "{" << std::endl
+           << "  \"suite\": \"" << this->m_name << "\"," << std::endl
+           << "  \"deck\": { \"nx\": " << d.nx << ", \"ny\": " << d.ny << ", \"nz\": " << d.nz
+           << ", \"wells\": " << d.wells << ", \"steps\": " << d.steps
+           << ", \"repeat\": " << d.repeat << ", \"regions\": " << d.regions
+           << ", \"faults\": " << d.faults << ", \"seed\": " << d.seed << " }," << std::endl
+           << "  \"benchmarks\": [";
+
+        os << std::setprecision( 9 );
+        for( size_t i = 0; i < this->m_results.size(); i++ ) {
+            const auto& r = this->m_results[ i ];
+            os << ( i == 0 ? "" : "," ) << std::endl
+               << "    { \"name\": \"" << r.name << "\""
+               << ", \"iterations\": " << r.iterations
+               << ", \"mean_time\": " << r.mean_time
+               << ", \"min_time\": " << r.min_time
+               << ", \"peak_rss_kb\": " << r.peak_rss_kb
+               << ", \"allocations\": " << r.allocations
+               << ", \"allocated_bytes\": " << r.allocated_bytes
+               << ", \"throughput\": {";
+
+            for( size_t t = 0; t < r.throughput.size(); t++ )
+                os << ( t == 0 ? " " : ", " )
+                   << "\"" << r.throughput[ t ].first << "\": " << r.throughput[ t ].second;
+            os << " } }";
+        }
+        os << std::endl << "  ]" << std::endl << "}" << std::endl;
+    }
+
+    int Suite::finish() const {
+        if( this->m_json.empty() ) return EXIT_SUCCESS;
+
+        if( this->m_json == "-" ) {
+            this->writeJson( std::cout );
+            return EXIT_SUCCESS;
+        }
+
+        std::ofstream stream( this->m_json );
+        if( !stream ) {
+            std::cerr << "Could not open file: " << this->m_json << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        this->writeJson( stream );
+        return EXIT_SUCCESS;
+    }
+
+    void doNotOptimize( const void* ) {}
+
+}
+}
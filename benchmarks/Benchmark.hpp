@@ -0,0 +1,129 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_BENCHMARK_HPP
+#define OPM_BENCHMARK_HPP
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <opm/parser/eclipse/Utility/SyntheticDeck.hpp>
+
+namespace Opm {
+namespace Benchmark {
+
+    /*
+      The amount of work done in one iteration of a benchmark, e.g.
+      { "MB", bytes / 1e6 } or { "cells", nx*ny*nz }; the throughput is
+      reported as MB/s and cells/s respectively.
+    */
+    using Work = std::pair< std::string, double >;
+
+    struct Result {
+        std::string name;
+        size_t iterations = 0;
+        double mean_time = 0;
+        double min_time = 0;
+        std::vector< Work > throughput;
+        long peak_rss_kb = 0;
+        size_t allocations = 0;
+        size_t allocated_bytes = 0;
+    };
+
+    /*
+      Set the SyntheticDeck option for the command line argument arg,
+      e.g. "--nx"; returns false if arg is not a deck option.
+    */
+    bool setDeckOption( SyntheticDeck::Options& options,
+                        const std::string& arg,
+                        const std::string& value );
+
+    /*
+      A Suite runs a set of benchmarks and reports the timings, throughput,
+      allocations per iteration and peak resident set size. The command
+      line options are:
+
+        --filter STR   Only run the benchmarks with STR in the name.
+        --min-time S   Repeat each benchmark for at least S seconds (0.5).
+        --json FILE    Write the results as JSON to FILE, '-' for stdout.
+
+      In addition the size of the synthetic deck used as benchmark input
+      is set with the SyntheticDeck options --nx, --ny, --nz, --wells,
+      --steps, --repeat, --regions, --faults and --seed.
+
+      Peak RSS is the high water mark of the process after the benchmark
+      has run, i.e. it is monotonically increasing through the suite; run
+      one benchmark at a time with --filter to get the peak of one stage.
+      The allocations are counted by the operator new replacement in
+      AllocationCounter.cpp, and are those of the last iteration.
+    */
+    class Suite {
+    public:
+        Suite( const std::string& name, int argc, char** argv );
+
+        const SyntheticDeck::Options& deckOptions() const;
+
+        void run( const std::string& name,
+                  const std::function< void() >& body,
+                  const std::vector< Work >& work );
+
+        /*
+          As run(), but setup() is called before each call to body(), and
+          is not included in the timing.
+        */
+        void run( const std::string& name,
+                  const std::function< void() >& setup,
+                  const std::function< void() >& body,
+                  const std::vector< Work >& work );
+
+        const std::vector< Result >& results() const;
+        void writeJson( std::ostream& os ) const;
+
+        /*
+          Write the JSON report if requested; returns the exit code for
+          main().
+        */
+        int finish() const;
+
+    private:
+        std::string m_name;
+        std::string m_filter;
+        std::string m_json;
+        double m_min_time = 0.5;
+        SyntheticDeck::Options m_deck_options;
+        std::vector< Result > m_results;
+    };
+
+    /*
+      Prevent the compiler from optimizing away a computed value.
+    */
+    void doNotOptimize( const void* ptr );
+
+    template< typename T >
+    void doNotOptimize( const T& value ) {
+        doNotOptimize( static_cast< const void* >( &value ) );
+    }
+
+}
+}
+
+#endif
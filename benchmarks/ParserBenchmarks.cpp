@@ -0,0 +1,178 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
+#include <opm/parser/eclipse/RawDeck/StarToken.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
+#include <opm/parser/eclipse/Utility/Stringview.hpp>
+#include <opm/parser/eclipse/Utility/SyntheticDeck.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace Opm;
+
+namespace {
+
+    /*
+      The data of the first record of keyword, i.e. everything between the
+      keyword name and the terminating slash.
+    */
+    std::string recordData( const std::string& section, const std::string& keyword ) {
+        const auto start = section.find( keyword + "\n" );
+        if( start == std::string::npos )
+            throw std::invalid_argument( "No keyword " + keyword + " in input" );
+
+        const auto begin = start + keyword.size() + 1;
+        const auto end = section.find( '/', begin );
+        return section.substr( begin, end - begin );
+    }
+
+    /*
+      The tokens of the record, without the repeat counted 'n*value'
+      tokens which readValueToken() does not handle.
+    */
+    std::vector< string_view > tokens( const std::string& data ) {
+        std::vector< string_view > result;
+        const RawRecord record( data );
+        for( size_t i = 0; i < record.size(); i++ ) {
+            const auto token = record.getItem( i );
+            if( std::find( token.begin(), token.end(), '*' ) == token.end() )
+                result.push_back( token );
+        }
+        return result;
+    }
+
+    int run( int argc, char** argv ) {
+        Benchmark::Suite suite( "parser", argc, argv );
+        const SyntheticDeck synthetic( suite.deckOptions() );
+        const auto deck_string = synthetic.str();
+        const double deck_mb = deck_string.size() / 1e6;
+
+        const auto zcorn = recordData( synthetic.geometry(), "ZCORN" );
+        const auto zcorn_tokens = tokens( zcorn );
+
+        std::string ints;
+        for( size_t i = 0; i < zcorn_tokens.size(); i++ )
+            ints += std::to_string( i % 1000 ) + " ";
+        const auto int_tokens = tokens( ints );
+
+        suite.run( "lex/RawRecord", [&] {
+                const RawRecord record( zcorn );
+                Benchmark::doNotOptimize( record.size() );
+            },
+            { { "MB", zcorn.size() / 1e6 } } );
+
+        suite.run( "readValueToken<double>", [&] {
+                double sum = 0;
+                for( const auto& token : zcorn_tokens )
+                    sum += readValueToken< double >( token );
+                Benchmark::doNotOptimize( sum );
+            },
+            { { "tokens", double( zcorn_tokens.size() ) } } );
+
+        suite.run( "readValueToken<int>", [&] {
+                int sum = 0;
+                for( const auto& token : int_tokens )
+                    sum += readValueToken< int >( token );
+                Benchmark::doNotOptimize( sum );
+            },
+            { { "tokens", double( int_tokens.size() ) } } );
+
+        Parser parser;
+        ParseContext parseContext;
+        const auto reference = parser.parseString( deck_string, parseContext );
+        const double keywords = reference.size();
+
+        suite.run( "Parser::parseString", [&] {
+                const auto deck = parser.parseString( deck_string, parseContext );
+                Benchmark::doNotOptimize( deck.size() );
+            },
+            { { "MB", deck_mb }, { "keywords", keywords } } );
+
+        {
+            using namespace boost::filesystem;
+            const path root = temp_directory_path() / unique_path( "opm-benchmark-%%%%-%%%%" );
+            create_directories( root );
+            const auto data_file = ( root / "SYNTHETIC.DATA" ).string();
+            synthetic.writeSplit( data_file );
+
+            suite.run( "Parser::parseFile", [&] {
+                    const auto deck = parser.parseFile( data_file, parseContext );
+                    Benchmark::doNotOptimize( deck.size() );
+                },
+                { { "MB", deck_mb }, { "keywords", keywords } } );
+
+            remove_all( root );
+        }
+
+        /*
+          The copy of the deck already has its units applied; applying
+          them again does the same dimension lookups and appends the same
+          number of dimensions, so the timing is representative.
+        */
+        std::unique_ptr< Deck > deck;
+        suite.run( "Parser::applyUnitsToDeck",
+            [&] { deck.reset( new Deck( reference ) ); },
+            [&] { parser.applyUnitsToDeck( *deck ); },
+            { { "keywords", keywords } } );
+        deck.reset();
+
+        suite.run( "Deck::serialize", [&] {
+                BinaryWriter writer;
+                reference.serialize( writer );
+                Benchmark::doNotOptimize( writer.data().size() );
+            },
+            { { "keywords", keywords } } );
+
+        BinaryWriter writer;
+        reference.serialize( writer );
+        const auto& buffer = writer.data();
+        suite.run( "Deck(BinaryReader)", [&] {
+                BinaryReader reader( buffer.data(), buffer.size() );
+                const Deck copy( reader );
+                Benchmark::doNotOptimize( copy.size() );
+            },
+            { { "MB", buffer.size() / 1e6 }, { "keywords", keywords } } );
+
+        return suite.finish();
+    }
+
+}
+
+int main( int argc, char** argv ) {
+    try {
+        return run( argc, argv );
+    } catch( const std::exception& e ) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,96 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/StateLoader.hpp>
+#include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Utility/SyntheticDeck.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace Opm;
+
+namespace {
+
+    int run( int argc, char** argv ) {
+        Benchmark::Suite suite( "schedule", argc, argv );
+        const auto& options = suite.deckOptions();
+        const SyntheticDeck synthetic( options );
+
+        ParseContext parseContext;
+        const auto deck = Parser().parseString( synthetic.str(), parseContext );
+        const EclipseState state( deck, parseContext );
+        const double well_steps = options.wells * options.steps;
+
+        suite.run( "Schedule", [&] {
+                const Schedule schedule( deck, state, parseContext );
+                Benchmark::doNotOptimize( schedule.numWells() );
+            },
+            { { "wells*steps", well_steps } } );
+
+        const Schedule schedule( deck, state, parseContext );
+        const SummaryConfig reference( deck, schedule, state.getTableManager(), parseContext );
+        const double summary_keywords = std::distance( reference.begin(), reference.end() );
+
+        suite.run( "SummaryConfig", [&] {
+                const SummaryConfig summary( deck, schedule, state.getTableManager(), parseContext );
+                Benchmark::doNotOptimize( summary.begin() );
+            },
+            { { "keywords", summary_keywords } } );
+
+        const Parser parser;
+        const auto data = synthetic.str();
+        const double cells = options.nx * options.ny * options.nz;
+
+        suite.run( "parse+EclipseState+Schedule", [&] {
+                const auto parsed = parser.parseString( data, parseContext );
+                const EclipseState parsed_state( parsed, parseContext );
+                const Schedule parsed_schedule( parsed, parsed_state, parseContext );
+                Benchmark::doNotOptimize( parsed_schedule.numWells() );
+            },
+            { { "cells", cells }, { "wells*steps", well_steps } } );
+
+        suite.run( "StateLoader", [&] {
+                const auto loader = StateLoader::loadString( parser, data, parseContext );
+                Benchmark::doNotOptimize( loader.getSchedule().numWells() );
+            },
+            { { "cells", cells }, { "wells*steps", well_steps } } );
+
+        return suite.finish();
+    }
+
+}
+
+int main( int argc, char** argv ) {
+    try {
+        return run( argc, argv );
+    } catch( const std::exception& e ) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
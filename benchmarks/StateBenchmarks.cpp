@@ -0,0 +1,314 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/CellLocator.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaultIndex.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNCIndex.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/Partition.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/PinchProcessor.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/SwofTable.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableColumn.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
+#include <opm/parser/eclipse/Utility/SyntheticDeck.hpp>
+
+#include "Benchmark.hpp"
+
+using namespace Opm;
+
+namespace {
+
+    int run( int argc, char** argv ) {
+        Benchmark::Suite suite( "state", argc, argv );
+        const auto& options = suite.deckOptions();
+        const SyntheticDeck synthetic( options );
+
+        ParseContext parseContext;
+        const auto deck = Parser().parseString( synthetic.str(), parseContext );
+        const double cells = options.nx * options.ny * options.nz;
+
+        suite.run( "EclipseGrid", [&] {
+                const EclipseGrid grid( deck );
+                Benchmark::doNotOptimize( grid.getNumActive() );
+            },
+            { { "cells", cells } } );
+
+        std::unique_ptr< Deck > scratch;
+        suite.run( "EclipseGrid(copy deck)",
+            [&] { scratch.reset( new Deck( deck ) ); },
+            [&] {
+                const EclipseGrid grid( *scratch, nullptr, false );
+                Benchmark::doNotOptimize( grid.getNumActive() );
+            },
+            { { "cells", cells } } );
+        suite.run( "EclipseGrid(consume deck)",
+            [&] { scratch.reset( new Deck( deck ) ); },
+            [&] {
+                const EclipseGrid grid( *scratch, nullptr, true );
+                Benchmark::doNotOptimize( grid.getNumActive() );
+            },
+            { { "cells", cells } } );
+        scratch.reset();
+
+        const TableManager tables( deck );
+        const EclipseGrid grid( deck );
+
+        std::vector< double > coord;
+        std::vector< double > zcorn;
+        grid.exportCOORD( coord );
+        grid.exportZCORN( zcorn );
+
+        suite.run( "GridGeometry", [&] {
+                const GridGeometry geometry( grid, coord, zcorn );
+                Benchmark::doNotOptimize( geometry.volume().data() );
+            },
+            { { "cells", cells } } );
+
+        std::vector< double > exported;
+        suite.run( "EclipseGrid::exportZCORN", [&] {
+                Benchmark::doNotOptimize( grid.exportZCORN( exported ) );
+            },
+            { { "cells", cells } } );
+
+        suite.run( "EclipseGrid::countZCORNOverlaps", [&] {
+                Benchmark::doNotOptimize( grid.countZCORNOverlaps() );
+            },
+            { { "cells", cells } } );
+
+        const auto shared_coord = std::make_shared< const std::vector< double > >( coord );
+        const auto shared_zcorn = std::make_shared< const std::vector< double > >( zcorn );
+        suite.run( "CellLocator", [&] {
+                const CellLocator locator( grid, shared_coord, shared_zcorn );
+                Benchmark::doNotOptimize( locator.findCell( {{ 0, 0, 0 }} ) );
+            },
+            { { "cells", cells } } );
+
+        const auto& locator = grid.locator();
+        const auto& geometry = grid.geometry();
+        suite.run( "CellLocator::findCell", [&] {
+                long sum = 0;
+                for( size_t g = 0; g < grid.getCartesianSize(); g++ )
+                    sum += locator.findCell( {{ geometry.centerX()[ g ], geometry.centerY()[ g ], geometry.depth()[ g ] }} );
+                Benchmark::doNotOptimize( sum );
+            },
+            { { "queries", cells } } );
+
+        suite.run( "EclipseGrid::activeIndex", [&] {
+                size_t sum = 0;
+                for( size_t g = 0; g < grid.getCartesianSize(); g++ )
+                    if( grid.cellActive( g ) )
+                        sum += grid.activeIndex( g );
+                for( size_t a = 0; a < grid.getNumActive(); a++ )
+                    sum += grid.getGlobalIndex( a );
+                Benchmark::doNotOptimize( sum );
+            },
+            { { "cells", cells } } );
+
+        suite.run( "EclipseGrid(copy)", [&] {
+                const EclipseGrid copy( grid );
+                Benchmark::doNotOptimize( copy.getNumActive() );
+            },
+            { { "cells", cells } } );
+
+        suite.run( "TableManager", [&] {
+                const TableManager t( deck );
+                Benchmark::doNotOptimize( t.getSwofTables().size() );
+            },
+            {} );
+
+        suite.run( "Eclipse3DProperties", [&] {
+                const Eclipse3DProperties props( deck, tables, grid );
+                Benchmark::doNotOptimize( props.getIntGridProperty( "ACTNUM" ).getData() );
+                Benchmark::doNotOptimize( props.getDoubleGridProperty( "PORV" ).getData() );
+                Benchmark::doNotOptimize( props.getDoubleGridProperty( "PERMX" ).getData() );
+            },
+            { { "cells", cells } } );
+
+        suite.run( "EclipseState", [&] {
+                const EclipseState state( deck, parseContext );
+                Benchmark::doNotOptimize( state.getInputGrid().getNumActive() );
+            },
+            { { "cells", cells } } );
+
+        std::unique_ptr< EclipseState > scratchState;
+        suite.run( "EclipseState::finalize",
+            [&] { scratchState.reset( new EclipseState( deck, parseContext ) ); },
+            [&] { scratchState->finalize(); },
+            { { "cells", cells } } );
+        scratchState.reset();
+
+        {
+            const EclipseState state( deck, parseContext );
+            suite.run( "EclipseState::serialize", [&] {
+                    BinaryWriter writer;
+                    state.serialize( writer );
+                    Benchmark::doNotOptimize( writer.data().size() );
+                },
+                { { "cells", cells } } );
+
+            BinaryWriter writer;
+            state.serialize( writer );
+            const auto buffer = std::make_shared< const std::vector< char > >( writer.release() );
+            suite.run( "EclipseState(BinaryReader)", [&] {
+                    BinaryReader reader( buffer );
+                    const EclipseState copy( deck, parseContext, reader );
+                    Benchmark::doNotOptimize( copy.getInputGrid().getNumActive() );
+                },
+                { { "cells", cells }, { "MB", buffer->size() / 1e6 } } );
+        }
+
+        const EclipseState state( deck, parseContext );
+        const auto& transMult = state.getTransMult();
+        const auto nx = options.nx;
+        const auto ny = options.ny;
+        const auto nz = options.nz;
+
+        suite.run( "TransMult::getMultiplier", [&] {
+                double sum = 0;
+                for( size_t g = 0; g < nx * ny * nz; g++ ) {
+                    sum += transMult.getMultiplier( g, FaceDir::XPlus );
+                    sum += transMult.getMultiplier( g, FaceDir::YPlus );
+                    sum += transMult.getMultiplier( g, FaceDir::ZPlus );
+                }
+                Benchmark::doNotOptimize( sum );
+            },
+            { { "queries", 3 * cells } } );
+
+        const double region_queries = ( nx - 1 ) * ny * nz;
+
+        suite.run( "MULTREGTScanner::getRegionMultiplier", [&] {
+                double sum = 0;
+                for( size_t k = 0; k < nz; k++ ) {
+                    for( size_t j = 0; j < ny; j++ ) {
+                        for( size_t i = 0; i + 1 < nx; i++ ) {
+                            const size_t g = i + j * nx + k * nx * ny;
+                            sum += transMult.getRegionMultiplier( g, g + 1, FaceDir::XPlus );
+                        }
+                    }
+                }
+                Benchmark::doNotOptimize( sum );
+            },
+            { { "queries", region_queries } } );
+
+        std::vector< size_t > cells1;
+        std::vector< size_t > cells2;
+        std::vector< FaceDir::DirEnum > region_faces;
+        for( size_t k = 0; k < nz; k++ ) {
+            for( size_t j = 0; j < ny; j++ ) {
+                for( size_t i = 0; i + 1 < nx; i++ ) {
+                    const size_t g = i + j * nx + k * nx * ny;
+                    cells1.push_back( g );
+                    cells2.push_back( g + 1 );
+                    region_faces.push_back( FaceDir::XPlus );
+                }
+            }
+        }
+
+        suite.run( "MULTREGTScanner::getRegionMultipliers", [&] {
+                const auto multipliers = transMult.getRegionMultipliers( cells1, cells2, region_faces );
+                Benchmark::doNotOptimize( multipliers.data() );
+            },
+            { { "queries", region_queries } } );
+
+        suite.run( "FaultIndex", [&] {
+                const FaultIndex index( state.getInputGrid(), state.getFaults() );
+                Benchmark::doNotOptimize( index.size() );
+            },
+            { { "cells", cells } } );
+
+        std::vector< NNCdata > nncs;
+        for( size_t g = 0; g < nx * ny * nz; g++ )
+            nncs.push_back( { g, ( g * 7919 + 1 ) % ( nx * ny * nz ), 1.0 } );
+
+        suite.run( "NNCIndex", [&] {
+                const NNCIndex index( nncs );
+                Benchmark::doNotOptimize( index.size() );
+            },
+            { { "nncs", double( nncs.size() ) } } );
+
+        suite.run( "EclipseState::getPinchProcessor", [&] {
+                const auto pinch = state.getPinchProcessor();
+                Benchmark::doNotOptimize( pinch.numRemoved() );
+            },
+            { { "cells", cells } } );
+
+        suite.run( "EclipseState::getConnectionGraph", [&] {
+                const auto graph = state.getConnectionGraph();
+                Benchmark::doNotOptimize( graph.numConnections() );
+            },
+            { { "cells", cells } } );
+
+        suite.run( "Partition::bisect", [&] {
+                const auto owner = Partition::bisect( state.getInputGrid(), 16 );
+                Benchmark::doNotOptimize( owner.data() );
+            },
+            { { "cells", cells } } );
+
+        const auto graph = state.getConnectionGraph();
+        const auto owner = Partition::bisect( state.getInputGrid(), 16 );
+        suite.run( "Partition", [&] {
+                const Partition partition( state.getInputGrid(), graph, owner, 0 );
+                Benchmark::doNotOptimize( partition.numCells() );
+            },
+            { { "cells", cells } } );
+
+        const auto& swof = state.getTableManager().getSwofTables().getTable< SwofTable >( 0 );
+        const auto& sw = swof.getSwColumn();
+        const auto& krw = swof.getKrwColumn();
+        const size_t lookups = 100000;
+
+        suite.run( "TableColumn::lookup", [&] {
+                double sum = 0;
+                for( size_t n = 0; n < lookups; n++ ) {
+                    const double x = 0.1 + 0.9 * n / lookups;
+                    sum += krw.eval( sw.lookup( x ) );
+                }
+                Benchmark::doNotOptimize( sum );
+            },
+            { { "lookups", double( lookups ) } } );
+
+        return suite.finish();
+    }
+
+}
+
+int main( int argc, char** argv ) {
+    try {
+        return run( argc, argv );
+    } catch( const std::exception& e ) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
@@ -25,6 +25,7 @@
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
 
 namespace Opm {
 
@@ -164,17 +165,72 @@ namespace Opm {
         Deck( std::vector< DeckKeyword >( ilist.begin(), ilist.end() ) )
     {}
 
+    /*
+      The copy gets statistics of its own; only the deck and the head deck
+      of one parse share the statistics object.
+    */
     Deck::Deck( const Deck& d ) :
         DeckView( d.begin(), d.begin() ),
         keywordList( d.keywordList ),
         m_messageContainer( d.m_messageContainer ),
         defaultUnits( d.defaultUnits ),
         activeUnits( d.activeUnits ),
-        m_dataFile( d.m_dataFile ) {
+        m_dataFile( d.m_dataFile ),
+        m_statistics( d.m_statistics
+                      ? std::make_shared< ParseStatistics >( *d.m_statistics )
+                      : nullptr ) {
 
         this->reinit(this->keywordList.begin(), this->keywordList.end());
     }
 
+    /*
+      Moving the keyword list keeps the keywords in place, so the view
+      and the keyword index are still valid for the moved-to deck.
+    */
+    Deck::Deck( Deck&& d ) :
+        DeckView( std::move( d ) ),
+        keywordList( std::move( d.keywordList ) ),
+        m_messageContainer( std::move( d.m_messageContainer ) ),
+        defaultUnits( std::move( d.defaultUnits ) ),
+        activeUnits( std::move( d.activeUnits ) ),
+        m_dataFile( std::move( d.m_dataFile ) ),
+        m_statistics( std::move( d.m_statistics ) ) {
+
+        d.reinit( d.keywordList.begin(), d.keywordList.end() );
+    }
+
+namespace {
+
+    std::vector< DeckKeyword > readKeywords( BinaryReader& reader ) {
+        const auto size = reader.read< uint64_t >();
+        std::vector< DeckKeyword > keywords;
+        keywords.reserve( size );
+        for( uint64_t i = 0; i < size; i++ )
+            keywords.emplace_back( reader );
+
+        return keywords;
+    }
+
+}
+
+    Deck::Deck( BinaryReader& reader ) :
+        Deck( readKeywords( reader ) )
+    {
+        this->m_dataFile = reader.readString();
+        this->defaultUnits = UnitSystem( static_cast< UnitSystem::UnitType >( reader.read< int32_t >() ) );
+        this->activeUnits = UnitSystem( static_cast< UnitSystem::UnitType >( reader.read< int32_t >() ) );
+    }
+
+    void Deck::serialize( BinaryWriter& writer ) const {
+        writer.write( uint64_t( this->keywordList.size() ) );
+        for( const auto& keyword : this->keywordList )
+            keyword.serialize( writer );
+
+        writer.write( this->m_dataFile );
+        writer.write( int32_t( this->defaultUnits.getType() ) );
+        writer.write( int32_t( this->activeUnits.getType() ) );
+    }
+
     void Deck::addKeyword( DeckKeyword&& keyword ) {
         this->keywordList.push_back( std::move( keyword ) );
 
@@ -222,6 +278,28 @@ namespace Opm {
         m_dataFile = dataFile;
     }
 
+    bool Deck::hasParseStatistics() const {
+        return bool( this->m_statistics );
+    }
+
+    const ParseStatistics& Deck::getParseStatistics() const {
+        if( !this->m_statistics )
+            throw std::invalid_argument("The deck was parsed without profiling - no statistics available");
+
+        return *this->m_statistics;
+    }
+
+    ParseStatistics& Deck::getParseStatistics() {
+        if( !this->m_statistics )
+            throw std::invalid_argument("The deck was parsed without profiling - no statistics available");
+
+        return *this->m_statistics;
+    }
+
+    void Deck::setParseStatistics( std::shared_ptr< ParseStatistics > statistics ) {
+        this->m_statistics = std::move( statistics );
+    }
+
     Deck::iterator Deck::begin() {
         return this->keywordList.begin();
     }
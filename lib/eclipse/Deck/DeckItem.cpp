@@ -20,15 +20,37 @@
 #include <opm/parser/eclipse/Deck/DeckOutput.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Units/Dimension.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
 
 #include <boost/algorithm/string.hpp>
 
+#include <array>
+#include <cstdint>
 #include <iostream>
+#include <mutex>
 #include <stdexcept>
 #include <cmath>
 
 namespace Opm {
 
+namespace {
+
+    /*
+      The lazy SI conversion is guarded by one of a fixed pool of
+      mutexes, picked by the address of the item, rather than by a mutex
+      per item; the decks have millions of items, and contention is rare.
+      The low bits of the address are dropped before picking the mutex,
+      since they are zero for the aligned heap allocated items and would
+      leave most of the pool unused.
+    */
+    std::mutex& conversionMutex( const void* item ) {
+        static std::array< std::mutex, 64 > mutexes;
+        const auto address = reinterpret_cast< std::uintptr_t >( item );
+        return mutexes[ ( address >> 6 ) % mutexes.size() ];
+    }
+
+}
+
 template< typename T >
 std::vector< T >& DeckItem::value_ref() {
     return const_cast< std::vector< T >& >(
@@ -62,6 +84,44 @@ const std::vector< std::string >& DeckItem::value_ref< std::string >() const {
 
 DeckItem::DeckItem( const std::string& nm ) : item_name( nm ) {}
 
+DeckItem::DeckItem( const DeckItem& other ) {
+    *this = other;
+}
+
+DeckItem::DeckItem( DeckItem&& other ) noexcept {
+    *this = std::move( other );
+}
+
+DeckItem& DeckItem::operator=( const DeckItem& other ) {
+    if( this == &other ) return *this;
+
+    std::lock_guard< std::mutex > lock( conversionMutex( &other ) );
+    this->dval = other.dval;
+    this->ival = other.ival;
+    this->sval = other.sval;
+    this->type = other.type;
+    this->item_name = other.item_name;
+    this->defaulted = other.defaulted;
+    this->dimensions = other.dimensions;
+    this->SIdata = other.SIdata;
+    this->SIconverted.store( other.SIconverted.load() );
+    return *this;
+}
+
+DeckItem& DeckItem::operator=( DeckItem&& other ) noexcept {
+    this->dval = std::move( other.dval );
+    this->ival = std::move( other.ival );
+    this->sval = std::move( other.sval );
+    this->type = other.type;
+    this->item_name = std::move( other.item_name );
+    this->defaulted = std::move( other.defaulted );
+    this->dimensions = std::move( other.dimensions );
+    this->SIdata = std::move( other.SIdata );
+    this->SIconverted.store( other.SIconverted.load() );
+    other.SIconverted.store( false );
+    return *this;
+}
+
 DeckItem::DeckItem( const std::string& nm, int, size_t hint ) :
     type( get_type< int >() ),
     item_name( nm )
@@ -86,6 +146,50 @@ DeckItem::DeckItem( const std::string& nm, std::string, size_t hint ) :
     this->defaulted.reserve( hint );
 }
 
+DeckItem::DeckItem( const std::string& nm, std::vector< int >&& data ) :
+    ival( std::move( data ) ),
+    type( get_type< int >() ),
+    item_name( nm ),
+    defaulted( this->ival.size(), false )
+{}
+
+DeckItem::DeckItem( const std::string& nm, std::vector< double >&& data ) :
+    dval( std::move( data ) ),
+    type( get_type< double >() ),
+    item_name( nm ),
+    defaulted( this->dval.size(), false )
+{}
+
+/*
+  The SI converted values are not serialized; they are converted again
+  on demand from the raw values and the dimensions.
+*/
+DeckItem::DeckItem( BinaryReader& reader ) :
+    dval( reader.readArray< double >() ),
+    ival( reader.readArray< int >() ),
+    sval( reader.readStringArray() ),
+    type( static_cast< type_tag >( reader.read< int32_t >() ) ),
+    item_name( reader.readString() ),
+    defaulted( reader.readBoolArray() )
+{
+    const auto num_dimensions = reader.read< uint64_t >();
+    for( uint64_t i = 0; i < num_dimensions; i++ )
+        this->dimensions.emplace_back( reader );
+}
+
+void DeckItem::serialize( BinaryWriter& writer ) const {
+    writer.writeArray( this->dval );
+    writer.writeArray( this->ival );
+    writer.writeArray( this->sval );
+    writer.write( int32_t( this->type ) );
+    writer.write( this->item_name );
+    writer.writeArray( this->defaulted );
+
+    writer.write( uint64_t( this->dimensions.size() ) );
+    for( const auto& dim : this->dimensions )
+        dim.serialize( writer );
+}
+
 const std::string& DeckItem::name() const {
     return this->item_name;
 }
@@ -211,7 +315,10 @@ double DeckItem::getSIDouble( size_t index ) const {
 const std::vector< double >& DeckItem::getSIDoubleData() const {
     const auto& raw = this->value_ref< double >();
     // we already converted this item to SI?
-    if( !this->SIdata.empty() ) return this->SIdata;
+    if( this->SIconverted.load( std::memory_order_acquire ) ) return this->SIdata;
+
+    std::lock_guard< std::mutex > lock( conversionMutex( this ) );
+    if( this->SIconverted.load( std::memory_order_relaxed ) ) return this->SIdata;
 
     if( this->dimensions.empty() )
         throw std::invalid_argument("No dimension has been set for item'"
@@ -232,9 +339,35 @@ const std::vector< double >& DeckItem::getSIDoubleData() const {
                                 .convertRawToSi( raw[ index ] );
     }
 
+    /* An empty item is converted again, in case values are added. */
+    this->SIconverted.store( !this->SIdata.empty(), std::memory_order_release );
     return this->SIdata;
 }
 
+std::vector< double > DeckItem::releaseSIDoubleData() {
+    auto& raw = this->value_ref< double >();
+
+    if( !this->SIconverted.load() && !raw.empty() ) {
+        if( this->dimensions.empty() )
+            throw std::invalid_argument("No dimension has been set for item'"
+                                        + this->name()
+                                        + "'; can not ask for SI data");
+
+        const auto dim_size = dimensions.size();
+        for( size_t index = 0; index < raw.size(); index++ )
+            raw[ index ] = this->dimensions[ index % dim_size ].convertRawToSi( raw[ index ] );
+
+        this->SIdata.swap( raw );
+    }
+
+    std::vector< double > data;
+    data.swap( this->SIdata );
+    this->SIconverted.store( false );
+    std::vector< double >().swap( raw );
+    std::vector< bool >().swap( this->defaulted );
+    return data;
+}
+
 void DeckItem::push_backDimension( const Dimension& active,
                                     const Dimension& def ) {
     const auto& ds = this->value_ref< double >();
@@ -21,6 +21,7 @@
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
 
 namespace Opm {
 
@@ -43,6 +44,33 @@ namespace Opm {
     }
 
 
+    DeckKeyword::DeckKeyword(BinaryReader& reader) :
+        m_keywordName(reader.readString()),
+        m_fileName(reader.readString()),
+        m_lineNumber(reader.read< int32_t >()),
+        m_knownKeyword(reader.read< uint8_t >()),
+        m_isDataKeyword(reader.read< uint8_t >()),
+        m_slashTerminated(reader.read< uint8_t >())
+    {
+        const auto size = reader.read< uint64_t >();
+        m_recordList.reserve( size );
+        for (uint64_t i = 0; i < size; i++)
+            m_recordList.emplace_back( reader );
+    }
+
+    void DeckKeyword::serialize( BinaryWriter& writer ) const {
+        writer.write( m_keywordName );
+        writer.write( m_fileName );
+        writer.write( int32_t( m_lineNumber ) );
+        writer.write( uint8_t( m_knownKeyword ) );
+        writer.write( uint8_t( m_isDataKeyword ) );
+        writer.write( uint8_t( m_slashTerminated ) );
+
+        writer.write( uint64_t( m_recordList.size() ) );
+        for (const auto& record : m_recordList)
+            record.serialize( writer );
+    }
+
     void DeckKeyword::setFixedSize() {
         m_slashTerminated = false;
     }
@@ -132,6 +160,15 @@ namespace Opm {
         return this->getDataRecord().getDataItem().getSIDoubleData();
     }
 
+    /*
+      The data of the keyword is moved out, e.g. to a grid which will
+      own it; the keyword is left with no data.
+    */
+    std::vector<double> DeckKeyword::releaseSIDoubleData() {
+        this->getDataRecord();
+        return this->getRecord(0).getDataItem().releaseSIDoubleData();
+    }
+
     void DeckKeyword::write_data( DeckOutput& output ) const {
         for (const auto& record: *this)
             record.write( output );
@@ -26,6 +26,7 @@
 #include <opm/parser/eclipse/Deck/DeckOutput.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
 #include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
 
 
 namespace Opm {
@@ -53,6 +54,19 @@ namespace Opm {
         throw std::invalid_argument( msg );
     }
 
+    DeckRecord::DeckRecord( BinaryReader& reader ) {
+        const auto size = reader.read< uint64_t >();
+        this->m_items.reserve( size );
+        for( uint64_t i = 0; i < size; i++ )
+            this->m_items.emplace_back( reader );
+    }
+
+    void DeckRecord::serialize( BinaryWriter& writer ) const {
+        writer.write( uint64_t( this->m_items.size() ) );
+        for( const auto& item : this->m_items )
+            item.serialize( writer );
+    }
+
     size_t DeckRecord::size() const {
         return m_items.size();
     }
@@ -19,6 +19,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <mutex>
 #include <set>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
@@ -32,6 +33,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/SatfuncPropertyInitializers.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
 
 #include "Grid/setKeywordBox.hpp"
 
@@ -73,24 +75,24 @@ namespace Opm {
                        const GridProperties<int>* intGridProperties,
                        const GridProperties<double>* doubleGridProperties)
         {
-            const auto& poro = doubleGridProperties->getKeyword("PORO");
-            const auto& ntg =  doubleGridProperties->getKeyword("NTG");
+            const auto& poro = doubleGridProperties->getOrCreateKeyword("PORO");
+            const auto& ntg =  doubleGridProperties->getOrCreateKeyword("NTG");
 
             const auto& poroData = poro.getData();
+            const auto& ntgData = ntg.getData();
+            const auto& cellVolumes = eclipseGrid->getCellVolumes();
             for (size_t globalIndex = 0; globalIndex < poro.getCartesianSize(); globalIndex++) {
                 if (!std::isfinite(values[globalIndex])) {
                     double cell_poro = poroData[globalIndex];
                     if (std::isnan(cell_poro))
                         throw std::logic_error("Some cells neither specify the PORV keyword nor PORO");
 
-                    double cell_ntg = ntg.iget(globalIndex);
-                    double cell_volume = eclipseGrid->getCellVolume(globalIndex);
-                    values[globalIndex] = cell_poro * cell_volume * cell_ntg;
+                    values[globalIndex] = cell_poro * cellVolumes[globalIndex] * ntgData[globalIndex];
                 }
             }
 
             if (doubleGridProperties->hasKeyword("MULTPV")) {
-                const GridProperty<double>& multpvKeyword = doubleGridProperties->getKeyword("MULTPV");
+                const GridProperty<double>& multpvKeyword = doubleGridProperties->getOrCreateKeyword("MULTPV");
                 const auto& multpvData = multpvKeyword.getData();
                 for (size_t globalIndex = 0; globalIndex < multpvData.size(); globalIndex++)
                     values[globalIndex] *= multpvData[globalIndex];
@@ -128,15 +130,15 @@ namespace Opm {
                         continue;
 
                     if (regionType == "M") {
-                        const GridProperty<int>& multnumProp = intGridProperties->getKeyword("MULTNUM");
+                        const GridProperty<int>& multnumProp = intGridProperties->getOrCreateKeyword("MULTNUM");
                         applyPorosityRegionMultiplier_(values, multnumProp.getData(), regionId, multValue);
                     }
                     else if (regionType == "F") {
-                        const GridProperty<int>& fluxnumProp = intGridProperties->getKeyword("FLUXNUM");
+                        const GridProperty<int>& fluxnumProp = intGridProperties->getOrCreateKeyword("FLUXNUM");
                         applyPorosityRegionMultiplier_(values, fluxnumProp.getData(), regionId, multValue);
                     }
                     else if (regionType == "O") {
-                        const GridProperty<int>& opernumProp = intGridProperties->getKeyword("OPERNUM");
+                        const GridProperty<int>& opernumProp = intGridProperties->getOrCreateKeyword("OPERNUM");
                         applyPorosityRegionMultiplier_(values, opernumProp.getData(), regionId, multValue);
                     }
                     else
@@ -164,17 +166,29 @@ namespace Opm {
 
              3. The code below will fail hard if it is called with a
                 grid which does not have full cell information.
+
+             4. If the grid is read from a GDFILE and the deck has no
+                ACTNUM keyword the inactive cells of the grid file are
+                also set to zero.
         */
 
         void ACTNUMPostProcessor( std::vector<int>&       values,
-                                  const GridProperties<double>* doubleGridProperties)
+                                  const GridProperties<double>* doubleGridProperties,
+                                  const Deck* deck,
+                                  const EclipseGrid* eclipseGrid)
         {
+            if (deck->hasKeyword( "GDFILE" ) && !deck->hasKeyword( "ACTNUM" )) {
+                for (size_t g = 0; g < values.size(); g++)
+                    if (!eclipseGrid->cellActive( g ))
+                        values[g] = 0;
+            }
+
             const bool hasPORV = doubleGridProperties->hasKeyword( "PORV" ) || doubleGridProperties->hasKeyword( "PORO");
             if (!hasPORV)
                 return;
 
             {
-                const auto& porv = doubleGridProperties->getKeyword("PORV");
+                const auto& porv = doubleGridProperties->getOrCreateKeyword("PORV");
                 {
                     const auto& porvData = porv.getData();
                     for (size_t i = 0; i < porvData.size(); i++)
@@ -437,7 +451,17 @@ namespace Opm {
 
     Eclipse3DProperties::Eclipse3DProperties( const Deck&         deck,
                                               const TableManager& tableManager,
-                                              const EclipseGrid&  eclipseGrid)
+                                              const EclipseGrid&  eclipseGrid,
+                                              BinaryReader*       reader)
+        : Eclipse3DProperties( deck, tableManager, eclipseGrid, reader,
+                               Trace::Span( "Eclipse3DProperties", "state" ) )
+    {}
+
+    Eclipse3DProperties::Eclipse3DProperties( const Deck&         deck,
+                                              const TableManager& tableManager,
+                                              const EclipseGrid&  eclipseGrid,
+                                              BinaryReader*       reader,
+                                              const Trace::Span& )
         :
 
           m_defaultRegion("FLUXNUM"),
@@ -449,6 +473,9 @@ namespace Opm {
           m_doubleGridProperties(eclipseGrid, &m_deckUnitSystem,
                                  makeSupportedDoubleKeywords(&tableManager, &eclipseGrid, &m_intGridProperties))
     {
+        /* The post processors of PORV and ACTNUM use both containers. */
+        m_doubleGridProperties.m_mutex = m_intGridProperties.m_mutex;
+
         /*
          * The EQUALREG, MULTREG, COPYREG, ... keywords are used to manipulate
          * vectors based on region values; for instance the statement
@@ -505,7 +532,9 @@ namespace Opm {
         {
             auto actnumPP = std::bind(&ACTNUMPostProcessor,
                                       std::placeholders::_1,
-                                      &m_doubleGridProperties);
+                                      &m_doubleGridProperties,
+                                      &deck,
+                                      &eclipseGrid);
 
             m_intGridProperties.postAddKeyword( "ACTNUM",
                                                 1,
@@ -513,7 +542,36 @@ namespace Opm {
                                                 "1");
         }
 
-        processGridProperties(deck, eclipseGrid);
+        if (reader) {
+            m_intGridProperties.deserialize( *reader );
+            m_doubleGridProperties.deserialize( *reader );
+        } else
+            processGridProperties(deck, eclipseGrid);
+    }
+
+    /*
+      The copied containers get their own mutex, which the int and double
+      containers of the copy share again.
+    */
+    Eclipse3DProperties::Eclipse3DProperties( const Eclipse3DProperties& other ) :
+        m_defaultRegion( other.m_defaultRegion ),
+        m_deckUnitSystem( other.m_deckUnitSystem ),
+        m_intGridProperties( other.m_intGridProperties ),
+        m_doubleGridProperties( other.m_doubleGridProperties )
+    {
+        m_doubleGridProperties.m_mutex = m_intGridProperties.m_mutex;
+    }
+
+    Eclipse3DProperties& Eclipse3DProperties::operator=( const Eclipse3DProperties& other ) {
+        if (this == &other)
+            return *this;
+
+        m_defaultRegion = other.m_defaultRegion;
+        m_deckUnitSystem = other.m_deckUnitSystem;
+        m_intGridProperties = other.m_intGridProperties;
+        m_doubleGridProperties = other.m_doubleGridProperties;
+        m_doubleGridProperties.m_mutex = m_intGridProperties.m_mutex;
+        return *this;
     }
 
     bool Eclipse3DProperties::supportsGridProperty(const std::string& keyword) const {
@@ -538,18 +596,47 @@ namespace Opm {
 
 
     const GridProperty<int>& Eclipse3DProperties::getIntGridProperty( const std::string& keyword ) const {
-        auto& gridProperty = const_cast< Eclipse3DProperties* >( this )->m_intGridProperties.getKeyword( keyword );
-        gridProperty.runPostProcessor();
-        return gridProperty;
+        return m_intGridProperties.getOrCreateKeyword( keyword );
     }
 
 
 
     /// gets property from doubleGridProperty --- and calls the runPostProcessor
     const GridProperty<double>& Eclipse3DProperties::getDoubleGridProperty( const std::string& keyword ) const {
-        auto& gridProperty = const_cast< Eclipse3DProperties* >( this )->m_doubleGridProperties.getKeyword( keyword );
-        gridProperty.runPostProcessor();
-        return gridProperty;
+        return m_doubleGridProperties.getOrCreateKeyword( keyword );
+    }
+
+    void Eclipse3DProperties::finalize() const {
+        std::lock_guard< std::recursive_mutex > lock( m_intGridProperties.mutex() );
+        m_intGridProperties.getOrCreateKeyword( "ACTNUM" );
+        m_doubleGridProperties.getOrCreateKeyword( "PORV" );
+
+        /*
+          A post processor can create other properties, so the names
+          are collected before the post processors are run.
+        */
+        std::vector< std::string > intKeywords;
+        for (const auto& pair : m_intGridProperties.m_properties)
+            intKeywords.push_back( pair.first );
+
+        std::vector< std::string > doubleKeywords;
+        for (const auto& pair : m_doubleGridProperties.m_properties)
+            doubleKeywords.push_back( pair.first );
+
+        for (const auto& keyword : intKeywords)
+            m_intGridProperties.getOrCreateKeyword( keyword );
+
+        for (const auto& keyword : doubleKeywords)
+            m_doubleGridProperties.getOrCreateKeyword( keyword );
+
+        m_intGridProperties.m_finalized = true;
+        m_doubleGridProperties.m_finalized = true;
+    }
+
+    void Eclipse3DProperties::serialize( BinaryWriter& writer ) const {
+        this->finalize();
+        m_intGridProperties.serialize( writer );
+        m_doubleGridProperties.serialize( writer );
     }
 
     const GridProperties<int>& Eclipse3DProperties::getIntProperties() const {
@@ -567,7 +654,7 @@ namespace Opm {
 
     const GridProperty<int>& Eclipse3DProperties::getRegion( const DeckItem& regionItem ) const {
         if (regionItem.defaultApplied(0))
-            return m_intGridProperties.getKeyword( m_defaultRegion );
+            return m_intGridProperties.getOrCreateKeyword( m_defaultRegion );
         else {
             const std::string regionArray = MULTREGT::RegionNameFromDeckValue( regionItem.get< std::string >(0) );
             return m_intGridProperties.getDeckKeyword( regionArray );
@@ -693,6 +780,7 @@ namespace Opm {
 
     void Eclipse3DProperties::processGridProperties( const Deck& deck,
                                                      const EclipseGrid& eclipseGrid) {
+        Trace::Span span( "Eclipse3DProperties::processGridProperties", "state" );
 
         if (Section::hasGRID(deck))
             scanSection(GRIDSection(deck), eclipseGrid);
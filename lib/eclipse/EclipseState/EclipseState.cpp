@@ -44,19 +44,67 @@
 #include <opm/parser/eclipse/Units/Dimension.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 #include <opm/parser/eclipse/Parser/MessageContainer.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
+#include <opm/parser/eclipse/Utility/TaskGraph.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
 
 
 namespace Opm {
 
+    /*
+      The Runspec and EclipseConfig are cheap, and IOConfig and
+      InitConfig write directly to std::cout and std::cerr, so they are
+      built in sequence to keep the output deterministic.
+    */
+    EclipseState::Inputs& EclipseState::buildInputs(const Deck& deck, Inputs& inputs) {
+        TaskGraph graph;
+        if( !inputs.tables )
+            graph.add( "TableManager", [&] { inputs.tables.reset( new TableManager( deck ) ); } );
+        if( !inputs.nnc )
+            graph.add( "NNC", [&] { inputs.nnc.reset( new NNC( deck ) ); } );
+        if( !inputs.grid )
+            graph.add( "EclipseGrid", [&] { inputs.grid.reset( new EclipseGrid( deck, nullptr ) ); } );
+        graph.run();
+
+        return inputs;
+    }
+
+    /* The grid and the NNC come first in the buffer, see serialize(). */
+    EclipseState::Inputs EclipseState::readInputs(BinaryReader& reader) {
+        Inputs inputs;
+        inputs.grid.reset( new EclipseGrid( reader ) );
+        inputs.nnc.reset( new NNC( reader ) );
+        return inputs;
+    }
+
     EclipseState::EclipseState(const Deck& deck, ParseContext parseContext) :
+        EclipseState( deck, parseContext, Inputs() )
+    {}
+
+    EclipseState::EclipseState(const Deck& deck, ParseContext parseContext, Inputs&& inputs) :
+        EclipseState( deck, parseContext, std::move( inputs ), nullptr, Trace::Span( "EclipseState", "state" ) )
+    {}
+
+    EclipseState::EclipseState(const Deck& deck, ParseContext parseContext, BinaryReader& reader) :
+        EclipseState( deck, parseContext, readInputs( reader ), &reader, Trace::Span( "EclipseState", "state" ) )
+    {}
+
+    /*
+      The properties keep pointers to the tables and the grid, so they
+      are built from the members, after the inputs have been moved in.
+      The EclipseState span is a temporary of the delegating
+      constructors, so it is open while the members are built.
+    */
+    EclipseState::EclipseState(const Deck& deck, ParseContext parseContext, Inputs&& inputs, BinaryReader* reader,
+                               const Trace::Span&) :
         m_parseContext(      parseContext ),
-        m_tables(            deck ),
+        m_tables(            std::move( *buildInputs( deck, inputs ).tables ) ),
         m_runspec(           deck ),
         m_eclipseConfig(     deck ),
         m_deckUnitSystem(    deck.getActiveUnitSystem() ),
-        m_inputNnc(          deck ),
-        m_inputGrid(         deck, nullptr ),
-        m_eclipseProperties( deck, m_tables, m_inputGrid ),
+        m_inputNnc(          std::move( *inputs.nnc ) ),
+        m_inputGrid(         std::move( *inputs.grid ) ),
+        m_eclipseProperties( deck, m_tables, m_inputGrid, reader ),
         m_simulationConfig(  deck, m_eclipseProperties ),
         m_transMult(         GridDims(deck), deck, m_eclipseProperties )
     {
@@ -73,8 +121,13 @@ namespace Opm {
             m_title = boost::algorithm::join( itemValue, " " );
         }
 
-        initTransMult();
         initFaults(deck);
+        if (reader)
+            m_transMult.deserialize( *reader );
+        else {
+            initTransMult();
+            m_transMult.applyMULTFLT( m_faults, m_faultIndex );
+        }
 
         m_messageContainer.appendMessages(m_tables.getMessageContainer());
         m_messageContainer.appendMessages(m_inputGrid.getMessageContainer());
@@ -106,6 +159,22 @@ namespace Opm {
         return const_cast< RestartConfig& >( m_eclipseConfig.getRestartConfig() );
     }
 
+    void EclipseState::finalize() const {
+        Trace::Span span( "EclipseState::finalize", "state" );
+
+        m_inputGrid.finalize();
+        m_eclipseProperties.finalize();
+    }
+
+    void EclipseState::serialize(BinaryWriter& writer) const {
+        Trace::Span span( "EclipseState::serialize", "state" );
+
+        m_inputGrid.serialize( writer );
+        m_inputNnc.serialize( writer );
+        m_eclipseProperties.serialize( writer );
+        m_transMult.serialize( writer );
+    }
+
     const Eclipse3DProperties& EclipseState::get3DProperties() const {
         return m_eclipseProperties;
     }
@@ -160,6 +229,10 @@ namespace Opm {
         return m_faults;
     }
 
+    const FaultIndex& EclipseState::getFaultIndex() const {
+        return m_faultIndex;
+    }
+
     const TransMult& EclipseState::getTransMult() const {
         return m_transMult;
     }
@@ -168,6 +241,25 @@ namespace Opm {
         return m_inputNnc;
     }
 
+    ConnectionGraph EclipseState::getConnectionGraph() const {
+        Trace::Span span( "EclipseState::getConnectionGraph", "state" );
+        return ConnectionGraph( m_inputGrid, m_transMult, m_inputNnc );
+    }
+
+    PinchProcessor EclipseState::getPinchProcessor() const {
+        Trace::Span span( "EclipseState::getPinchProcessor", "state" );
+        const auto& porv = m_eclipseProperties.getDoubleGridProperty( "PORV" ).getData();
+        if (!m_eclipseProperties.hasDeckDoubleGridProperty( "MULTZ" ))
+            return PinchProcessor( m_inputGrid, porv, {} );
+
+        return PinchProcessor( m_inputGrid, porv, m_eclipseProperties.getDoubleGridProperty( "MULTZ" ).getData() );
+    }
+
+    Partition EclipseState::getPartition( const std::vector< int >& owner, int rank ) const {
+        Trace::Span span( "EclipseState::getPartition", "state" );
+        return Partition( m_inputGrid, this->getConnectionGraph(), owner, rank );
+    }
+
     bool EclipseState::hasInputNNC() const {
         return m_inputNnc.hasNNC();
     }
@@ -177,6 +269,7 @@ namespace Opm {
     }
 
     void EclipseState::initTransMult() {
+        Trace::Span span( "EclipseState::initTransMult", "state" );
         const auto& p = m_eclipseProperties;
         if (m_eclipseProperties.hasDeckDoubleGridProperty("MULTX"))
             m_transMult.applyMULT(p.getDoubleGridProperty("MULTX"), FaceDir::XPlus);
@@ -195,6 +288,7 @@ namespace Opm {
     }
 
     void EclipseState::initFaults(const Deck& deck) {
+        Trace::Span span( "EclipseState::initFaults", "state" );
         const GRIDSection gridSection ( deck );
 
         m_faults = FaultCollection(gridSection, m_inputGrid);
@@ -204,7 +298,7 @@ namespace Opm {
             setMULTFLT(EDITSection ( deck ));
         }
 
-        m_transMult.applyMULTFLT( m_faults );
+        m_faultIndex = FaultIndex( m_inputGrid, m_faults );
     }
 
 
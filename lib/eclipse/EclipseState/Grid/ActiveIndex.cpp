@@ -0,0 +1,121 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <bitset>
+#include <limits>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/EclipseState/Grid/ActiveIndex.hpp>
+
+namespace Opm {
+
+namespace {
+
+    const size_t word_bits = 64;
+
+    size_t popcount( std::uint64_t word ) {
+        return std::bitset< word_bits >( word ).count();
+    }
+
+    /* The bits below position bit. */
+    std::uint64_t lower_mask( size_t bit ) {
+        return ( std::uint64_t( 1 ) << bit ) - 1;
+    }
+
+}
+
+    ActiveIndex::ActiveIndex( size_t size, const int* actnum ) :
+        m_size( size ),
+        m_bits( ( size + word_bits - 1 ) / word_bits, 0 ),
+        m_rank( m_bits.size() + 1, 0 )
+    {
+        if( size > size_t( std::numeric_limits< int >::max() ) )
+            throw std::invalid_argument( "Grid too large for the active index" );
+
+        const size_t words = this->m_bits.size();
+
+        #pragma omp parallel for schedule(static)
+        for( size_t w = 0; w < words; w++ ) {
+            const size_t begin = w * word_bits;
+            const size_t end = std::min( begin + word_bits, size );
+            std::uint64_t word = 0;
+
+            for( size_t g = begin; g < end; g++ )
+                if( !actnum || actnum[ g ] > 0 )
+                    word |= std::uint64_t( 1 ) << ( g - begin );
+
+            this->m_bits[ w ] = word;
+        }
+
+        for( size_t w = 0; w < words; w++ )
+            this->m_rank[ w + 1 ] = this->m_rank[ w ] + popcount( this->m_bits[ w ] );
+
+        this->m_global.resize( this->m_rank.back() );
+
+        #pragma omp parallel for schedule(static)
+        for( size_t w = 0; w < words; w++ ) {
+            std::uint64_t word = this->m_bits[ w ];
+            size_t active = this->m_rank[ w ];
+
+            for( size_t bit = 0; word != 0; bit++, word >>= 1 )
+                if( word & 1 )
+                    this->m_global[ active++ ] = int( w * word_bits + bit );
+        }
+    }
+
+    size_t ActiveIndex::size() const {
+        return this->m_size;
+    }
+
+    size_t ActiveIndex::numActive() const {
+        return this->m_global.size();
+    }
+
+    bool ActiveIndex::allActive() const {
+        return this->m_global.size() == this->m_size;
+    }
+
+    bool ActiveIndex::active( size_t globalIndex ) const {
+        return ( this->m_bits[ globalIndex / word_bits ] >> ( globalIndex % word_bits ) ) & 1;
+    }
+
+    size_t ActiveIndex::activeIndex( size_t globalIndex ) const {
+        const size_t w = globalIndex / word_bits;
+        return this->m_rank[ w ] + popcount( this->m_bits[ w ] & lower_mask( globalIndex % word_bits ) );
+    }
+
+    int ActiveIndex::activeIndexOrNegative( size_t globalIndex ) const {
+        if( !this->active( globalIndex ) ) return -1;
+        return int( this->activeIndex( globalIndex ) );
+    }
+
+    size_t ActiveIndex::globalIndex( size_t activeIndex ) const {
+        return this->m_global[ activeIndex ];
+    }
+
+    const std::vector< int >& ActiveIndex::globalIndices() const {
+        return this->m_global;
+    }
+
+    bool ActiveIndex::operator==( const ActiveIndex& other ) const {
+        return this->m_size == other.m_size
+            && this->m_bits == other.m_bits;
+    }
+}
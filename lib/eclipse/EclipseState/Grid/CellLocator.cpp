@@ -0,0 +1,537 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <opm/parser/eclipse/EclipseState/Grid/CellLocator.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+
+namespace Opm {
+
+namespace {
+
+    using point = CellLocator::point;
+    using box = std::array< point, 2 >;
+
+    /* Tolerance in reference coordinates and segment parameter. */
+    const double tolerance = 1e-9;
+
+    point sub( const point& p, const point& q ) {
+        return {{ p[ 0 ] - q[ 0 ], p[ 1 ] - q[ 1 ], p[ 2 ] - q[ 2 ] }};
+    }
+
+    double dot( const point& p, const point& q ) {
+        return p[ 0 ] * q[ 0 ] + p[ 1 ] * q[ 1 ] + p[ 2 ] * q[ 2 ];
+    }
+
+    point cross( const point& p, const point& q ) {
+        return {{ p[ 1 ] * q[ 2 ] - p[ 2 ] * q[ 1 ],
+                  p[ 2 ] * q[ 0 ] - p[ 0 ] * q[ 2 ],
+                  p[ 0 ] * q[ 1 ] - p[ 1 ] * q[ 0 ] }};
+    }
+
+    double det( const point& a, const point& b, const point& c ) {
+        return dot( a, cross( b, c ) );
+    }
+
+    box boundingBox( const CellLocator::corners& cell ) {
+        box b = {{ cell[ 0 ], cell[ 0 ] }};
+        for( const auto& p : cell ) {
+            for( int d = 0; d < 3; d++ ) {
+                b[ 0 ][ d ] = std::min( b[ 0 ][ d ], p[ d ] );
+                b[ 1 ][ d ] = std::max( b[ 1 ][ d ], p[ d ] );
+            }
+        }
+        return b;
+    }
+
+    bool inside( const box& b, const point& p, double eps ) {
+        for( int d = 0; d < 3; d++ )
+            if( p[ d ] < b[ 0 ][ d ] - eps || p[ d ] > b[ 1 ][ d ] + eps ) return false;
+        return true;
+    }
+
+    bool overlap( const box& b, const box& c, double eps ) {
+        for( int d = 0; d < 3; d++ )
+            if( c[ 1 ][ d ] < b[ 0 ][ d ] - eps || c[ 0 ][ d ] > b[ 1 ][ d ] + eps ) return false;
+        return true;
+    }
+
+    double diameter( const box& b ) {
+        return std::sqrt( dot( sub( b[ 1 ], b[ 0 ] ), sub( b[ 1 ], b[ 0 ] ) ) );
+    }
+
+    bool inUnitInterval( double x ) {
+        return x >= -tolerance && x <= 1 + tolerance;
+    }
+
+    /*
+      The position x and the partial derivatives of the trilinear map
+      from the unit cube to the cell, at the reference point (s,t,u); the
+      corners are numbered as in GridGeometry::cellCorners().
+    */
+    void trilinear( const CellLocator::corners& p, double s, double t, double u,
+                    point& x, point& ds, point& dt, point& du ) {
+        x = ds = dt = du = point{{ 0, 0, 0 }};
+
+        for( int c = 0; c < 8; c++ ) {
+            const double ws = ( c & 1 ) ? s : 1 - s;
+            const double wt = ( c & 2 ) ? t : 1 - t;
+            const double wu = ( c & 4 ) ? u : 1 - u;
+            const double ss = ( c & 1 ) ? 1 : -1;
+            const double st = ( c & 2 ) ? 1 : -1;
+            const double su = ( c & 4 ) ? 1 : -1;
+
+            for( int d = 0; d < 3; d++ ) {
+                x[ d ]  += ws * wt * wu * p[ c ][ d ];
+                ds[ d ] += ss * wt * wu * p[ c ][ d ];
+                dt[ d ] += ws * st * wu * p[ c ][ d ];
+                du[ d ] += ws * wt * su * p[ c ][ d ];
+            }
+        }
+    }
+
+    /*
+      The faces of a cell as bilinear patches; the corners are listed as
+      p00, p10, p01 and p11.
+    */
+    const int faces[ 6 ][ 4 ] = { { 0, 2, 4, 6 }, { 1, 3, 5, 7 },
+                                  { 0, 1, 4, 5 }, { 2, 3, 6, 7 },
+                                  { 0, 1, 2, 3 }, { 4, 5, 6, 7 } };
+
+    /*
+      Intersect the segment a + t*d, t in [0,1], with the bilinear patch
+      p00 + u*e10 + v*e01 + u*v*e11. Projecting onto two directions e1
+      and e2 orthogonal to d eliminates t, and leaves two bilinear
+      equations in u and v; eliminating u gives a quadratic equation in
+      v. The smallest t of the intersections is returned in t.
+    */
+    bool intersectFace( const CellLocator::corners& cell, const int* face,
+                        const point& a, const point& d,
+                        const point& e1, const point& e2, double& t ) {
+        const auto& p00 = cell[ face[ 0 ] ];
+        const auto q00 = sub( p00, a );
+        const auto e10 = sub( cell[ face[ 1 ] ], p00 );
+        const auto e01 = sub( cell[ face[ 2 ] ], p00 );
+        const auto e11 = sub( sub( cell[ face[ 3 ] ], cell[ face[ 1 ] ] ), e01 );
+
+        const double A1 = dot( e1, q00 ), B1 = dot( e1, e10 ), C1 = dot( e1, e01 ), D1 = dot( e1, e11 );
+        const double A2 = dot( e2, q00 ), B2 = dot( e2, e10 ), C2 = dot( e2, e01 ), D2 = dot( e2, e11 );
+
+        const double qa = C2 * D1 - D2 * C1;
+        const double qb = A2 * D1 + C2 * B1 - B2 * C1 - D2 * A1;
+        const double qc = A2 * B1 - B2 * A1;
+        const double scale = std::max( { std::fabs( qa ), std::fabs( qb ), std::fabs( qc ) } );
+        if( scale == 0 ) return false;
+
+        double roots[ 2 ];
+        int num_roots = 0;
+        if( std::fabs( qa ) <= 1e-12 * scale ) {
+            if( std::fabs( qb ) <= 1e-12 * scale ) return false;
+            roots[ num_roots++ ] = -qc / qb;
+        } else {
+            const double disc = qb * qb - 4 * qa * qc;
+            if( disc < 0 ) return false;
+            const double q = -0.5 * ( qb + std::copysign( std::sqrt( disc ), qb ) );
+            roots[ num_roots++ ] = q / qa;
+            if( q != 0 ) roots[ num_roots++ ] = qc / q;
+        }
+
+        const double dd = dot( d, d );
+        bool found = false;
+        for( int r = 0; r < num_roots; r++ ) {
+            const double v = roots[ r ];
+            if( !inUnitInterval( v ) ) continue;
+
+            const double den1 = B1 + D1 * v;
+            const double den2 = B2 + D2 * v;
+            if( den1 == 0 && den2 == 0 ) continue;
+
+            const double u = std::fabs( den1 ) >= std::fabs( den2 )
+                           ? -( A1 + C1 * v ) / den1
+                           : -( A2 + C2 * v ) / den2;
+            if( !inUnitInterval( u ) ) continue;
+
+            point x = p00;
+            for( int k = 0; k < 3; k++ )
+                x[ k ] += u * e10[ k ] + v * e01[ k ] + u * v * e11[ k ];
+
+            const double s = dot( d, sub( x, a ) ) / dd;
+            if( !inUnitInterval( s ) ) continue;
+
+            t = found ? std::min( t, s ) : s;
+            found = true;
+        }
+
+        return found;
+    }
+
+    std::shared_ptr< const double > checkedArray( const std::shared_ptr< const std::vector< double > >& array,
+                                                  size_t size, const std::string& name ) {
+        if( !array || array->size() != size )
+            throw std::invalid_argument( "Wrong size of " + name + ": expected " + std::to_string( size ) );
+
+        return std::shared_ptr< const double >( array, array->data() );
+    }
+
+    GridGeometry::CornerFunction pillarCorners( size_t nx, size_t ny,
+                                                std::shared_ptr< const double > coord,
+                                                std::shared_ptr< const double > zcorn ) {
+        return [nx, ny, coord, zcorn]( size_t g, CellLocator::corners& cell ) {
+            const size_t i = g % nx;
+            const size_t j = ( g / nx ) % ny;
+            const size_t k = g / ( nx * ny );
+            GridGeometry::cellCorners( nx, ny, coord.get(), zcorn.get(), i, j, k, cell );
+        };
+    }
+
+}
+
+    CellLocator::CellLocator( const GridDims& dims,
+                              std::shared_ptr< const std::vector< double > > coord,
+                              std::shared_ptr< const std::vector< double > > zcorn ) :
+        CellLocator( dims,
+                     checkedArray( coord, 6 * ( dims.getNX() + 1 ) * ( dims.getNY() + 1 ), "COORD" ),
+                     checkedArray( zcorn, 8 * dims.getCartesianSize(), "ZCORN" ) )
+    {}
+
+    CellLocator::CellLocator( const GridDims& dims,
+                              std::shared_ptr< const double > coord,
+                              std::shared_ptr< const double > zcorn ) :
+        CellLocator( dims,
+                     pillarCorners( dims.getNX(), dims.getNY(), std::move( coord ), std::move( zcorn ) ) )
+    {}
+
+    CellLocator::CellLocator( const GridDims& dims,
+                              GridGeometry::CornerFunction cellCorners ) :
+        GridDims( dims.getNX(), dims.getNY(), dims.getNZ() ),
+        m_cell_corners( std::move( cellCorners ) )
+    {
+        const size_t size = this->getCartesianSize();
+        std::vector< box > boxes( size );
+
+        #pragma omp parallel for schedule(static)
+        for( size_t g = 0; g < size; g++ ) {
+            corners cell;
+            this->cellCorners( g, cell );
+            boxes[ g ] = boundingBox( cell );
+        }
+
+        const double inf = std::numeric_limits< double >::max();
+        this->m_lower = {{ inf, inf, inf }};
+        this->m_upper = {{ -inf, -inf, -inf }};
+        for( const auto& b : boxes ) {
+            for( int d = 0; d < 3; d++ ) {
+                this->m_lower[ d ] = std::min( this->m_lower[ d ], b[ 0 ][ d ] );
+                this->m_upper[ d ] = std::max( this->m_upper[ d ], b[ 1 ][ d ] );
+            }
+        }
+
+        /*
+          The buckets follow the logical dimensions of the grid, which
+          gives roughly one cell per bucket for the usual grids where the
+          cells are ordered along x, y and z.
+        */
+        this->m_buckets = {{ this->m_nx, this->m_ny, this->m_nz }};
+        const double pad = tolerance * std::max( 1.0, diameter( box{{ this->m_lower, this->m_upper }} ) );
+        for( int d = 0; d < 3; d++ ) {
+            this->m_lower[ d ] -= pad;
+            this->m_upper[ d ] += pad;
+            this->m_bucket_size[ d ] = ( this->m_upper[ d ] - this->m_lower[ d ] ) / this->m_buckets[ d ];
+        }
+
+        const size_t num_buckets = this->m_buckets[ 0 ] * this->m_buckets[ 1 ] * this->m_buckets[ 2 ];
+        this->m_offsets.assign( num_buckets + 1, 0 );
+
+        /*
+          Count the cells of each bucket, then fill in the cells. Both
+          passes run in parallel over the cells, and the cells of each
+          bucket are sorted afterwards, so that they are listed in order
+          of global index as findCell() expects.
+        */
+        auto& offsets = this->m_offsets;
+        auto& cells = this->m_cells;
+        std::vector< size_t > cursor;
+        for( int pass = 0; pass < 2; pass++ ) {
+            if( pass == 1 ) {
+                for( size_t i = 0; i < num_buckets; i++ )
+                    offsets[ i + 1 ] += offsets[ i ];
+                cursor.assign( offsets.begin(), offsets.end() - 1 );
+                cells.resize( offsets.back() );
+            }
+
+            #pragma omp parallel for schedule(static)
+            for( size_t g = 0; g < size; g++ ) {
+                const auto lo = this->bucket( boxes[ g ][ 0 ] );
+                const auto hi = this->bucket( boxes[ g ][ 1 ] );
+
+                for( size_t k = lo[ 2 ]; k <= hi[ 2 ]; k++ )
+                    for( size_t j = lo[ 1 ]; j <= hi[ 1 ]; j++ )
+                        for( size_t i = lo[ 0 ]; i <= hi[ 0 ]; i++ ) {
+                            const size_t b = this->bucketIndex( {{ i, j, k }} );
+                            if( pass == 0 ) {
+                                #pragma omp atomic
+                                offsets[ b + 1 ]++;
+                            } else {
+                                size_t n;
+                                #pragma omp atomic capture
+                                n = cursor[ b ]++;
+                                cells[ n ] = g;
+                            }
+                        }
+            }
+        }
+
+        #pragma omp parallel for schedule(static)
+        for( size_t b = 0; b < num_buckets; b++ )
+            std::sort( cells.begin() + offsets[ b ], cells.begin() + offsets[ b + 1 ] );
+    }
+
+
+    void CellLocator::cellCorners( size_t g, corners& cell ) const {
+        this->m_cell_corners( g, cell );
+    }
+
+
+    std::array< size_t, 3 > CellLocator::bucket( const point& p ) const {
+        std::array< size_t, 3 > b;
+        for( int d = 0; d < 3; d++ ) {
+            const double x = std::floor( ( p[ d ] - this->m_lower[ d ] ) / this->m_bucket_size[ d ] );
+            b[ d ] = x <= 0 ? 0 : std::min( size_t( x ), this->m_buckets[ d ] - 1 );
+        }
+        return b;
+    }
+
+
+    size_t CellLocator::bucketIndex( const std::array< size_t, 3 >& b ) const {
+        return b[ 0 ] + this->m_buckets[ 0 ] * ( b[ 1 ] + this->m_buckets[ 1 ] * b[ 2 ] );
+    }
+
+
+    void CellLocator::addCandidates( size_t b, std::vector< size_t >& candidates ) const {
+        candidates.insert( candidates.end(),
+                           this->m_cells.begin() + this->m_offsets[ b ],
+                           this->m_cells.begin() + this->m_offsets[ b + 1 ] );
+    }
+
+
+    int CellLocator::findCell( const point& p ) const {
+        if( !inside( box{{ this->m_lower, this->m_upper }}, p, 0 ) )
+            return -1;
+
+        const size_t b = this->bucketIndex( this->bucket( p ) );
+        for( size_t n = this->m_offsets[ b ]; n < this->m_offsets[ b + 1 ]; n++ ) {
+            const size_t g = this->m_cells[ n ];
+            corners cell;
+            this->cellCorners( g, cell );
+
+            const auto bbox = boundingBox( cell );
+            if( !inside( bbox, p, tolerance * diameter( bbox ) ) ) continue;
+            if( contains( cell, p ) ) return int( g );
+        }
+
+        return -1;
+    }
+
+
+    /*
+      The buckets crossed by the segment are visited in order with a 3D
+      DDA walk, after the segment has been clipped to the bounding box of
+      the grid.
+    */
+    std::vector< size_t > CellLocator::findCells( const point& a, const point& b ) const {
+        const auto d = sub( b, a );
+        if( dot( d, d ) == 0 ) {
+            const int g = this->findCell( a );
+            if( g < 0 ) return {};
+            return { size_t( g ) };
+        }
+
+        const double inf = std::numeric_limits< double >::infinity();
+        double t0 = 0, t1 = 1;
+        for( int k = 0; k < 3; k++ ) {
+            if( d[ k ] == 0 ) {
+                if( a[ k ] < this->m_lower[ k ] || a[ k ] > this->m_upper[ k ] ) return {};
+                continue;
+            }
+
+            double ta = ( this->m_lower[ k ] - a[ k ] ) / d[ k ];
+            double tb = ( this->m_upper[ k ] - a[ k ] ) / d[ k ];
+            if( ta > tb ) std::swap( ta, tb );
+            t0 = std::max( t0, ta );
+            t1 = std::min( t1, tb );
+        }
+        if( t0 > t1 ) return {};
+
+        point start;
+        for( int k = 0; k < 3; k++ )
+            start[ k ] = a[ k ] + t0 * d[ k ];
+
+        auto cur = this->bucket( start );
+        point t_max, t_delta;
+        std::array< int, 3 > step;
+        for( int k = 0; k < 3; k++ ) {
+            if( d[ k ] == 0 ) {
+                step[ k ] = 0;
+                t_max[ k ] = inf;
+                t_delta[ k ] = inf;
+                continue;
+            }
+
+            step[ k ] = d[ k ] > 0 ? 1 : -1;
+            const double boundary = this->m_lower[ k ]
+                                  + ( cur[ k ] + ( d[ k ] > 0 ? 1 : 0 ) ) * this->m_bucket_size[ k ];
+            t_max[ k ] = ( boundary - a[ k ] ) / d[ k ];
+            t_delta[ k ] = this->m_bucket_size[ k ] / std::fabs( d[ k ] );
+        }
+
+        std::vector< size_t > candidates;
+        while( true ) {
+            this->addCandidates( this->bucketIndex( cur ), candidates );
+
+            const int k = t_max[ 0 ] < t_max[ 1 ]
+                        ? ( t_max[ 0 ] < t_max[ 2 ] ? 0 : 2 )
+                        : ( t_max[ 1 ] < t_max[ 2 ] ? 1 : 2 );
+            if( t_max[ k ] > t1 ) break;
+            if( step[ k ] < 0 && cur[ k ] == 0 ) break;
+            if( step[ k ] > 0 && cur[ k ] + 1 == this->m_buckets[ k ] ) break;
+
+            cur[ k ] += step[ k ];
+            t_max[ k ] += t_delta[ k ];
+        }
+
+        std::sort( candidates.begin(), candidates.end() );
+        candidates.erase( std::unique( candidates.begin(), candidates.end() ), candidates.end() );
+
+        box segment;
+        for( int k = 0; k < 3; k++ ) {
+            segment[ 0 ][ k ] = std::min( a[ k ], b[ k ] );
+            segment[ 1 ][ k ] = std::max( a[ k ], b[ k ] );
+        }
+
+        std::vector< std::pair< double, size_t > > hits;
+        for( const size_t g : candidates ) {
+            corners cell;
+            this->cellCorners( g, cell );
+
+            const auto bbox = boundingBox( cell );
+            if( !overlap( bbox, segment, tolerance * diameter( bbox ) ) ) continue;
+
+            double t;
+            if( intersects( cell, a, b, t ) )
+                hits.emplace_back( t, g );
+        }
+
+        std::sort( hits.begin(), hits.end() );
+        std::vector< size_t > cells;
+        cells.reserve( hits.size() );
+        for( const auto& hit : hits )
+            cells.push_back( hit.second );
+
+        return cells;
+    }
+
+
+    bool CellLocator::contains( const corners& cell, const point& p ) {
+        const double size = diameter( boundingBox( cell ) );
+        if( size == 0 ) return false;
+
+        point x, ds, dt, du;
+        double s = 0.5, t = 0.5, u = 0.5;
+
+        for( int iter = 0; iter < 50; iter++ ) {
+            trilinear( cell, s, t, u, x, ds, dt, du );
+            const auto r = sub( x, p );
+
+            const double J = det( ds, dt, du );
+            if( std::fabs( J ) <= 1e-14 * size * size * size ) return false;
+
+            /* Cramer's rule for the Newton step J * delta = r. */
+            const double delta_s = det( r, dt, du ) / J;
+            const double delta_t = det( ds, r, du ) / J;
+            const double delta_u = det( ds, dt, r ) / J;
+
+            s = std::min( 2.0, std::max( -1.0, s - delta_s ) );
+            t = std::min( 2.0, std::max( -1.0, t - delta_t ) );
+            u = std::min( 2.0, std::max( -1.0, u - delta_u ) );
+
+            if( std::max( { std::fabs( delta_s ), std::fabs( delta_t ), std::fabs( delta_u ) } ) < 1e-13 )
+                break;
+        }
+
+        trilinear( cell, s, t, u, x, ds, dt, du );
+        const auto r = sub( x, p );
+        if( std::sqrt( dot( r, r ) ) > 1e-8 * size ) return false;
+
+        return inUnitInterval( s ) && inUnitInterval( t ) && inUnitInterval( u );
+    }
+
+
+    bool CellLocator::intersects( const corners& cell, const point& a, const point& b, double& t ) {
+        if( contains( cell, a ) ) {
+            t = 0;
+            return true;
+        }
+
+        const auto d = sub( b, a );
+        if( dot( d, d ) == 0 ) return false;
+
+        /* Two directions orthogonal to the segment. */
+        int axis = 0;
+        for( int k = 1; k < 3; k++ )
+            if( std::fabs( d[ k ] ) < std::fabs( d[ axis ] ) ) axis = k;
+
+        point unit = {{ 0, 0, 0 }};
+        unit[ axis ] = 1;
+        auto e1 = cross( d, unit );
+        const double norm1 = std::sqrt( dot( e1, e1 ) );
+        for( auto& x : e1 ) x /= norm1;
+
+        auto e2 = cross( d, e1 );
+        const double norm2 = std::sqrt( dot( e2, e2 ) );
+        for( auto& x : e2 ) x /= norm2;
+
+        bool found = false;
+        for( const auto& face : faces ) {
+            double s;
+            if( !intersectFace( cell, face, a, d, e1, e2, s ) ) continue;
+            t = found ? std::min( t, s ) : s;
+            found = true;
+        }
+
+        if( found ) {
+            t = std::min( 1.0, std::max( 0.0, t ) );
+            return true;
+        }
+
+        /* The segment ends inside the cell without a face being found. */
+        if( contains( cell, b ) ) {
+            t = 1;
+            return true;
+        }
+
+        return false;
+    }
+}
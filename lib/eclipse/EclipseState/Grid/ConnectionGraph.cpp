@@ -0,0 +1,232 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <array>
+
+#include <opm/parser/eclipse/EclipseState/Grid/ConnectionGraph.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /* The faces of a cell, ordered by the global index of the neighbour. */
+    const std::array< FaceDir::DirEnum, 6 > cell_faces = {{
+        FaceDir::ZMinus, FaceDir::YMinus, FaceDir::XMinus,
+        FaceDir::XPlus,  FaceDir::YPlus,  FaceDir::ZPlus
+    }};
+
+    bool isPlus( FaceDir::DirEnum face ) {
+        return face == FaceDir::XPlus || face == FaceDir::YPlus || face == FaceDir::ZPlus;
+    }
+
+    FaceDir::DirEnum plusFace( FaceDir::DirEnum face ) {
+        switch( face ) {
+            case FaceDir::XMinus: return FaceDir::XPlus;
+            case FaceDir::YMinus: return FaceDir::YPlus;
+            case FaceDir::ZMinus: return FaceDir::ZPlus;
+            default: return face;
+        }
+    }
+
+    FaceDir::DirEnum minusFace( FaceDir::DirEnum face ) {
+        switch( face ) {
+            case FaceDir::XPlus: return FaceDir::XMinus;
+            case FaceDir::YPlus: return FaceDir::YMinus;
+            case FaceDir::ZPlus: return FaceDir::ZMinus;
+            default: return face;
+        }
+    }
+
+    /*
+      The global index of the neighbour of cell g through face, or false
+      if the face is on the boundary of the grid.
+    */
+    bool neighbour( const EclipseGrid& grid, size_t g, FaceDir::DirEnum face, size_t& n ) {
+        const size_t nx = grid.getNX();
+        const size_t nxy = nx * grid.getNY();
+        const size_t i = g % nx;
+        const size_t j = ( g / nx ) % grid.getNY();
+        const size_t k = g / nxy;
+
+        switch( face ) {
+            case FaceDir::XMinus: if( i == 0 ) return false; n = g - 1; return true;
+            case FaceDir::XPlus:  if( i + 1 == nx ) return false; n = g + 1; return true;
+            case FaceDir::YMinus: if( j == 0 ) return false; n = g - nx; return true;
+            case FaceDir::YPlus:  if( j + 1 == grid.getNY() ) return false; n = g + nx; return true;
+            case FaceDir::ZMinus: if( k == 0 ) return false; n = g - nxy; return true;
+            case FaceDir::ZPlus:  if( k + 1 == grid.getNZ() ) return false; n = g + nxy; return true;
+        }
+        return false;
+    }
+
+    /*
+      The multiplier of the connection between cell g and its neighbour
+      n through face of g; this is the multiplier on the plus face of the
+      lower cell, times the multiplier on the minus face of the upper
+      cell, times the MULTREGT multiplier between them.
+    */
+    double multiplier( const TransMult& transMult, size_t g, size_t n, FaceDir::DirEnum face ) {
+        const size_t lower = isPlus( face ) ? g : n;
+        const size_t upper = isPlus( face ) ? n : g;
+        const auto plus = plusFace( face );
+
+        return transMult.getMultiplier( lower, plus )
+             * transMult.getMultiplier( upper, minusFace( plus ) )
+             * transMult.getRegionMultiplier( lower, upper, plus );
+    }
+
+    /*
+      The MULTREGT multiplier of an NNC between cells g and n. The
+      direction of the NNC is X if the cells are in different columns
+      in the i direction, otherwise Y if they are in different rows in
+      the j direction, and otherwise Z; whether the multiplier applies
+      to the NNC at all is decided by the NNC behaviour of the MULTREGT
+      record.
+    */
+    double nncMultiplier( const EclipseGrid& grid, const TransMult& transMult, size_t g, size_t n ) {
+        const size_t nx = grid.getNX();
+        const size_t ny = grid.getNY();
+        FaceDir::DirEnum face = FaceDir::ZPlus;
+        if( g % nx != n % nx )
+            face = FaceDir::XPlus;
+        else if( ( g / nx ) % ny != ( n / nx ) % ny )
+            face = FaceDir::YPlus;
+
+        return transMult.getRegionMultiplier( std::min( g, n ), std::max( g, n ), face );
+    }
+
+}
+
+    ConnectionGraph::ConnectionGraph( const EclipseGrid& grid, const TransMult& transMult, const NNC& nnc ) {
+        const size_t num_active = grid.getNumActive();
+        const auto& global = grid.getActiveMap();
+
+        /* The NNCs of each active cell, as lists of indices into nncdata(). */
+        const auto& nncs = nnc.nncdata();
+        const auto connects = [&grid]( const NNCdata& data ) {
+            return data.cell1 != data.cell2 && grid.cellActive( data.cell1 ) && grid.cellActive( data.cell2 );
+        };
+
+        std::vector< size_t > nnc_offsets( num_active + 1, 0 );
+        for( const auto& data : nncs ) {
+            if( !connects( data ) ) continue;
+            nnc_offsets[ grid.activeIndex( data.cell1 ) + 1 ]++;
+            nnc_offsets[ grid.activeIndex( data.cell2 ) + 1 ]++;
+        }
+        for( size_t a = 0; a < num_active; a++ )
+            nnc_offsets[ a + 1 ] += nnc_offsets[ a ];
+
+        std::vector< size_t > nnc_index( nnc_offsets.back() );
+        {
+            std::vector< size_t > cursor( nnc_offsets.begin(), nnc_offsets.end() - 1 );
+            for( size_t index = 0; index < nncs.size(); index++ ) {
+                const auto& data = nncs[ index ];
+                if( !connects( data ) ) continue;
+                nnc_index[ cursor[ grid.activeIndex( data.cell1 ) ]++ ] = index;
+                nnc_index[ cursor[ grid.activeIndex( data.cell2 ) ]++ ] = index;
+            }
+        }
+
+        this->m_offsets.assign( num_active + 1, 0 );
+
+        #pragma omp parallel for schedule(static)
+        for( size_t a = 0; a < num_active; a++ ) {
+            size_t count = nnc_offsets[ a + 1 ] - nnc_offsets[ a ];
+            size_t n;
+            for( const auto face : cell_faces )
+                if( neighbour( grid, global[ a ], face, n ) && grid.cellActive( n ) )
+                    count++;
+
+            this->m_offsets[ a + 1 ] = count;
+        }
+
+        for( size_t a = 0; a < num_active; a++ )
+            this->m_offsets[ a + 1 ] += this->m_offsets[ a ];
+
+        const size_t num_connections = this->m_offsets.back();
+        this->m_neighbours.resize( num_connections );
+        this->m_faces.resize( num_connections );
+        this->m_multipliers.resize( num_connections );
+        this->m_nnc_trans.resize( num_connections );
+
+        #pragma omp parallel for schedule(static)
+        for( size_t a = 0; a < num_active; a++ ) {
+            const size_t g = global[ a ];
+            size_t c = this->m_offsets[ a ];
+            size_t n;
+
+            for( const auto face : cell_faces ) {
+                if( !neighbour( grid, g, face, n ) || !grid.cellActive( n ) ) continue;
+
+                this->m_neighbours[ c ] = int( grid.activeIndex( n ) );
+                this->m_faces[ c ] = face;
+                this->m_multipliers[ c ] = multiplier( transMult, g, n, face );
+                this->m_nnc_trans[ c ] = 0;
+                c++;
+            }
+
+            for( size_t m = nnc_offsets[ a ]; m < nnc_offsets[ a + 1 ]; m++ ) {
+                const auto& data = nncs[ nnc_index[ m ] ];
+                const size_t other = data.cell1 == g ? data.cell2 : data.cell1;
+
+                this->m_neighbours[ c ] = int( grid.activeIndex( other ) );
+                this->m_faces[ c ] = 0;
+                this->m_multipliers[ c ] = nncMultiplier( grid, transMult, g, other );
+                this->m_nnc_trans[ c ] = data.trans;
+                c++;
+            }
+        }
+    }
+
+
+    size_t ConnectionGraph::numCells() const {
+        return this->m_offsets.size() - 1;
+    }
+
+    size_t ConnectionGraph::numConnections() const {
+        return this->m_neighbours.size();
+    }
+
+    const std::vector< size_t >& ConnectionGraph::offsets() const {
+        return this->m_offsets;
+    }
+
+    const std::vector< int >& ConnectionGraph::neighbours() const {
+        return this->m_neighbours;
+    }
+
+    const std::vector< int >& ConnectionGraph::faces() const {
+        return this->m_faces;
+    }
+
+    const std::vector< double >& ConnectionGraph::multipliers() const {
+        return this->m_multipliers;
+    }
+
+    const std::vector< double >& ConnectionGraph::nncTrans() const {
+        return this->m_nnc_trans;
+    }
+
+}
@@ -20,10 +20,14 @@
 #define _USE_MATH_DEFINES
 #include <cmath>
 
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 #include <tuple>
 #include <functional>
 
+#include <boost/filesystem.hpp>
+
 #include <opm/parser/eclipse/Deck/Section.hpp>
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
@@ -35,6 +39,7 @@
 #include <opm/parser/eclipse/Parser/ParserKeywords/A.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/C.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/D.hpp>
+#include <opm/parser/eclipse/Parser/ParserKeywords/G.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/I.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/M.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/P.hpp>
@@ -42,6 +47,8 @@
 #include <opm/parser/eclipse/Parser/ParserKeywords/S.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/T.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/Z.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
 
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 
@@ -49,19 +56,74 @@
 
 namespace Opm {
 
+    namespace {
+
+        std::shared_ptr< ecl_grid_type > shareGrid( ecl_grid_type * grid ) {
+            if (!grid)
+                return nullptr;
+
+            return std::shared_ptr< ecl_grid_type >( grid , ecl_grid_free );
+        }
+
+        /*
+          The corners of the cells as stored in the ERT grid. The cells
+          of a grid from e.g. DX/DY/DZ/TOPS need not share corners with
+          their neighbours, so the corners can not in general be found
+          from the COORD and ZCORN exported by ERT.
+        */
+        GridGeometry::CornerFunction ertCellCorners( std::shared_ptr< const ecl_grid_type > grid ) {
+            return [grid]( size_t globalIndex, GridGeometry::corners& cell ) {
+                for (int c = 0; c < 8; c++) {
+                    auto& corner = cell[c];
+                    ecl_grid_get_cell_corner_xyz1( grid.get() , static_cast<int>(globalIndex) , c ,
+                                                   &corner[0] , &corner[1] , &corner[2] );
+                }
+            };
+        }
+
+    }
+
 
     EclipseGrid::EclipseGrid(std::array<int, 3>& dims ,
 			     const std::vector<double>& coord , 
 			     const std::vector<double>& zcorn , 
 			     const int * actnum, 
 			     const double * mapaxes) 
-	: m_minpvValue(0),
+	: GridDims(dims),
+	  m_minpvValue(0),
 	  m_minpvMode(MinpvMode::ModeEnum::Inactive),
 	  m_pinch("PINCH"),
 	  m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
-	  m_multzMode(PinchMode::ModeEnum::TOP)
+	  m_multzMode(PinchMode::ModeEnum::TOP),
+	  m_pinchGap(true),
+	  m_pinchMaxEmptyGap(1e20)
     {
-        initCornerPointGrid( dims, coord , zcorn , actnum , mapaxes );
+        initCornerPointGrid( dims, coord.data() , zcorn.data() , actnum , mapaxes );
+        initActiveIndex();
+    }
+
+
+    EclipseGrid::EclipseGrid(std::array<int, 3>& dims ,
+                             std::vector<double>&& coord ,
+                             std::vector<double>&& zcorn ,
+                             const int * actnum,
+                             const double * mapaxes)
+        : GridDims(dims),
+          m_minpvValue(0),
+          m_minpvMode(MinpvMode::ModeEnum::Inactive),
+          m_pinch("PINCH"),
+          m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
+          m_multzMode(PinchMode::ModeEnum::TOP),
+          m_pinchGap(true),
+          m_pinchMaxEmptyGap(1e20)
+    {
+        if (coord.size() != CoordMapper( dims[0], dims[1] ).size())
+            throw std::invalid_argument("Wrong size of the COORD vector");
+
+        if (zcorn.size() != ZcornMapper( dims[0], dims[1], dims[2] ).size())
+            throw std::invalid_argument("Wrong size of the ZCORN vector");
+
+        adoptCornerPointGrid( std::move( coord ), std::move( zcorn ), actnum, mapaxes );
     }
 
 
@@ -76,17 +138,20 @@ namespace Opm {
           m_minpvMode(MinpvMode::ModeEnum::Inactive),
           m_pinch("PINCH"),
           m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
-          m_multzMode(PinchMode::ModeEnum::TOP)
+          m_multzMode(PinchMode::ModeEnum::TOP),
+          m_pinchGap(true),
+          m_pinchMaxEmptyGap(1e20)
     {
         ecl_grid_type * new_ptr = ecl_grid_load_case__( filename.c_str() , false );
         if (new_ptr)
-            m_grid.reset( new_ptr );
+            m_lazy.grid = shareGrid( new_ptr );
         else
             throw std::invalid_argument("Could not load grid from binary file: " + filename);
 
         m_nx = ecl_grid_get_nx( c_ptr() );
         m_ny = ecl_grid_get_ny( c_ptr() );
         m_nz = ecl_grid_get_nz( c_ptr() );
+        initActiveIndex();
     }
 
 
@@ -98,8 +163,118 @@ namespace Opm {
           m_pinch("PINCH"),
           m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
           m_multzMode(PinchMode::ModeEnum::TOP),
-          m_grid( ecl_grid_alloc_rectangular(nx, ny, nz, dx, dy, dz, NULL) )
+          m_pinchGap(true),
+          m_pinchMaxEmptyGap(1e20)
+    {
+        m_lazy.grid = shareGrid( ecl_grid_alloc_rectangular(nx, ny, nz, dx, dy, dz, NULL) );
+        m_active = std::make_shared< const ActiveIndex >( getCartesianSize(), nullptr );
+    }
+
+    EclipseGrid::EclipseGrid(BinaryReader& reader)
+        : GridDims(),
+          m_pinch("PINCH")
     {
+        m_nx = reader.read< uint64_t >();
+        m_ny = reader.read< uint64_t >();
+        m_nz = reader.read< uint64_t >();
+        m_minpvValue = reader.read< double >();
+        m_minpvMode = static_cast< MinpvMode::ModeEnum >( reader.read< int32_t >() );
+        if (reader.read< uint8_t >())
+            m_pinch.setValue( reader.read< double >() );
+        m_pinchoutMode = static_cast< PinchMode::ModeEnum >( reader.read< int32_t >() );
+        m_multzMode = static_cast< PinchMode::ModeEnum >( reader.read< int32_t >() );
+        m_pinchGap = reader.read< uint8_t >() != 0;
+        m_pinchMaxEmptyGap = reader.read< double >();
+        m_circle = reader.read< uint8_t >() != 0;
+
+        const auto form = reader.read< uint8_t >();
+        if (form > 2)
+            throw std::runtime_error("Unknown form of serialized grid: " + std::to_string( form ));
+
+        bool valid;
+        size_t coord_size, zcorn_size;
+        auto cartesian = std::make_shared< CartesianInput >();
+        if (form == 0) {
+            m_coord = reader.readShared< double >( coord_size );
+            m_zcorn = reader.readShared< double >( zcorn_size );
+            valid = coord_size == CoordMapper( m_nx, m_ny ).size()
+                 && zcorn_size == ZcornMapper( m_nx, m_ny, m_nz ).size();
+        } else {
+            cartesian->depthz = form == 2;
+            for (auto& array : cartesian->arrays)
+                array = reader.readArray< double >();
+
+            const auto& arrays = cartesian->arrays;
+            if (cartesian->depthz)
+                valid = arrays[0].size() == m_nx && arrays[1].size() == m_ny && arrays[2].size() == m_nz
+                     && arrays[3].size() == (m_nx + 1) * (m_ny + 1);
+            else
+                valid = std::all_of( arrays.begin(), arrays.end(),
+                                     [this]( const std::vector<double>& array ) { return array.size() == getCartesianSize(); } );
+        }
+        const auto actnum = reader.readView< int >();
+        m_mapaxes = reader.readArray< double >();
+
+        if (!valid ||
+            (actnum.size != 0 && actnum.size != getCartesianSize()) ||
+            (!m_mapaxes.empty() && m_mapaxes.size() != 6))
+            throw std::runtime_error("The serialized grid does not match its dimensions");
+
+        const int * actnum_data = actnum.size ? actnum.data : nullptr;
+        if (form != 0) {
+            m_mapaxes.clear();
+            initCartesianInput( std::move( cartesian ), actnum_data );
+        }
+
+        m_active = std::make_shared< const ActiveIndex >( getCartesianSize(), actnum_data );
+    }
+
+    /*
+      A grid from DX/DY/DZ/TOPS or DXV/DYV/DZV/DEPTHZ is written as those
+      input arrays, any other grid in corner point form. The ZCORN values
+      of a grid without adopted buffers are taken from the ERT grid as
+      they are, i.e. not adjusted as in exportZCORN(); this is exact for
+      grids read from an EGRID file, which holds COORD and ZCORN.
+    */
+    void EclipseGrid::serialize(BinaryWriter& writer) const {
+        writer.write( uint64_t( getNX() ) );
+        writer.write( uint64_t( getNY() ) );
+        writer.write( uint64_t( getNZ() ) );
+        writer.write( m_minpvValue );
+        writer.write( int32_t( m_minpvMode ) );
+        writer.write( uint8_t( m_pinch.hasValue() ) );
+        if (m_pinch.hasValue())
+            writer.write( m_pinch.getValue() );
+        writer.write( int32_t( m_pinchoutMode ) );
+        writer.write( int32_t( m_multzMode ) );
+        writer.write( uint8_t( m_pinchGap ) );
+        writer.write( m_pinchMaxEmptyGap );
+        writer.write( uint8_t( m_circle ) );
+
+        if (m_cartesian) {
+            writer.write( uint8_t( m_cartesian->depthz ? 2 : 1 ) );
+            for (const auto& array : m_cartesian->arrays)
+                writer.writeArray( array );
+        } else if (m_zcorn) {
+            writer.write( uint8_t( 0 ) );
+            writer.writeArray( m_coord.get(), CoordMapper( getNX(), getNY() ).size() );
+            writer.writeArray( m_zcorn.get(), ZcornMapper( getNX(), getNY(), getNZ() ).size() );
+        } else {
+            std::vector<double> coord;
+            std::vector<double> zcorn( ecl_grid_get_zcorn_size( c_ptr() ));
+            this->exportCOORD( coord );
+            ecl_grid_init_zcorn_data_double( c_ptr() , zcorn.data() );
+            writer.write( uint8_t( 0 ) );
+            writer.writeArray( coord );
+            writer.writeArray( zcorn );
+        }
+
+        std::vector<int> actnum;
+        std::vector<double> mapaxes;
+        this->exportACTNUM( actnum );
+        this->exportMAPAXES( mapaxes );
+        writer.writeArray( actnum );
+        writer.writeArray( mapaxes );
     }
 
     EclipseGrid::EclipseGrid(const EclipseGrid& src, const double* zcorn , const std::vector<int>& actnum)
@@ -109,10 +284,34 @@ namespace Opm {
           m_minpvMode( src.m_minpvMode ),
           m_pinch( src.m_pinch ),
           m_pinchoutMode( src.m_pinchoutMode ),
-          m_multzMode( src.m_multzMode )
+          m_multzMode( src.m_multzMode ),
+          m_pinchGap( src.m_pinchGap ),
+          m_pinchMaxEmptyGap( src.m_pinchMaxEmptyGap )
     {
         const int * actnum_data = (actnum.empty()) ? nullptr : actnum.data();
-        m_grid.reset( ecl_grid_alloc_processed_copy( src.c_ptr(), zcorn , actnum_data ));
+        m_active = src.m_active;
+
+        if (zcorn)
+            m_lazy.grid = shareGrid( ecl_grid_alloc_processed_copy( src.c_ptr(), zcorn , actnum_data ));
+        else {
+            /*
+              Only ACTNUM differs from src, so the geometry is shared
+              with src; the ERT grid is copied by c_ptr() if it is used.
+            */
+            m_lazy = src.m_lazy;
+            m_coord = src.m_coord;
+            m_zcorn = src.m_zcorn;
+            m_mapaxes = src.m_mapaxes;
+            m_cartesian = src.m_cartesian;
+            if (actnum_data)
+                m_lazy.active_geometry.reset();
+        }
+
+        if (actnum_data) {
+            m_active = std::make_shared< const ActiveIndex >( getCartesianSize(), actnum_data );
+            if (!zcorn)
+                m_lazy.grid_actnum_stale = bool( m_lazy.grid );
+        }
     }
 
 
@@ -130,8 +329,8 @@ namespace Opm {
     /*
       This is the main EclipseGrid constructor, it will inspect the
       input Deck for grid keywords, either the corner point keywords
-      COORD and ZCORN, or the various rectangular keywords like DX,DY
-      and DZ.
+      COORD and ZCORN, the various rectangular keywords like DX,DY
+      and DZ, or a GDFILE keyword naming a binary grid file.
 
       Actnum is treated specially:
 
@@ -162,11 +361,37 @@ namespace Opm {
           m_minpvMode(MinpvMode::ModeEnum::Inactive),
           m_pinch("PINCH"),
           m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
-          m_multzMode(PinchMode::ModeEnum::TOP)
+          m_multzMode(PinchMode::ModeEnum::TOP),
+          m_pinchGap(true),
+          m_pinchMaxEmptyGap(1e20)
+    {
+        initDeckGrid( deck, actnum, nullptr );
+    }
+
+
+    EclipseGrid::EclipseGrid(Deck& deck, const int * actnum, bool consumeDeck)
+        : GridDims(deck),
+          m_minpvValue(0),
+          m_minpvMode(MinpvMode::ModeEnum::Inactive),
+          m_pinch("PINCH"),
+          m_pinchoutMode(PinchMode::ModeEnum::TOPBOT),
+          m_multzMode(PinchMode::ModeEnum::TOP),
+          m_pinchGap(true),
+          m_pinchMaxEmptyGap(1e20)
     {
+        initDeckGrid( deck, actnum, consumeDeck ? &deck : nullptr );
+    }
+
+
+    void EclipseGrid::initDeckGrid(const Deck& deck, const int * actnum, Deck * consumeDeck) {
+        Trace::Span span( "EclipseGrid", "state" );
 
         const std::array<int, 3> dims = getNXYZ();
-        initGrid(dims, deck);
+        initGrid(dims, deck, consumeDeck);
+
+        /* An adopted corner point grid has set up the active index already. */
+        if (!m_zcorn)
+            initActiveIndex();
 
         if (actnum != nullptr)
             resetACTNUM(actnum);
@@ -187,12 +412,14 @@ namespace Opm {
         return this->m_circle;
     }
 
-    void EclipseGrid::initGrid( const std::array<int, 3>& dims, const Deck& deck) {
-        if (deck.hasKeyword<ParserKeywords::RADIAL>()) {
+    void EclipseGrid::initGrid( const std::array<int, 3>& dims, const Deck& deck, Deck * consumeDeck) {
+        if (deck.hasKeyword<ParserKeywords::GDFILE>()) {
+            initBinaryGrid( dims, deck );
+        } else if (deck.hasKeyword<ParserKeywords::RADIAL>()) {
             initCylindricalGrid( dims, deck );
         } else {
             if (hasCornerPointKeywords(deck)) {
-                initCornerPointGrid(dims , deck);
+                initCornerPointGrid(dims , deck, consumeDeck);
             } else if (hasCartesianKeywords(deck)) {
                 initCartesianGrid(dims , deck);
             } else {
@@ -210,6 +437,9 @@ namespace Opm {
 
             auto multzString = record.getItem<ParserKeywords::PINCH::MULTZ_OPTION>().get< std::string >(0);
             m_multzMode = PinchMode::PinchModeFromString(multzString);
+
+            m_pinchGap = record.getItem<ParserKeywords::PINCH::CONTROL_OPTION>().get< std::string >(0) != "NOGAP";
+            m_pinchMaxEmptyGap = record.getItem<ParserKeywords::PINCH::MAX_EMPTY_GAP>().getSIDouble(0);
         }
 
         if (deck.hasKeyword<ParserKeywords::MINPV>() && deck.hasKeyword<ParserKeywords::MINPVFIL>()) {
@@ -238,10 +468,10 @@ namespace Opm {
     }
 
     size_t EclipseGrid::activeIndex(size_t globalIndex) const {
-        int active_index = ecl_grid_get_active_index1( m_grid.get() , globalIndex );
-        if (active_index < 0)
+        assertGlobalIndex( globalIndex );
+        if (!m_active->active( globalIndex ))
             throw std::invalid_argument("Input argument does not correspond to an active cell");
-        return static_cast<size_t>( active_index );
+        return m_active->activeIndex( globalIndex );
     }
 
     /**
@@ -249,8 +479,7 @@ namespace Opm {
        [0,num_active).
     */
     size_t EclipseGrid::getGlobalIndex(size_t active_index) const {
-        int global_index = ecl_grid_get_global_index1A( m_grid.get() , active_index );
-        return static_cast<size_t>(global_index);
+        return m_active->globalIndex( active_index );
     }
 
     size_t EclipseGrid::getGlobalIndex(size_t i, size_t j, size_t k) const {
@@ -274,6 +503,14 @@ namespace Opm {
         return m_multzMode;
     }
 
+    bool EclipseGrid::getPinchGapMode( ) const {
+        return m_pinchGap;
+    }
+
+    double EclipseGrid::getPinchMaxEmptyGap( ) const {
+        return m_pinchMaxEmptyGap;
+    }
+
     MinpvMode::ModeEnum EclipseGrid::getMinpvMode() const {
         return m_minpvMode;
     }
@@ -283,6 +520,40 @@ namespace Opm {
     }
 
 
+    /*
+      The GDFILE keyword names a GRID or EGRID file; a relative path is
+      relative to the directory of the data file. The file is read by
+      ERT, which also determines whether it is formatted from the file
+      name, and the ACTNUM and MAPAXES of the file are used.
+    */
+    void EclipseGrid::initBinaryGrid(const std::array<int, 3>& dims, const Deck& deck) {
+        const auto& record = deck.getKeyword<ParserKeywords::GDFILE>().getRecord(0);
+        boost::filesystem::path filename( record.getItem<ParserKeywords::GDFILE::filename>().getTrimmedString(0) );
+        if (filename.is_relative() && !deck.getDataFile().empty())
+            filename = boost::filesystem::path( deck.getDataFile() ).parent_path() / filename;
+
+        ecl_grid_type * grid = ecl_grid_load_case__( filename.string().c_str() , false );
+        if (!grid) {
+            const std::string msg = "Could not load grid from GDFILE: " + filename.string();
+            m_messages.error(msg);
+            throw std::invalid_argument(msg);
+        }
+        m_lazy.grid = shareGrid( grid );
+
+        if (ecl_grid_get_nx( grid ) != dims[0] ||
+            ecl_grid_get_ny( grid ) != dims[1] ||
+            ecl_grid_get_nz( grid ) != dims[2]) {
+            const std::string msg = "The grid in GDFILE " + filename.string() + " has dimensions "
+                + std::to_string( ecl_grid_get_nx( grid )) + "x"
+                + std::to_string( ecl_grid_get_ny( grid )) + "x"
+                + std::to_string( ecl_grid_get_nz( grid )) + " - expected "
+                + std::to_string( dims[0] ) + "x" + std::to_string( dims[1] ) + "x" + std::to_string( dims[2] );
+            m_messages.error(msg);
+            throw std::invalid_argument(msg);
+        }
+    }
+
+
     void EclipseGrid::initCartesianGrid(const std::array<int, 3>& dims , const Deck& deck) {
         if (hasDVDEPTHZKeywords( deck ))
             initDVDEPTHZGrid( dims , deck );
@@ -304,7 +575,10 @@ namespace Opm {
         assertVectorSize( DYV    , static_cast<size_t>( dims[1] ) , "DYV");
         assertVectorSize( DZV    , static_cast<size_t>( dims[2] ) , "DZV");
 
-        m_grid.reset( ecl_grid_alloc_dxv_dyv_dzv_depthz( dims[0] , dims[1] , dims[2] , DXV.data() , DYV.data() , DZV.data() , DEPTHZ.data() , nullptr ) );
+        auto input = std::make_shared< CartesianInput >();
+        input->depthz = true;
+        input->arrays = {{ DXV, DYV, DZV, DEPTHZ }};
+        initCartesianInput( std::move( input ), nullptr );
     }
 
 
@@ -313,7 +587,25 @@ namespace Opm {
         std::vector<double> DY = createDVector( dims , 1 , "DY" , "DYV" , deck);
         std::vector<double> DZ = createDVector( dims , 2 , "DZ" , "DZV" , deck);
         std::vector<double> TOPS = createTOPSVector( dims , DZ , deck );
-        m_grid.reset( ecl_grid_alloc_dx_dy_dz_tops( dims[0] , dims[1] , dims[2] , DX.data() , DY.data() , DZ.data() , TOPS.data() , nullptr ) );
+
+        auto input = std::make_shared< CartesianInput >();
+        input->depthz = false;
+        input->arrays = {{ std::move( DX ), std::move( DY ), std::move( DZ ), std::move( TOPS ) }};
+        initCartesianInput( std::move( input ), nullptr );
+    }
+
+
+    void EclipseGrid::initCartesianInput(std::shared_ptr< const CartesianInput > input, const int * actnum) {
+        const auto& arrays = input->arrays;
+        if (input->depthz)
+            m_lazy.grid = shareGrid( ecl_grid_alloc_dxv_dyv_dzv_depthz( getNX() , getNY() , getNZ() ,
+                                                                        arrays[0].data() , arrays[1].data() ,
+                                                                        arrays[2].data() , arrays[3].data() , actnum ) );
+        else
+            m_lazy.grid = shareGrid( ecl_grid_alloc_dx_dy_dz_tops( getNX() , getNY() , getNZ() ,
+                                                                   arrays[0].data() , arrays[1].data() ,
+                                                                   arrays[2].data() , arrays[3].data() , actnum ) );
+        m_cartesian = std::move( input );
     }
 
 
@@ -433,19 +725,19 @@ namespace Opm {
                     }
                 }
             }
-            initCornerPointGrid( dims , coord, zcorn, nullptr, nullptr);
+            adoptCornerPointGrid( std::move( coord ), std::move( zcorn ), nullptr, nullptr );
         }
     }
 
 
     void EclipseGrid::initCornerPointGrid(const std::array<int,3>& dims ,
-                                          const std::vector<double>& coord ,
-                                          const std::vector<double>& zcorn ,
+                                          const double * coord ,
+                                          const double * zcorn ,
                                           const int * actnum,
-                                          const double * mapaxes)
+                                          const double * mapaxes) const
     {
-        const std::vector<float> zcorn_float( zcorn.begin() , zcorn.end() );
-        const std::vector<float> coord_float( coord.begin() , coord.end() );
+        const std::vector<float> zcorn_float( zcorn , zcorn + ZcornMapper( dims[0], dims[1], dims[2] ).size() );
+        const std::vector<float> coord_float( coord , coord + CoordMapper( dims[0], dims[1] ).size() );
         float * mapaxes_float = nullptr;
         if (mapaxes) {
             mapaxes_float = new float[6];
@@ -453,7 +745,7 @@ namespace Opm {
                 mapaxes_float[i] = mapaxes[i];
         }
 
-        m_grid.reset( ecl_grid_alloc_GRDECL_data(dims[0] ,
+        m_lazy.grid = shareGrid( ecl_grid_alloc_GRDECL_data(dims[0] ,
                                                  dims[1] ,
                                                  dims[2] ,
                                                  zcorn_float.data() ,
@@ -466,26 +758,71 @@ namespace Opm {
             delete[] mapaxes_float;
     }
 
-    void EclipseGrid::initCornerPointGrid(const std::array<int,3>& dims, const Deck& deck) {
+    /*
+      Used by the grids which own their COORD and ZCORN vectors; the ERT
+      grid is created on demand by c_ptr().
+    */
+    void EclipseGrid::adoptCornerPointGrid(std::vector<double>&& coord ,
+                                           std::vector<double>&& zcorn ,
+                                           const int * actnum,
+                                           const double * mapaxes)
+    {
+        const auto coord_data = std::make_shared< const std::vector<double> >( std::move( coord ) );
+        const auto zcorn_data = std::make_shared< const std::vector<double> >( std::move( zcorn ) );
+        m_coord = std::shared_ptr< const double >( coord_data, coord_data->data() );
+        m_zcorn = std::shared_ptr< const double >( zcorn_data, zcorn_data->data() );
+        if (mapaxes)
+            m_mapaxes.assign( mapaxes, mapaxes + 6 );
+
+        m_lazy.grid.reset();
+        m_active = std::make_shared< const ActiveIndex >( getCartesianSize(), actnum );
+    }
+
+
+    namespace {
+
+        /*
+          The last occurence of the keyword, as returned by
+          Deck::getKeyword( name ), but mutable.
+        */
+        DeckKeyword& lastKeyword( Deck& deck, const std::string& name ) {
+            DeckKeyword* keyword = nullptr;
+            for (auto& kw : deck)
+                if (kw.name() == name)
+                    keyword = &kw;
+
+            if (!keyword)
+                throw std::invalid_argument("Keyword " + name + " not in deck");
+
+            return *keyword;
+        }
+
+    }
+
+
+    void EclipseGrid::initCornerPointGrid(const std::array<int,3>& dims, const Deck& deck, Deck * consumeDeck) {
         assertCornerPointKeywords( dims , deck);
         {
-            const auto& ZCORNKeyWord = deck.getKeyword<ParserKeywords::ZCORN>();
-            const auto& COORDKeyWord = deck.getKeyword<ParserKeywords::COORD>();
-            const std::vector<double>& zcorn = ZCORNKeyWord.getSIDoubleData();
-            const std::vector<double>& coord = COORDKeyWord.getSIDoubleData();
-            double * mapaxes = nullptr;
+            std::vector<double> mapaxes_data;
+            const double * mapaxes = nullptr;
 
             if (deck.hasKeyword<ParserKeywords::MAPAXES>()) {
                 const auto& mapaxesKeyword = deck.getKeyword<ParserKeywords::MAPAXES>();
                 const auto& record = mapaxesKeyword.getRecord(0);
-                mapaxes = new double[6];
-                for (size_t i = 0; i < 6; i++) {
-                    mapaxes[i] = record.getItem( i ).getSIDouble( 0 );
-                }
+                for (size_t i = 0; i < 6; i++)
+                    mapaxes_data.push_back( record.getItem( i ).getSIDouble( 0 ) );
+                mapaxes = mapaxes_data.data();
+            }
+
+            if (consumeDeck) {
+                auto coord = lastKeyword( *consumeDeck, ParserKeywords::COORD::keywordName ).releaseSIDoubleData();
+                auto zcorn = lastKeyword( *consumeDeck, ParserKeywords::ZCORN::keywordName ).releaseSIDoubleData();
+                adoptCornerPointGrid( std::move( coord ), std::move( zcorn ), nullptr, mapaxes );
+            } else {
+                const auto& zcorn = deck.getKeyword<ParserKeywords::ZCORN>().getSIDoubleData();
+                const auto& coord = deck.getKeyword<ParserKeywords::COORD>().getSIDoubleData();
+                initCornerPointGrid( dims, coord.data() , zcorn.data() , nullptr , mapaxes );
             }
-            initCornerPointGrid( dims, coord , zcorn , nullptr , mapaxes );
-            if (mapaxes)
-                delete[] mapaxes;
         }
     }
 
@@ -695,7 +1032,28 @@ namespace Opm {
     }
 
     const ecl_grid_type * EclipseGrid::c_ptr() const {
-        return m_grid.get();
+        std::lock_guard< std::recursive_mutex > lock( *m_lazy.mutex );
+        if (m_lazy.grid && m_lazy.grid_actnum_stale) {
+            std::vector<int> actnum;
+            this->exportACTNUM( actnum );
+
+            auto grid = shareGrid( ecl_grid_alloc_copy( m_lazy.grid.get() ));
+            ecl_grid_reset_actnum( grid.get() , actnum.empty() ? nullptr : actnum.data() );
+            m_lazy.grid = grid;
+            m_lazy.grid_actnum_stale = false;
+        }
+
+        if (!m_lazy.grid && m_zcorn) {
+            std::vector<int> actnum;
+            this->exportACTNUM( actnum );
+            initCornerPointGrid( getNXYZ(),
+                                 m_coord.get(),
+                                 m_zcorn.get(),
+                                 actnum.empty() ? nullptr : actnum.data(),
+                                 m_mapaxes.empty() ? nullptr : m_mapaxes.data() );
+        }
+
+        return m_lazy.grid.get();
     }
 
 
@@ -719,76 +1077,59 @@ namespace Opm {
 
 
     size_t EclipseGrid::getNumActive( ) const {
-        return static_cast<size_t>(ecl_grid_get_nactive( c_ptr() ));
+        return m_active->numActive();
     }
 
     bool EclipseGrid::allActive( ) const {
-        return (getNumActive() == getCartesianSize());
+        return m_active->allActive();
     }
 
     bool EclipseGrid::cellActive( size_t globalIndex ) const {
         assertGlobalIndex( globalIndex );
-        return ecl_grid_cell_active1( c_ptr() , static_cast<int>(globalIndex));
+        return m_active->active( globalIndex );
     }
 
     bool EclipseGrid::cellActive( size_t i , size_t j , size_t k ) const {
         assertIJK(i,j,k);
-        return ecl_grid_cell_active3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k));
+        return m_active->active( getGlobalIndex( i,j,k ));
     }
 
 
     double EclipseGrid::getCellVolume(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
-        return ecl_grid_get_cell_volume1( c_ptr() , static_cast<int>(globalIndex));
+        return this->geometry().volume()[ globalIndex ];
     }
 
 
     double EclipseGrid::getCellVolume(size_t i , size_t j , size_t k) const {
         assertIJK(i,j,k);
-        return ecl_grid_get_cell_volume3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k));
+        return this->geometry().volume()[ getGlobalIndex( i,j,k ) ];
     }
 
     double EclipseGrid::getCellThicknes(size_t i , size_t j , size_t k) const {
         assertIJK(i,j,k);
-        return ecl_grid_get_cell_thickness3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k));
+        return this->geometry().thickness()[ getGlobalIndex( i,j,k ) ];
     }
 
     double EclipseGrid::getCellThicknes(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
-        return ecl_grid_get_cell_thickness1( c_ptr() , static_cast<int>(globalIndex));
+        return this->geometry().thickness()[ globalIndex ];
     }
 
 
     std::array<double, 3> EclipseGrid::getCellDims(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
-        {
-            double dx = ecl_grid_get_cell_dx1( c_ptr() , globalIndex);
-            double dy = ecl_grid_get_cell_dy1( c_ptr() , globalIndex);
-            double dz = ecl_grid_get_cell_thickness1( c_ptr() , globalIndex);
-
-            return std::array<double,3>{ {dx , dy , dz }};
-        }
+        return this->geometry().cellDims( globalIndex );
     }
 
     std::array<double, 3> EclipseGrid::getCellDims(size_t i , size_t j , size_t k) const {
         assertIJK(i,j,k);
-        {
-            size_t globalIndex = getGlobalIndex( i,j,k );
-            double dx = ecl_grid_get_cell_dx1( c_ptr() , globalIndex);
-            double dy = ecl_grid_get_cell_dy1( c_ptr() , globalIndex);
-            double dz = ecl_grid_get_cell_thickness1( c_ptr() , globalIndex);
-
-            return std::array<double,3>{ {dx , dy , dz }};
-        }
+        return this->geometry().cellDims( getGlobalIndex( i,j,k ) );
     }
 
     std::array<double, 3> EclipseGrid::getCellCenter(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
-        {
-            double x,y,z;
-            ecl_grid_get_xyz1( c_ptr() , static_cast<int>(globalIndex) , &x , &y , &z);
-            return std::array<double, 3>{{x,y,z}};
-        }
+        return this->geometry().center( globalIndex );
     }
 
     /*
@@ -811,6 +1152,13 @@ namespace Opm {
         assertIJK(i,j,k);
         if (corner_index >= 8)
             throw std::invalid_argument("Invalid corner position");
+
+        if (m_zcorn) {
+            std::array<std::array<double, 3>, 8> corners;
+            GridGeometry::cellCorners( getNX(), getNY(), m_coord.get(), m_zcorn.get(), i, j, k, corners );
+            return corners[ corner_index ];
+        }
+
         {
             double x,y,z;
             ecl_grid_get_cell_corner_xyz3( c_ptr() ,
@@ -826,22 +1174,242 @@ namespace Opm {
 
     std::array<double, 3> EclipseGrid::getCellCenter(size_t i,size_t j, size_t k) const {
         assertIJK(i,j,k);
-        {
-            double x,y,z;
-            ecl_grid_get_xyz3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k), &x , &y , &z);
-            return std::array<double, 3>{{x,y,z}};
-        }
+        return this->geometry().center( getGlobalIndex( i,j,k ) );
     }
 
     double EclipseGrid::getCellDepth(size_t globalIndex) const {
         assertGlobalIndex( globalIndex );
-        return ecl_grid_get_cdepth1( c_ptr() , static_cast<int>(globalIndex));
+        return this->geometry().depth()[ globalIndex ];
     }
 
 
     double EclipseGrid::getCellDepth(size_t i,size_t j, size_t k) const {
         assertIJK(i,j,k);
-        return ecl_grid_get_cdepth3( c_ptr() , static_cast<int>(i),static_cast<int>(j),static_cast<int>(k));
+        return this->geometry().depth()[ getGlobalIndex( i,j,k ) ];
+    }
+
+
+    /*
+      The geometry is computed from the raw ZCORN values, i.e. without
+      the adjustments of exportZCORN(); for a grid without COORD and
+      ZCORN arrays it is computed from the cell corners of the ERT grid,
+      the same corners as returned by getCornerPos().
+    */
+    const GridGeometry& EclipseGrid::geometry() const {
+        if( const auto* geometry = this->m_lazy.geometry_ptr.load( std::memory_order_acquire ) )
+            return *geometry;
+
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lazy.mutex );
+        if( !this->m_lazy.geometry ) {
+            if( this->m_zcorn )
+                this->m_lazy.geometry = std::make_shared< const GridGeometry >( getNX(), getNY(), getNZ(),
+                                                                               this->m_coord.get(), this->m_zcorn.get() );
+            else {
+                this->c_ptr();
+                this->m_lazy.geometry = std::make_shared< const GridGeometry >( *this, ertCellCorners( this->m_lazy.grid ) );
+            }
+        }
+
+        this->m_lazy.geometry_ptr.store( this->m_lazy.geometry.get(), std::memory_order_release );
+        return *this->m_lazy.geometry;
+    }
+
+
+    const CellLocator& EclipseGrid::locator() const {
+        if( const auto* locator = this->m_lazy.locator_ptr.load( std::memory_order_acquire ) )
+            return *locator;
+
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lazy.mutex );
+        if( !this->m_lazy.locator ) {
+            if( this->m_zcorn )
+                this->m_lazy.locator = std::make_shared< const CellLocator >( *this, this->m_coord, this->m_zcorn );
+            else {
+                this->c_ptr();
+                this->m_lazy.locator = std::make_shared< const CellLocator >( *this, ertCellCorners( this->m_lazy.grid ) );
+            }
+        }
+
+        this->m_lazy.locator_ptr.store( this->m_lazy.locator.get(), std::memory_order_release );
+        return *this->m_lazy.locator;
+    }
+
+
+    void EclipseGrid::finalize() const {
+        this->locator();
+        for (bool active_only : { false, true }) {
+            this->getCellVolumes( active_only );
+            this->getCellDepths( active_only );
+            this->getCellThicknesses( active_only );
+            this->getCellCenters( active_only );
+            this->getCellDimensions( active_only );
+        }
+    }
+
+
+    EclipseGrid::LazyState::LazyState() :
+        mutex( std::make_shared< std::recursive_mutex >() ),
+        geometry_ptr( nullptr ),
+        locator_ptr( nullptr )
+    {}
+
+    EclipseGrid::LazyState::LazyState( const LazyState& other ) :
+        geometry_ptr( nullptr ),
+        locator_ptr( nullptr )
+    {
+        *this = other;
+    }
+
+    EclipseGrid::LazyState::LazyState( LazyState&& other ) noexcept :
+        geometry_ptr( nullptr ),
+        locator_ptr( nullptr )
+    {
+        *this = std::move( other );
+    }
+
+    /*
+      The mutex is shared along with the cached state, since the cell
+      geometry vectors are filled in place by whichever copy of the grid
+      asks first.
+    */
+    EclipseGrid::LazyState& EclipseGrid::LazyState::operator=( const LazyState& other ) {
+        if (this == &other)
+            return *this;
+
+        std::lock_guard< std::recursive_mutex > lock( *other.mutex );
+        this->mutex = other.mutex;
+        this->geometry = other.geometry;
+        this->locator = other.locator;
+        this->cell_geometry = other.cell_geometry;
+        this->active_geometry = other.active_geometry;
+        this->grid = other.grid;
+        this->grid_actnum_stale = other.grid_actnum_stale;
+        this->geometry_ptr.store( this->geometry.get(), std::memory_order_release );
+        this->locator_ptr.store( this->locator.get(), std::memory_order_release );
+        return *this;
+    }
+
+    /*
+      The moved from state keeps the mutex, so that the const methods of
+      a moved from grid can still be called. Like any move, this must not
+      race with readers of other, so it takes no lock and cannot throw.
+    */
+    EclipseGrid::LazyState& EclipseGrid::LazyState::operator=( LazyState&& other ) noexcept {
+        if (this == &other)
+            return *this;
+
+        this->mutex = other.mutex;
+        this->geometry = std::move( other.geometry );
+        this->locator = std::move( other.locator );
+        this->cell_geometry = std::move( other.cell_geometry );
+        this->active_geometry = std::move( other.active_geometry );
+        this->grid = std::move( other.grid );
+        this->grid_actnum_stale = other.grid_actnum_stale;
+        this->geometry_ptr.store( this->geometry.get(), std::memory_order_release );
+        this->locator_ptr.store( this->locator.get(), std::memory_order_release );
+        other.grid_actnum_stale = false;
+        other.geometry_ptr.store( nullptr );
+        other.locator_ptr.store( nullptr );
+        return *this;
+    }
+
+
+    namespace {
+
+        /*
+          Fill values[i] = f( index[i] ), or f( i ) if index is null, for
+          i in [0,size).
+        */
+        template< typename T, typename F >
+        const std::vector< T >& fill( std::vector< T >& values, size_t size, const std::vector< int >* index, F f ) {
+            values.resize( size );
+
+            #pragma omp parallel for schedule(static)
+            for( size_t i = 0; i < size; i++ )
+                values[ i ] = f( index ? size_t( (*index)[ i ] ) : i );
+
+            return values;
+        }
+
+    }
+
+    /*
+      The cached geometry vectors are shared between copies of the grid;
+      the active vectors are replaced, not cleared, when ACTNUM changes.
+      The vectors are filled with the lock held, so a reader never sees
+      a vector which is only partly filled.
+    */
+    EclipseGrid::CellGeometry& EclipseGrid::cellGeometry(bool active_only) const {
+        auto& geometry = active_only ? this->m_lazy.active_geometry : this->m_lazy.cell_geometry;
+        if (!geometry)
+            geometry = std::make_shared< CellGeometry >();
+
+        return *geometry;
+    }
+
+    const std::vector<double>& EclipseGrid::getCellVolumes(bool active_only) const {
+        const auto& volume = this->geometry().volume();
+        if (!active_only)
+            return volume;
+
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lazy.mutex );
+        auto& values = this->cellGeometry( true ).volumes;
+        if (values.size() == this->getNumActive())
+            return values;
+
+        return fill( values, this->getNumActive(), &this->getActiveMap(),
+                     [&volume]( size_t g ) { return volume[ g ]; } );
+    }
+
+    const std::vector<double>& EclipseGrid::getCellDepths(bool active_only) const {
+        const auto& depth = this->geometry().depth();
+        if (!active_only)
+            return depth;
+
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lazy.mutex );
+        auto& values = this->cellGeometry( true ).depths;
+        if (values.size() == this->getNumActive())
+            return values;
+
+        return fill( values, this->getNumActive(), &this->getActiveMap(),
+                     [&depth]( size_t g ) { return depth[ g ]; } );
+    }
+
+    const std::vector<double>& EclipseGrid::getCellThicknesses(bool active_only) const {
+        const auto& thickness = this->geometry().thickness();
+        if (!active_only)
+            return thickness;
+
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lazy.mutex );
+        auto& values = this->cellGeometry( true ).thicknesses;
+        if (values.size() == this->getNumActive())
+            return values;
+
+        return fill( values, this->getNumActive(), &this->getActiveMap(),
+                     [&thickness]( size_t g ) { return thickness[ g ]; } );
+    }
+
+    const std::vector<std::array<double, 3>>& EclipseGrid::getCellCenters(bool active_only) const {
+        const auto& geometry = this->geometry();
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lazy.mutex );
+        auto& values = this->cellGeometry( active_only ).centers;
+        const size_t size = active_only ? this->getNumActive() : this->getCartesianSize();
+        if (values.size() == size)
+            return values;
+
+        return fill( values, size, active_only ? &this->getActiveMap() : nullptr,
+                     [&geometry]( size_t g ) { return geometry.center( g ); } );
+    }
+
+    const std::vector<std::array<double, 3>>& EclipseGrid::getCellDimensions(bool active_only) const {
+        const auto& geometry = this->geometry();
+        std::lock_guard< std::recursive_mutex > lock( *this->m_lazy.mutex );
+        auto& values = this->cellGeometry( active_only ).dims;
+        const size_t size = active_only ? this->getNumActive() : this->getCartesianSize();
+        if (values.size() == size)
+            return values;
+
+        return fill( values, size, active_only ? &this->getActiveMap() : nullptr,
+                     [&geometry]( size_t g ) { return geometry.cellDims( g ); } );
     }
 
 
@@ -852,12 +1420,15 @@ namespace Opm {
             actnum.resize(0);
         else {
             actnum.resize( volume );
-            ecl_grid_init_actnum_data( c_ptr() , actnum.data() );
+            for (size_t g = 0; g < volume; g++)
+                actnum[g] = m_active->active( g ) ? 1 : 0;
         }
     }
 
     void EclipseGrid::exportMAPAXES( std::vector<double>& mapaxes) const {
-        if (ecl_grid_use_mapaxes( c_ptr())) {
+        if (m_zcorn)
+            mapaxes = m_mapaxes;
+        else if (ecl_grid_use_mapaxes( c_ptr())) {
             mapaxes.resize(6);
             ecl_grid_init_mapaxes_data_double( c_ptr() , mapaxes.data() );
         } else {
@@ -866,43 +1437,64 @@ namespace Opm {
     }
 
     void EclipseGrid::exportCOORD( std::vector<double>& coord) const {
+        if (m_coord) {
+            coord.assign( m_coord.get(), m_coord.get() + CoordMapper( getNX(), getNY() ).size() );
+            return;
+        }
+
         coord.resize( ecl_grid_get_coord_size( c_ptr() ));
         ecl_grid_init_coord_data_double( c_ptr() , coord.data() );
     }
 
     size_t EclipseGrid::exportZCORN( std::vector<double>& zcorn) const {
-        ZcornMapper mapper( getNX(), getNY(), getNZ());
+        const auto mapper = this->zcornMapper();
 
-        zcorn.resize( ecl_grid_get_zcorn_size( c_ptr() ));
-        ecl_grid_init_zcorn_data_double( c_ptr() , zcorn.data() );
+        if (m_zcorn)
+            zcorn.assign( m_zcorn.get(), m_zcorn.get() + mapper.size() );
+        else {
+            zcorn.resize( ecl_grid_get_zcorn_size( c_ptr() ));
+            ecl_grid_init_zcorn_data_double( c_ptr() , zcorn.data() );
+        }
 
-        return mapper.fixupZCORN( zcorn );
+        return mapper.fixupZCORN( zcorn.data() );
     }
 
+    size_t EclipseGrid::countZCORNOverlaps() const {
+        const auto mapper = this->zcornMapper();
+        if (m_zcorn)
+            return mapper.countOverlaps( m_zcorn.get() );
 
+        std::vector<double> zcorn( ecl_grid_get_zcorn_size( c_ptr() ));
+        ecl_grid_init_zcorn_data_double( c_ptr() , zcorn.data() );
+        return mapper.countOverlaps( zcorn.data() );
+    }
 
-    const std::vector<int>& EclipseGrid::getActiveMap() const {
-        if( !this->activeMap.empty() ) return this->activeMap;
-
-        this->activeMap.resize( this->getNumActive() );
-        const auto size = int(this->getCartesianSize());
 
-        for( int global_index = 0; global_index < size; global_index++) {
-            // Using the low level C function to get the active index, because the C++
-            // version will throw for inactive cells.
-            int active_index = ecl_grid_get_active_index1( m_grid.get() , global_index );
-            if (active_index >= 0)
-                this->activeMap[ active_index ] = global_index;
-        }
 
-        return this->activeMap;
+    const std::vector<int>& EclipseGrid::getActiveMap() const {
+        return m_active->globalIndices();
     }
 
     void EclipseGrid::resetACTNUM( const int * actnum) {
-        ecl_grid_reset_actnum( m_grid.get() , actnum );
-        /* re-build the active map cache */
-        this->activeMap.clear();
-        this->getActiveMap();
+        /* A shared ERT grid is copied by c_ptr() when it is next used. */
+        if (m_lazy.grid && m_lazy.grid.use_count() == 1) {
+            ecl_grid_reset_actnum( m_lazy.grid.get() , actnum );
+            m_lazy.grid_actnum_stale = false;
+        } else
+            m_lazy.grid_actnum_stale = bool( m_lazy.grid );
+
+        m_active = std::make_shared< const ActiveIndex >( getCartesianSize(), actnum );
+        m_lazy.active_geometry.reset();
+    }
+
+    /*
+      Build the active index from the ACTNUM of the ERT grid; used by the
+      constructors where the active cells are given by ERT.
+    */
+    void EclipseGrid::initActiveIndex() {
+        std::vector<int> actnum( getCartesianSize() );
+        ecl_grid_init_actnum_data( c_ptr() , actnum.data() );
+        m_active = std::make_shared< const ActiveIndex >( actnum.size(), actnum.data() );
     }
 
     ZcornMapper EclipseGrid::zcornMapper() const {
@@ -947,67 +1539,72 @@ namespace Opm {
         return index(i,j,k,c);
     }
 
-    bool ZcornMapper::validZCORN( const std::vector<double>& zcorn) const {
-        int sign = zcorn[ this->index(0,0,0,0) ] <= zcorn[this->index(0,0, this->dims[2] - 1,4)] ? 1 : -1;
-        for (size_t j=0; j < this->dims[1]; j++)
-            for (size_t i=0; i < this->dims[0]; i++)
-                for (size_t c=0; c < 4; c++)
-                    for (size_t k=0; k < this->dims[2]; k++) {
-                        /* Between cells */
-                        if (k > 0) {
-                            size_t index1 = this->index(i,j,k-1,c+4);
-                            size_t index2 = this->index(i,j,k,c);
-                            if ((zcorn[index2] - zcorn[index1]) * sign < 0)
-                                return false;
-                        }
-
-                        /* In cell */
-                        {
-                            size_t index1 = this->index(i,j,k,c);
-                            size_t index2 = this->index(i,j,k,c+4);
-                            if ((zcorn[index2] - zcorn[index1]) * sign < 0)
-                                return false;
-                        }
-                    }
+    /*
+      The z coordinates of one corner of a pillar, i.e. the column
+      (i,j,c) for c in [0,4), are only compared with each other, so the
+      columns can be processed independently. Walking down a column each
+      point must be at or below the previous point after fixup; prev is
+      the previous point as it is after fixup, which lets the count of
+      overlaps be computed without modifying the buffer; the buffer is
+      only written to when T is non-const.
+    */
+    namespace {
+        void adjustPoint( double& z, double value ) { z = value; }
+        void adjustPoint( const double&, double ) {}
+    }
+
+    template< typename T >
+    size_t ZcornMapper::processZCORN( T* zcorn ) const {
+        const size_t nx = this->dims[0];
+        const size_t nz = this->dims[2];
+        const size_t columns = 4 * nx * this->dims[1];
+        const size_t layer = this->cell_shift[4];
+        const double sign = zcorn[ this->index(0,0,0,0) ] <= zcorn[ this->index(0,0, nz - 1,4) ] ? 1 : -1;
+        size_t points_adjusted = 0;
+
+        #pragma omp parallel for schedule(static) reduction(+:points_adjusted)
+        for( size_t col = 0; col < columns; col++ ) {
+            const size_t c = col % 4;
+            const size_t i = ( col / 4 ) % nx;
+            const size_t j = col / ( 4 * nx );
+            const size_t base = i * this->stride[0] + j * this->stride[1] + this->cell_shift[c];
+
+            double prev = zcorn[ base ];
+            for( size_t k = 0; k < nz; k++ ) {
+                const size_t top = base + k * this->stride[2];
+                for( const size_t index : { top, top + layer } ) {
+                    if( index == base ) continue;
+
+                    if( ( zcorn[ index ] - prev ) * sign < 0 ) {
+                        points_adjusted++;
+                        adjustPoint( zcorn[ index ], prev );
+                    } else
+                        prev = zcorn[ index ];
+                }
+            }
+        }
 
-        return true;
+        return points_adjusted;
     }
 
+    bool ZcornMapper::validZCORN( const std::vector<double>& zcorn) const {
+        return this->validZCORN( zcorn.data() );
+    }
 
+    bool ZcornMapper::validZCORN( const double* zcorn ) const {
+        return this->countOverlaps( zcorn ) == 0;
+    }
 
+    size_t ZcornMapper::countOverlaps( const double* zcorn ) const {
+        return this->processZCORN( zcorn );
+    }
 
     size_t ZcornMapper::fixupZCORN( std::vector<double>& zcorn) {
-        int sign = zcorn[ this->index(0,0,0,0) ] <= zcorn[this->index(0,0, this->dims[2] - 1,4)] ? 1 : -1;
-        size_t cells_adjusted = 0;
-
-        for (size_t k=0; k < this->dims[2]; k++)
-            for (size_t j=0; j < this->dims[1]; j++)
-                for (size_t i=0; i < this->dims[0]; i++)
-                    for (size_t c=0; c < 4; c++) {
-                        /* Cell to cell */
-                        if (k > 0) {
-                            size_t index1 = this->index(i,j,k-1,c+4);
-                            size_t index2 = this->index(i,j,k,c);
-
-                            if ((zcorn[index2] - zcorn[index1]) * sign < 0 ) {
-                                zcorn[index2] = zcorn[index1];
-                                cells_adjusted++;
-                            }
-                        }
-
-
-                        /* Cell internal */
-                        {
-                            size_t index1 = this->index(i,j,k,c);
-                            size_t index2 = this->index(i,j,k,c+4);
+        return this->fixupZCORN( zcorn.data() );
+    }
 
-                            if ((zcorn[index2] - zcorn[index1]) * sign < 0 ) {
-                                zcorn[index2] = zcorn[index1];
-                                cells_adjusted++;
-                            }
-                        }
-                    }
-        return cells_adjusted;
+    size_t ZcornMapper::fixupZCORN( double* zcorn ) const {
+        return this->processZCORN( zcorn );
     }
 
 
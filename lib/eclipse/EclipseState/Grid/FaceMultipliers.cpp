@@ -0,0 +1,189 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdexcept>
+
+#include <opm/parser/eclipse/EclipseState/Grid/FaceMultipliers.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
+
+namespace Opm {
+
+    FaceMultipliers::FaceMultipliers( size_t size ) :
+        m_size( size )
+    {}
+
+    FaceMultipliers::FaceMultipliers( BinaryReader& reader ) :
+        m_size( reader.read< uint64_t >() ),
+        m_dense( reader.readArray< double >() ),
+        m_values( reader.readArray< double >() )
+    {
+        const auto indices = reader.readView< uint64_t >();
+        if( ( !this->m_dense.empty() && this->m_dense.size() != this->m_size )
+            || indices.size != this->m_values.size() )
+            throw std::runtime_error( "The serialized face multipliers do not match their size" );
+
+        this->m_indices.assign( indices.begin(), indices.end() );
+    }
+
+    void FaceMultipliers::serialize( BinaryWriter& writer ) const {
+        writer.write( uint64_t( this->m_size ) );
+        writer.writeArray( this->m_dense );
+        writer.writeArray( this->m_values );
+        writer.writeArray( std::vector< uint64_t >( this->m_indices.begin(), this->m_indices.end() ) );
+    }
+
+    size_t FaceMultipliers::size() const {
+        return this->m_size;
+    }
+
+    bool FaceMultipliers::isDense() const {
+        return !this->m_dense.empty();
+    }
+
+    size_t FaceMultipliers::numMultipliers() const {
+        if( !this->isDense() )
+            return this->m_indices.size();
+
+        return this->m_size - std::count( this->m_dense.begin(), this->m_dense.end(), 1.0 );
+    }
+
+    const std::vector< double >& FaceMultipliers::data() const {
+        return this->m_dense;
+    }
+
+    const std::vector< size_t >& FaceMultipliers::indices() const {
+        return this->m_indices;
+    }
+
+    const std::vector< double >& FaceMultipliers::values() const {
+        return this->m_values;
+    }
+
+    std::vector< double > FaceMultipliers::exportDense() const {
+        if( this->isDense() )
+            return this->m_dense;
+
+        std::vector< double > dense( this->m_size, 1.0 );
+        for( size_t i = 0; i < this->m_indices.size(); i++ )
+            dense[ this->m_indices[ i ] ] = this->m_values[ i ];
+
+        return dense;
+    }
+
+    void FaceMultipliers::multiply( const std::vector< double >& values ) {
+        if( values.size() != this->m_size )
+            throw std::invalid_argument( "Size mismatch when applying face multipliers" );
+
+        if( std::all_of( values.begin(), values.end(), []( double v ) { return v == 1.0; } ) )
+            return;
+
+        if( !this->isDense() ) {
+            this->m_dense = this->exportDense();
+            this->m_indices.clear();
+            this->m_values.clear();
+            this->m_indices.shrink_to_fit();
+            this->m_values.shrink_to_fit();
+        }
+
+        for( size_t g = 0; g < this->m_size; g++ )
+            this->m_dense[ g ] *= values[ g ];
+
+        this->compact();
+    }
+
+    void FaceMultipliers::multiplyFaces( std::vector< std::pair< size_t, double > > updates ) {
+        for( const auto& update : updates )
+            if( update.first >= this->m_size )
+                throw std::invalid_argument( "Invalid global index when applying face multipliers" );
+
+        if( this->isDense() ) {
+            for( const auto& update : updates )
+                this->m_dense[ update.first ] *= update.second;
+
+            this->compact();
+            return;
+        }
+
+        const auto indexLess = []( const std::pair< size_t, double >& a, const std::pair< size_t, double >& b ) {
+            return a.first < b.first;
+        };
+        if( !std::is_sorted( updates.begin(), updates.end(), indexLess ) )
+            std::stable_sort( updates.begin(), updates.end(), indexLess );
+
+        std::vector< size_t > indices;
+        std::vector< double > values;
+        indices.reserve( this->m_indices.size() + updates.size() );
+        values.reserve( this->m_indices.size() + updates.size() );
+
+        size_t current = 0;
+        auto update = updates.begin();
+        while( current < this->m_indices.size() || update != updates.end() ) {
+            size_t index;
+            double value = 1.0;
+
+            if( update == updates.end() || ( current < this->m_indices.size() && this->m_indices[ current ] <= update->first ) ) {
+                index = this->m_indices[ current ];
+                value = this->m_values[ current++ ];
+            } else
+                index = update->first;
+
+            for( ; update != updates.end() && update->first == index; ++update )
+                value *= update->second;
+
+            if( value != 1.0 ) {
+                indices.push_back( index );
+                values.push_back( value );
+            }
+        }
+
+        this->m_indices = std::move( indices );
+        this->m_values = std::move( values );
+        this->compact();
+    }
+
+    void FaceMultipliers::compact() {
+        const size_t count = this->numMultipliers();
+        const bool sparse = 8 * count <= this->m_size;
+
+        if( sparse && this->isDense() ) {
+            std::vector< size_t > indices;
+            std::vector< double > values;
+            indices.reserve( count );
+            values.reserve( count );
+            for( size_t g = 0; g < this->m_size; g++ ) {
+                if( this->m_dense[ g ] == 1.0 ) continue;
+                indices.push_back( g );
+                values.push_back( this->m_dense[ g ] );
+            }
+
+            this->m_indices = std::move( indices );
+            this->m_values = std::move( values );
+            this->m_dense.clear();
+            this->m_dense.shrink_to_fit();
+        } else if( !sparse && !this->isDense() ) {
+            this->m_dense = this->exportDense();
+            this->m_indices.clear();
+            this->m_values.clear();
+            this->m_indices.shrink_to_fit();
+            this->m_values.shrink_to_fit();
+        }
+    }
+
+}
@@ -0,0 +1,149 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+
+#include <opm/parser/eclipse/EclipseState/Grid/Fault.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaultCollection.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaultFace.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaultIndex.hpp>
+#include <opm/parser/eclipse/Utility/ParallelSort.hpp>
+
+namespace Opm {
+
+namespace {
+
+    bool faceLess( const FaultIndex::Face& a, const FaultIndex::Face& b ) {
+        return a.globalIndex < b.globalIndex
+            || ( a.globalIndex == b.globalIndex && a.faceDir < b.faceDir );
+    }
+
+    FaceDir::DirEnum opposite( FaceDir::DirEnum faceDir ) {
+        switch( faceDir ) {
+            case FaceDir::XPlus:  return FaceDir::XMinus;
+            case FaceDir::XMinus: return FaceDir::XPlus;
+            case FaceDir::YPlus:  return FaceDir::YMinus;
+            case FaceDir::YMinus: return FaceDir::YPlus;
+            case FaceDir::ZPlus:  return FaceDir::ZMinus;
+            case FaceDir::ZMinus: return FaceDir::ZPlus;
+        }
+        return faceDir;
+    }
+
+}
+
+    FaultIndex::FaultIndex() :
+        GridDims()
+    {}
+
+    FaultIndex::FaultIndex( const GridDims& dims, const FaultCollection& faults ) :
+        GridDims( dims.getNX(), dims.getNY(), dims.getNZ() )
+    {
+        struct Range {
+            const FaultFace* face;
+            int fault;
+            size_t offset;
+        };
+
+        std::vector< Range > ranges;
+        size_t size = 0;
+        for( size_t index = 0; index < faults.size(); index++ ) {
+            for( const auto& face : faults.getFault( index ) ) {
+                ranges.push_back( Range{ &face, int( index ), size } );
+                size += std::distance( face.begin(), face.end() );
+            }
+        }
+
+        this->m_faces.resize( size );
+
+        #pragma omp parallel for schedule(static)
+        for( size_t r = 0; r < ranges.size(); r++ ) {
+            const auto& range = ranges[ r ];
+            auto face = this->m_faces.begin() + range.offset;
+            for( auto globalIndex : *range.face )
+                *face++ = Face{ globalIndex, range.face->getDir(), range.fault };
+        }
+
+        parallelStableSort( this->m_faces.begin(), this->m_faces.end(), faceLess );
+    }
+
+    size_t FaultIndex::size() const {
+        return this->m_faces.size();
+    }
+
+    const std::vector< FaultIndex::Face >& FaultIndex::faces() const {
+        return this->m_faces;
+    }
+
+    int FaultIndex::find( size_t globalIndex, FaceDir::DirEnum faceDir ) const {
+        const Face key{ globalIndex, faceDir, 0 };
+        const auto pos = std::lower_bound( this->m_faces.begin(), this->m_faces.end(), key, faceLess );
+        if( pos == this->m_faces.end() || faceLess( key, *pos ) )
+            return -1;
+
+        return pos->fault;
+    }
+
+    int FaultIndex::getFault( size_t globalIndex, FaceDir::DirEnum faceDir ) const {
+        this->assertGlobalIndex( globalIndex );
+
+        const int fault = this->find( globalIndex, faceDir );
+        if( fault >= 0 )
+            return fault;
+
+        const auto ijk = this->getIJK( globalIndex );
+        size_t neighbour;
+        switch( faceDir ) {
+            case FaceDir::XPlus:
+                if( size_t( ijk[ 0 ] ) + 1 == this->m_nx ) return -1;
+                neighbour = globalIndex + 1;
+                break;
+            case FaceDir::XMinus:
+                if( ijk[ 0 ] == 0 ) return -1;
+                neighbour = globalIndex - 1;
+                break;
+            case FaceDir::YPlus:
+                if( size_t( ijk[ 1 ] ) + 1 == this->m_ny ) return -1;
+                neighbour = globalIndex + this->m_nx;
+                break;
+            case FaceDir::YMinus:
+                if( ijk[ 1 ] == 0 ) return -1;
+                neighbour = globalIndex - this->m_nx;
+                break;
+            case FaceDir::ZPlus:
+                if( size_t( ijk[ 2 ] ) + 1 == this->m_nz ) return -1;
+                neighbour = globalIndex + this->m_nx * this->m_ny;
+                break;
+            case FaceDir::ZMinus:
+                if( ijk[ 2 ] == 0 ) return -1;
+                neighbour = globalIndex - this->m_nx * this->m_ny;
+                break;
+            default:
+                return -1;
+        }
+
+        return this->find( neighbour, opposite( faceDir ) );
+    }
+
+    bool FaultIndex::hasFault( size_t globalIndex, FaceDir::DirEnum faceDir ) const {
+        return this->getFault( globalIndex, faceDir ) >= 0;
+    }
+
+}
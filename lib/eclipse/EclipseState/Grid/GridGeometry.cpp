@@ -0,0 +1,257 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+
+namespace Opm {
+
+namespace {
+
+    using point = std::array< double, 3 >;
+
+    /* The two point Gauss-Legendre rule on [0,1]. */
+    const double gauss_points[ 2 ] = { 0.5 - 0.5 / std::sqrt( 3.0 ),
+                                       0.5 + 0.5 / std::sqrt( 3.0 ) };
+
+    void axpy( double a, const point& p, const point& q, point& result ) {
+        for( int d = 0; d < 3; d++ )
+            result[ d ] += a * ( q[ d ] - p[ d ] );
+    }
+
+    double horizontal_distance( const point& p, const point& q ) {
+        return std::hypot( q[ 0 ] - p[ 0 ], q[ 1 ] - p[ 1 ] );
+    }
+
+}
+
+    GridGeometry::GridGeometry( size_t nx, size_t ny, size_t nz,
+                                const double* coord,
+                                const double* zcorn ) :
+        GridDims( nx, ny, nz )
+    {
+        this->compute( [=]( size_t i, size_t j, size_t k, corners& cell ) {
+            cellCorners( nx, ny, coord, zcorn, i, j, k, cell );
+        } );
+    }
+
+    GridGeometry::GridGeometry( const GridDims& dims,
+                                const std::vector< double >& coord,
+                                const std::vector< double >& zcorn ) :
+        GridDims( dims.getNX(), dims.getNY(), dims.getNZ() )
+    {
+        const size_t coord_size = 6 * ( this->m_nx + 1 ) * ( this->m_ny + 1 );
+        const size_t zcorn_size = 8 * this->getCartesianSize();
+
+        if( coord.size() != coord_size )
+            throw std::invalid_argument( "Wrong size of COORD: expected " + std::to_string( coord_size )
+                                         + " got " + std::to_string( coord.size() ) );
+
+        if( zcorn.size() != zcorn_size )
+            throw std::invalid_argument( "Wrong size of ZCORN: expected " + std::to_string( zcorn_size )
+                                         + " got " + std::to_string( zcorn.size() ) );
+
+        const size_t nx = this->m_nx;
+        const size_t ny = this->m_ny;
+        const double* coord_data = coord.data();
+        const double* zcorn_data = zcorn.data();
+        this->compute( [=]( size_t i, size_t j, size_t k, corners& cell ) {
+            cellCorners( nx, ny, coord_data, zcorn_data, i, j, k, cell );
+        } );
+    }
+
+    GridGeometry::GridGeometry( const GridDims& dims,
+                                const CornerFunction& cellCorners ) :
+        GridDims( dims.getNX(), dims.getNY(), dims.getNZ() )
+    {
+        const size_t nx = this->m_nx;
+        const size_t ny = this->m_ny;
+        this->compute( [&cellCorners, nx, ny]( size_t i, size_t j, size_t k, corners& cell ) {
+            cellCorners( i + nx * ( j + ny * k ), cell );
+        } );
+    }
+
+
+    void GridGeometry::cellCorners( size_t nx, size_t ny,
+                                    const double* coord,
+                                    const double* zcorn,
+                                    size_t i, size_t j, size_t k,
+                                    std::array< point, 8 >& corners ) {
+        const size_t zcorn_base = 2*i + 4*nx*j + 8*nx*ny*k;
+        const size_t zcorn_shift[ 8 ] = { 0, 1, 2*nx, 2*nx + 1,
+                                          4*nx*ny, 4*nx*ny + 1, 4*nx*ny + 2*nx, 4*nx*ny + 2*nx + 1 };
+
+        for( size_t c = 0; c < 8; c++ ) {
+            const size_t pi = i + ( c & 1 );
+            const size_t pj = j + ( ( c >> 1 ) & 1 );
+            const double* pillar = coord + 6 * ( pi + pj * ( nx + 1 ) );
+            const double z = zcorn[ zcorn_base + zcorn_shift[ c ] ];
+            const double dz = pillar[ 5 ] - pillar[ 2 ];
+
+            auto& corner = corners[ c ];
+            corner[ 2 ] = z;
+            if( std::fabs( dz ) < 1e-12 ) {
+                corner[ 0 ] = pillar[ 0 ];
+                corner[ 1 ] = pillar[ 1 ];
+            } else {
+                const double t = ( z - pillar[ 2 ] ) / dz;
+                corner[ 0 ] = pillar[ 0 ] + t * ( pillar[ 3 ] - pillar[ 0 ] );
+                corner[ 1 ] = pillar[ 1 ] + t * ( pillar[ 4 ] - pillar[ 1 ] );
+            }
+        }
+    }
+
+
+    /*
+      The determinant of the Jacobian of the trilinear map from the unit
+      cube to the cell is a polynomial of degree at most two in each of
+      the reference coordinates, hence the 2x2x2 point Gauss rule gives
+      the exact volume.
+    */
+    double GridGeometry::cellVolume( const std::array< point, 8 >& p ) {
+        double volume = 0;
+
+        for( const double s : gauss_points ) {
+            for( const double t : gauss_points ) {
+                for( const double u : gauss_points ) {
+                    point ds = {{ 0, 0, 0 }};
+                    point dt = {{ 0, 0, 0 }};
+                    point du = {{ 0, 0, 0 }};
+
+                    axpy( ( 1 - t ) * ( 1 - u ), p[ 0 ], p[ 1 ], ds );
+                    axpy( t * ( 1 - u ),         p[ 2 ], p[ 3 ], ds );
+                    axpy( ( 1 - t ) * u,         p[ 4 ], p[ 5 ], ds );
+                    axpy( t * u,                 p[ 6 ], p[ 7 ], ds );
+
+                    axpy( ( 1 - s ) * ( 1 - u ), p[ 0 ], p[ 2 ], dt );
+                    axpy( s * ( 1 - u ),         p[ 1 ], p[ 3 ], dt );
+                    axpy( ( 1 - s ) * u,         p[ 4 ], p[ 6 ], dt );
+                    axpy( s * u,                 p[ 5 ], p[ 7 ], dt );
+
+                    axpy( ( 1 - s ) * ( 1 - t ), p[ 0 ], p[ 4 ], du );
+                    axpy( s * ( 1 - t ),         p[ 1 ], p[ 5 ], du );
+                    axpy( ( 1 - s ) * t,         p[ 2 ], p[ 6 ], du );
+                    axpy( s * t,                 p[ 3 ], p[ 7 ], du );
+
+                    volume += ds[ 0 ] * ( dt[ 1 ] * du[ 2 ] - dt[ 2 ] * du[ 1 ] )
+                            - ds[ 1 ] * ( dt[ 0 ] * du[ 2 ] - dt[ 2 ] * du[ 0 ] )
+                            + ds[ 2 ] * ( dt[ 0 ] * du[ 1 ] - dt[ 1 ] * du[ 0 ] );
+                }
+            }
+        }
+
+        return std::fabs( volume ) / 8;
+    }
+
+
+    /*
+      The cell corners are given by cellCorners( i, j, k, corners ), which
+      is inlined for the grids with COORD and ZCORN arrays.
+    */
+    template< typename F >
+    void GridGeometry::compute( const F& cellCorners ) {
+        const size_t nx = this->m_nx;
+        const size_t ny = this->m_ny;
+        const size_t size = this->getCartesianSize();
+
+        this->m_volume.resize( size );
+        this->m_center_x.resize( size );
+        this->m_center_y.resize( size );
+        this->m_depth.resize( size );
+        this->m_thickness.resize( size );
+        this->m_dx.resize( size );
+        this->m_dy.resize( size );
+
+        #pragma omp parallel for schedule(static)
+        for( size_t g = 0; g < size; g++ ) {
+            const size_t i = g % nx;
+            const size_t j = ( g / nx ) % ny;
+            const size_t k = g / ( nx * ny );
+
+            std::array< point, 8 > p;
+            cellCorners( i, j, k, p );
+
+            point center = {{ 0, 0, 0 }};
+            for( const auto& corner : p )
+                for( int d = 0; d < 3; d++ )
+                    center[ d ] += corner[ d ] / 8;
+
+            double thickness = 0;
+            for( int c = 0; c < 4; c++ )
+                thickness += ( p[ c + 4 ][ 2 ] - p[ c ][ 2 ] ) / 4;
+
+            const double dx = ( horizontal_distance( p[ 0 ], p[ 1 ] ) + horizontal_distance( p[ 2 ], p[ 3 ] )
+                              + horizontal_distance( p[ 4 ], p[ 5 ] ) + horizontal_distance( p[ 6 ], p[ 7 ] ) ) / 4;
+            const double dy = ( horizontal_distance( p[ 0 ], p[ 2 ] ) + horizontal_distance( p[ 1 ], p[ 3 ] )
+                              + horizontal_distance( p[ 4 ], p[ 6 ] ) + horizontal_distance( p[ 5 ], p[ 7 ] ) ) / 4;
+
+            this->m_volume[ g ] = cellVolume( p );
+            this->m_center_x[ g ] = center[ 0 ];
+            this->m_center_y[ g ] = center[ 1 ];
+            this->m_depth[ g ] = center[ 2 ];
+            this->m_thickness[ g ] = thickness;
+            this->m_dx[ g ] = dx;
+            this->m_dy[ g ] = dy;
+        }
+    }
+
+
+    const std::vector< double >& GridGeometry::volume() const {
+        return this->m_volume;
+    }
+
+    const std::vector< double >& GridGeometry::centerX() const {
+        return this->m_center_x;
+    }
+
+    const std::vector< double >& GridGeometry::centerY() const {
+        return this->m_center_y;
+    }
+
+    const std::vector< double >& GridGeometry::depth() const {
+        return this->m_depth;
+    }
+
+    const std::vector< double >& GridGeometry::thickness() const {
+        return this->m_thickness;
+    }
+
+    const std::vector< double >& GridGeometry::dx() const {
+        return this->m_dx;
+    }
+
+    const std::vector< double >& GridGeometry::dy() const {
+        return this->m_dy;
+    }
+
+    std::array< double, 3 > GridGeometry::center( size_t globalIndex ) const {
+        return {{ this->m_center_x[ globalIndex ],
+                  this->m_center_y[ globalIndex ],
+                  this->m_depth[ globalIndex ] }};
+    }
+
+    std::array< double, 3 > GridGeometry::cellDims( size_t globalIndex ) const {
+        return {{ this->m_dx[ globalIndex ],
+                  this->m_dy[ globalIndex ],
+                  this->m_thickness[ globalIndex ] }};
+    }
+}
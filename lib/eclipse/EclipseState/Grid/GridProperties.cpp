@@ -21,6 +21,7 @@
 
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
 #include <opm/parser/eclipse/Utility/String.hpp>
 
 namespace Opm {
@@ -76,6 +77,95 @@ namespace Opm {
 
 
 
+    template< typename T >
+    GridProperties<T>::GridProperties(const GridProperties& other) {
+        *this = other;
+    }
+
+
+    /*
+      The copy keeps its own mutex; Eclipse3DProperties shares the mutex
+      of the copied containers again.
+    */
+    template< typename T >
+    GridProperties<T>& GridProperties<T>::operator=(const GridProperties& other) {
+        if (this == &other)
+            return *this;
+
+        std::lock_guard< std::recursive_mutex > lock( other.mutex() );
+        this->nx = other.nx;
+        this->ny = other.ny;
+        this->nz = other.nz;
+        this->m_deckUnitSystem = other.m_deckUnitSystem;
+        this->m_messages = other.m_messages;
+        this->m_supportedKeywords = other.m_supportedKeywords;
+        this->m_properties = other.m_properties;
+        this->m_autoGeneratedProperties = other.m_autoGeneratedProperties;
+        this->m_finalized = other.m_finalized;
+        return *this;
+    }
+
+
+    template< typename T >
+    GridProperties<T>::GridProperties(GridProperties&& other) {
+        *this = std::move( other );
+    }
+
+
+    /*
+      The maps are moved, and the mutex is shared with the moved from
+      container, so that the containers of a moved Eclipse3DProperties
+      still share one mutex. The moved from container is left empty but
+      can still be used.
+    */
+    template< typename T >
+    GridProperties<T>& GridProperties<T>::operator=(GridProperties&& other) {
+        if (this == &other)
+            return *this;
+
+        this->nx = other.nx;
+        this->ny = other.ny;
+        this->nz = other.nz;
+        this->m_deckUnitSystem = other.m_deckUnitSystem;
+        this->m_messages = std::move( other.m_messages );
+        this->m_supportedKeywords = std::move( other.m_supportedKeywords );
+        this->m_properties = std::move( other.m_properties );
+        this->m_autoGeneratedProperties = std::move( other.m_autoGeneratedProperties );
+        this->m_finalized = other.m_finalized;
+        this->m_mutex = other.m_mutex;
+        return *this;
+    }
+
+
+    template< typename T >
+    void GridProperties<T>::serialize(BinaryWriter& writer) const {
+        std::lock_guard< std::recursive_mutex > lock( this->mutex() );
+        writer.write( uint64_t( m_properties.size() ) );
+        for (const auto& pair : m_properties) {
+            writer.write( pair.first );
+            writer.write( uint8_t( isAutoGenerated_( pair.first ) ) );
+            writer.writeArray( pair.second.getData() );
+        }
+    }
+
+
+    template< typename T >
+    void GridProperties<T>::deserialize(BinaryReader& reader) {
+        std::lock_guard< std::recursive_mutex > lock( this->mutex() );
+        const auto size = reader.read< uint64_t >();
+        for (uint64_t i = 0; i < size; i++) {
+            const auto keyword = reader.readString();
+            if (reader.read< uint8_t >())
+                addAutoGeneratedKeyword_( keyword );
+            else
+                addKeyword( keyword );
+
+            const auto data = reader.readView< T >();
+            m_properties.at( keyword ).assignProcessed( data.data, data.size );
+        }
+    }
+
+
     /*
       In the case of integer properties we never really do any
       transformation, but we have implemented this dummy int
@@ -125,12 +215,14 @@ namespace Opm {
     template< typename T >
     bool GridProperties<T>::supportsKeyword(const std::string& keyword) const {
         const std::string kw = normalize(keyword);
+        std::lock_guard< std::recursive_mutex > lock( this->mutex() );
         return m_supportedKeywords.count( kw ) > 0 || isFipxxx<T>(kw);
     }
 
     template< typename T >
     bool GridProperties<T>::hasKeyword(const std::string& keyword) const {
         const std::string kw = normalize( keyword );
+        std::lock_guard< std::recursive_mutex > lock( this->mutex() );
 
         const auto cnt = m_properties.count( kw );
         const bool positive = cnt > 0;
@@ -141,6 +233,7 @@ namespace Opm {
     template< typename T >
     bool GridProperties<T>::hasDeckKeyword(const std::string& keyword) const {
         const std::string kw = normalize( keyword );
+        std::lock_guard< std::recursive_mutex > lock( this->mutex() );
 
         const auto cnt = m_properties.count( kw );
         const bool positive = cnt > 0;
@@ -152,6 +245,7 @@ namespace Opm {
 
     template< typename T >
     size_t GridProperties<T>::size() const {
+        std::lock_guard< std::recursive_mutex > lock( this->mutex() );
         return m_properties.size();
     }
 
@@ -159,6 +253,7 @@ namespace Opm {
     template< typename T >
     void GridProperties<T>::assertKeyword(const std::string& keyword) const {
         const std::string kw = normalize(keyword);
+        std::lock_guard< std::recursive_mutex > lock( this->mutex() );
         if (m_properties.count( kw ) == 0)
             addAutoGeneratedKeyword_(kw);
 
@@ -169,8 +264,26 @@ namespace Opm {
 
     template< typename T >
     const GridProperty<T>& GridProperties<T>::getKeyword(const std::string& keyword) const {
-        assertKeyword( keyword );
-        return m_properties.at( keyword );
+        const std::string kw = normalize(keyword);
+        std::lock_guard< std::recursive_mutex > lock( this->mutex() );
+
+        if (m_finalized && m_properties.count( kw ) == 0) {
+            if (supportsKeyword(kw))
+                throw std::invalid_argument("Keyword: " + kw + " is supported - but was not created before finalize().");
+            else
+                throw std::invalid_argument("Keyword: " + kw + " is not supported.");
+        }
+
+        return getOrCreateKeyword( kw );
+    }
+
+
+    template< typename T >
+    const GridProperty<T>& GridProperties<T>::getOrCreateKeyword(const std::string& keyword) const {
+        const std::string kw = normalize(keyword);
+        std::lock_guard< std::recursive_mutex > lock( this->mutex() );
+        assertKeyword( kw );
+        return m_properties.at( kw );
     }
 
 
@@ -178,6 +291,7 @@ namespace Opm {
     template< typename T >
     const GridProperty<T>& GridProperties<T>::getDeckKeyword(const std::string& keyword) const {
         const std::string kw = normalize(keyword);
+        std::lock_guard< std::recursive_mutex > lock( this->mutex() );
 
         if (hasDeckKeyword(kw))
             return m_properties.at( kw );
@@ -570,6 +684,11 @@ namespace Opm {
         return m_autoGeneratedProperties.count(keyword) > 0;
     }
 
+    template< typename T >
+    std::recursive_mutex& GridProperties<T>::mutex() const {
+        return *this->m_mutex;
+    }
+
 }
 
 
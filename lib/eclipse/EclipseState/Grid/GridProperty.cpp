@@ -30,6 +30,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/RtempvdTable.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
 
 namespace Opm {
 
@@ -365,9 +366,22 @@ namespace Opm {
     void GridProperty< T >::runPostProcessor() {
         if( this->m_hasRunPostProcessor ) return;
         this->m_hasRunPostProcessor = true;
+
+        Trace::Span span( this->getKeywordName(), "postprocessor" );
         this->m_kwInfo.postProcessor()( m_data );
     }
 
+    template< typename T >
+    void GridProperty< T >::assignProcessed( const T* data, size_t size ) {
+        if( size != m_data.size() )
+            throw std::invalid_argument("Size mismatch when assigning data for:" + getKeywordName()
+                                        + " input size: " + std::to_string( size )
+                                        + " property size: " + std::to_string( m_data.size()) );
+
+        m_data.assign( data, data + size );
+        m_hasRunPostProcessor = true;
+    }
+
     template< typename T >
     void GridProperty< T >::checkLimits( T min, T max ) const {
         for (size_t g=0; g < m_data.size(); g++) {
@@ -490,16 +504,16 @@ std::vector< double > temperature_lookup( size_t size,
                                           const GridProperties<int>* ig_props ) {
 
     if (tables->hasTables("RTEMPVD")) {
-        const std::vector< int >& eqlNum = ig_props->getKeyword("EQLNUM").getData();
+        const std::vector< int >& eqlNum = ig_props->getOrCreateKeyword("EQLNUM").getData();
 
         const auto& rtempvdTables = tables->getRtempvdTables();
+        const auto& cellDepths = grid->getCellDepths();
         std::vector< double > values( size, 0 );
 
         for (size_t cellIdx = 0; cellIdx < eqlNum.size(); ++ cellIdx) {
             int cellEquilRegionIdx = eqlNum[cellIdx] - 1; // EQLNUM contains fortran-style indices!
             const RtempvdTable& rtempvdTable = rtempvdTables.getTable<RtempvdTable>(cellEquilRegionIdx);
-            double cellDepth = std::get<2>(grid->getCellCenter(cellIdx));
-            values[cellIdx] = rtempvdTable.evaluate("Temperature", cellDepth);
+            values[cellIdx] = rtempvdTable.evaluate("Temperature", cellDepths[cellIdx]);
         }
 
         return values;
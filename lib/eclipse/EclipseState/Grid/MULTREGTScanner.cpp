@@ -17,6 +17,8 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <cstdlib>
 #include <stdexcept>
 #include <map>
 #include <set>
@@ -28,6 +30,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
 
 namespace Opm {
 
@@ -129,7 +132,11 @@ namespace Opm {
     */
     MULTREGTScanner::MULTREGTScanner(const Eclipse3DProperties& e3DProps,
                                      const std::vector< const DeckKeyword* >& keywords) :
-                m_e3DProps(e3DProps) {
+        m_nx( 0 ),
+        m_ny( 0 ),
+        m_size( 0 )
+    {
+        Trace::Span span( "MULTREGTScanner", "state" );
 
         for (size_t idx = 0; idx < keywords.size(); idx++)
             this->addKeyword(*keywords[idx] , e3DProps.getDefaultRegionKeyword());
@@ -153,14 +160,70 @@ namespace Opm {
                               + " which is not in the deck");
         }
 
+        std::map<std::string , MULTREGTSearchMap> searchMap;
         for (auto iter = searchPairs.begin(); iter != searchPairs.end(); ++iter) {
             const MULTREGTRecord * record = (*iter).second;
             std::pair<int,int> pair = (*iter).first;
             const std::string& keyword = record->m_region.getValue();
-            if (m_searchMap.count(keyword) == 0)
-                m_searchMap[keyword] = MULTREGTSearchMap();
+            searchMap[keyword][pair] = record;
+        }
+
+        /*
+          The tables are searched in the order of the region keywords,
+          i.e. FLUXNUM before MULTNUM before OPERNUM.
+        */
+        for (const auto& keywordMap : searchMap) {
+            const auto& region = e3DProps.getIntGridProperty( keywordMap.first );
+            const auto& data = region.getData();
+
+            this->m_nx = region.getNX();
+            this->m_ny = region.getNY();
+            this->m_size = data.size();
+
+            std::vector< int > values;
+            for (const auto& pairRecord : keywordMap.second) {
+                values.push_back( pairRecord.first.first );
+                values.push_back( pairRecord.first.second );
+            }
+            std::sort( values.begin(), values.end() );
+            values.erase( std::unique( values.begin(), values.end() ), values.end() );
+
+            RegionTable table;
+            table.keyword = keywordMap.first;
+            table.numRegions = values.size();
+            table.cellRegion.resize( data.size() );
+
+            #pragma omp parallel for schedule(static)
+            for (size_t g = 0; g < data.size(); g++) {
+                const auto pos = std::lower_bound( values.begin(), values.end(), data[g] );
+                table.cellRegion[g] = (pos != values.end() && *pos == data[g]) ? int( pos - values.begin() ) : -1;
+            }
+
+            const auto index = [&values]( int value ) -> size_t {
+                return std::lower_bound( values.begin(), values.end(), value ) - values.begin();
+            };
+
+            const size_t n = table.numRegions;
+            if (n <= MULTREGTScanner::maxDenseRegions) {
+                table.dense.assign( n * n, Entry{ 1.0, 0, MULTREGT::ALL } );
+                for (const auto& pairRecord : keywordMap.second) {
+                    const auto* record = pairRecord.second;
+                    table.dense[ index( pairRecord.first.first ) * n + index( pairRecord.first.second ) ] =
+                        Entry{ record->m_transMultiplier, record->m_directions, record->m_nncBehaviour };
+                }
+            } else {
+                for (const auto& pairRecord : keywordMap.second) {
+                    const auto* record = pairRecord.second;
+                    table.sparse.emplace_back( index( pairRecord.first.first ) * n + index( pairRecord.first.second ),
+                                               Entry{ record->m_transMultiplier, record->m_directions, record->m_nncBehaviour } );
+                }
+                std::sort( table.sparse.begin(), table.sparse.end(),
+                           []( const std::pair< size_t, Entry >& a, const std::pair< size_t, Entry >& b ) {
+                               return a.first < b.first;
+                           } );
+            }
 
-            m_searchMap[keyword][pair] = record;
+            this->m_tables.push_back( std::move( table ) );
         }
     }
 
@@ -232,42 +295,89 @@ namespace Opm {
 
     */
     double MULTREGTScanner::getRegionMultiplier(size_t globalIndex1 , size_t globalIndex2, FaceDir::DirEnum faceDir) const {
+        if (m_tables.empty())
+            return 1;
+
+        if (globalIndex1 >= m_size || globalIndex2 >= m_size)
+            throw std::out_of_range("Invalid global index");
+
+        return this->lookup( globalIndex1, globalIndex2, faceDir );
+    }
 
-        for (auto iter = m_searchMap.begin(); iter != m_searchMap.end(); iter++) {
-            const Opm::GridProperty<int>& region = m_e3DProps.getIntGridProperty( (*iter).first );
-            MULTREGTSearchMap map = (*iter).second;
 
-            int regionId1 = region.iget(globalIndex1);
-            int regionId2 = region.iget(globalIndex2);
+    std::vector< double > MULTREGTScanner::getRegionMultipliers(const std::vector< size_t >& globalIndex1,
+                                                                const std::vector< size_t >& globalIndex2,
+                                                                const std::vector< FaceDir::DirEnum >& faceDir) const {
+        const size_t size = globalIndex1.size();
+        if (globalIndex2.size() != size || faceDir.size() != size)
+            throw std::invalid_argument("The cell and face vectors must have equal length");
+
+        std::vector< double > multipliers( size, 1.0 );
+        if (m_tables.empty())
+            return multipliers;
+
+        for (size_t i = 0; i < size; i++) {
+            if (globalIndex1[i] >= m_size || globalIndex2[i] >= m_size)
+                throw std::out_of_range("Invalid global index");
+        }
+
+        #pragma omp parallel for schedule(static)
+        for (size_t i = 0; i < size; i++)
+            multipliers[i] = this->lookup( globalIndex1[i], globalIndex2[i], faceDir[i] );
+
+        return multipliers;
+    }
+
+
+    const MULTREGTScanner::Entry* MULTREGTScanner::RegionTable::find(int region1 , int region2) const {
+        const size_t key = size_t( region1 ) * numRegions + size_t( region2 );
+        if (!dense.empty())
+            return &dense[key];
+
+        const auto pos = std::lower_bound( sparse.begin(), sparse.end(), key,
+                                           []( const std::pair< size_t, Entry >& entry, size_t k ) {
+                                               return entry.first < k;
+                                           } );
+        if (pos == sparse.end() || pos->first != key)
+            return nullptr;
+
+        return &pos->second;
+    }
+
 
+    double MULTREGTScanner::lookup(size_t globalIndex1 , size_t globalIndex2, FaceDir::DirEnum faceDir) const {
+        for (const auto& table : m_tables) {
+            const int regionId1 = table.cellRegion[globalIndex1];
+            const int regionId2 = table.cellRegion[globalIndex2];
+            if (regionId1 < 0 || regionId2 < 0)
+                continue;
 
-            std::pair<int,int> pair{regionId1 , regionId2};
-            if (map.count(pair) != 1 || !(map.at(pair)->m_directions & faceDir)) {
-                pair = std::pair<int,int>{regionId2 , regionId1};
-                if (map.count(pair) != 1 || !(map.at(pair)->m_directions & faceDir))
+            const Entry * entry = table.find( regionId1 , regionId2 );
+            if (!entry || !(entry->directions & faceDir)) {
+                entry = table.find( regionId2 , regionId1 );
+                if (!entry || !(entry->directions & faceDir))
                     continue;
             }
-            const MULTREGTRecord * record = map[pair];
 
             bool applyMultiplier = true;
-            int i1 = globalIndex1 % region.getNX();
-            int i2 = globalIndex2 % region.getNX();
-            int j1 = globalIndex1 / region.getNX() % region.getNY();
-            int j2 = globalIndex2 / region.getNX() % region.getNY();
+            int i1 = globalIndex1 % m_nx;
+            int i2 = globalIndex2 % m_nx;
+            int j1 = globalIndex1 / m_nx % m_ny;
+            int j2 = globalIndex2 / m_nx % m_ny;
 
-            if (record->m_nncBehaviour == MULTREGT::NNC){
+            if (entry->nncBehaviour == MULTREGT::NNC){
                 applyMultiplier = true;
                 if ((std::abs(i1-i2) == 0 && std::abs(j1-j2) == 1) || (std::abs(i1-i2) == 1 && std::abs(j1-j2) == 0))
                     applyMultiplier = false;
             }
-            else if (record->m_nncBehaviour == MULTREGT::NONNC){
+            else if (entry->nncBehaviour == MULTREGT::NONNC){
                 applyMultiplier = false;
                 if ((std::abs(i1-i2) == 0 && std::abs(j1-j2) == 1) || (std::abs(i1-i2) == 1 && std::abs(j1-j2) == 0))
                     applyMultiplier = true;
             }
 
             if (applyMultiplier) {
-                return record->m_transMultiplier;
+                return entry->multiplier;
             }
 
         }
@@ -16,7 +16,8 @@
   You should have received a copy of the GNU General Public License
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
 */
-#include <array>
+
+#include <stdexcept>
 
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckItem.hpp>
@@ -26,6 +27,7 @@
 #include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeywords/N.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
 
 
 namespace Opm
@@ -33,27 +35,55 @@ namespace Opm
     NNC::NNC(const Deck& deck) {
         GridDims gridDims(deck);
         const auto& nncs = deck.getKeywordList<ParserKeywords::NNC>();
-        for (size_t idx_nnc = 0; idx_nnc<nncs.size(); ++idx_nnc) {
-            const auto& nnc = *nncs[idx_nnc];
-            for (size_t i = 0; i < nnc.size(); ++i) {
-                std::array<size_t, 3> ijk1;
-                ijk1[0] = static_cast<size_t>(nnc.getRecord(i).getItem(0).get< int >(0)-1);
-                ijk1[1] = static_cast<size_t>(nnc.getRecord(i).getItem(1).get< int >(0)-1);
-                ijk1[2] = static_cast<size_t>(nnc.getRecord(i).getItem(2).get< int >(0)-1);
-                size_t global_index1 = gridDims.getGlobalIndex(ijk1[0],ijk1[1],ijk1[2]);
-                
-                std::array<size_t, 3> ijk2;
-                ijk2[0] = static_cast<size_t>(nnc.getRecord(i).getItem(3).get< int >(0)-1);
-                ijk2[1] = static_cast<size_t>(nnc.getRecord(i).getItem(4).get< int >(0)-1);
-                ijk2[2] = static_cast<size_t>(nnc.getRecord(i).getItem(5).get< int >(0)-1);
-                size_t global_index2 = gridDims.getGlobalIndex(ijk2[0],ijk2[1],ijk2[2]);
-                
-                const double trans = nnc.getRecord(i).getItem(6).getSIDouble(0);
-                
+
+        size_t size = 0;
+        for (const auto* nnc : nncs)
+            size += nnc->size();
+        m_nnc.reserve(size);
+
+        /* The records are read in place, one item at a time. */
+        for (const auto* nnc : nncs) {
+            for (const auto& record : *nnc) {
+                size_t global_index1 = gridDims.getGlobalIndex(static_cast<size_t>(record.getItem(0).get< int >(0)-1),
+                                                               static_cast<size_t>(record.getItem(1).get< int >(0)-1),
+                                                               static_cast<size_t>(record.getItem(2).get< int >(0)-1));
+
+                size_t global_index2 = gridDims.getGlobalIndex(static_cast<size_t>(record.getItem(3).get< int >(0)-1),
+                                                               static_cast<size_t>(record.getItem(4).get< int >(0)-1),
+                                                               static_cast<size_t>(record.getItem(5).get< int >(0)-1));
+
+                const double trans = record.getItem(6).getSIDouble(0);
+
                 addNNC(global_index1,global_index2,trans);
             }
         }
     }
+    NNC::NNC(BinaryReader& reader) {
+        const auto cell1 = reader.readView< uint64_t >();
+        const auto cell2 = reader.readView< uint64_t >();
+        const auto trans = reader.readView< double >();
+        if (cell2.size != cell1.size || trans.size != cell1.size)
+            throw std::runtime_error("The serialized NNC arrays differ in size");
+
+        m_nnc.reserve(cell1.size);
+        for (size_t i = 0; i < cell1.size; i++)
+            addNNC(cell1.data[i], cell2.data[i], trans.data[i]);
+    }
+
+    void NNC::serialize(BinaryWriter& writer) const {
+        std::vector< uint64_t > cell1, cell2;
+        std::vector< double > trans;
+        for (const auto& nnc : m_nnc) {
+            cell1.push_back(nnc.cell1);
+            cell2.push_back(nnc.cell2);
+            trans.push_back(nnc.trans);
+        }
+
+        writer.writeArray(cell1);
+        writer.writeArray(cell2);
+        writer.writeArray(trans);
+    }
+
     void NNC::addNNC(const size_t cell1, const size_t cell2, const double trans) {
         NNCdata tmp;
         tmp.cell1 = cell1;
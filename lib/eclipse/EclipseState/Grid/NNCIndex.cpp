@@ -0,0 +1,202 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include <opm/parser/eclipse/EclipseState/Grid/NNCIndex.hpp>
+#include <opm/parser/eclipse/Utility/ParallelSort.hpp>
+
+namespace Opm {
+
+namespace {
+
+    bool connectionLess( const NNCdata& a, const NNCdata& b ) {
+        return a.cell1 < b.cell1 || ( a.cell1 == b.cell1 && a.cell2 < b.cell2 );
+    }
+
+    bool sameConnection( const NNCdata& a, const NNCdata& b ) {
+        return a.cell1 == b.cell1 && a.cell2 == b.cell2;
+    }
+
+    /* Order the cells of every connection, and sort the connections. */
+    void normalize( std::vector< NNCdata >& nncs ) {
+        #pragma omp parallel for schedule(static)
+        for( size_t i = 0; i < nncs.size(); i++ ) {
+            if( nncs[ i ].cell1 > nncs[ i ].cell2 )
+                std::swap( nncs[ i ].cell1, nncs[ i ].cell2 );
+        }
+
+        parallelStableSort( nncs.begin(), nncs.end(), connectionLess );
+    }
+
+    /* Sum the transmissibilities of adjacent equal connections. */
+    void combine( std::vector< NNCdata >& nncs ) {
+        if( nncs.empty() ) return;
+
+        size_t last = 0;
+        for( size_t i = 1; i < nncs.size(); i++ ) {
+            if( sameConnection( nncs[ last ], nncs[ i ] ) )
+                nncs[ last ].trans += nncs[ i ].trans;
+            else
+                nncs[ ++last ] = nncs[ i ];
+        }
+
+        nncs.resize( last + 1 );
+    }
+
+}
+
+    NNCIndex::Range::Range( const_iterator first, const_iterator last ) :
+        m_first( first ),
+        m_last( last )
+    {}
+
+    NNCIndex::Range::const_iterator NNCIndex::Range::begin() const {
+        return this->m_first;
+    }
+
+    NNCIndex::Range::const_iterator NNCIndex::Range::end() const {
+        return this->m_last;
+    }
+
+    size_t NNCIndex::Range::size() const {
+        return this->m_last - this->m_first;
+    }
+
+    bool NNCIndex::Range::empty() const {
+        return this->m_first == this->m_last;
+    }
+
+    NNCIndex::NNCIndex() :
+        m_offsets( 1, 0 )
+    {}
+
+    NNCIndex::NNCIndex( const NNC& nnc ) :
+        NNCIndex( nnc.nncdata() )
+    {}
+
+    NNCIndex::NNCIndex( std::vector< NNCdata > nncs ) :
+        m_connections( std::move( nncs ) )
+    {
+        normalize( this->m_connections );
+        combine( this->m_connections );
+        this->buildAdjacency();
+    }
+
+    void NNCIndex::merge( std::vector< NNCdata > nncs ) {
+        normalize( nncs );
+
+        const size_t size = this->m_connections.size();
+        this->m_connections.insert( this->m_connections.end(), nncs.begin(), nncs.end() );
+        std::inplace_merge( this->m_connections.begin(),
+                            this->m_connections.begin() + size,
+                            this->m_connections.end(),
+                            connectionLess );
+
+        combine( this->m_connections );
+        this->buildAdjacency();
+    }
+
+    void NNCIndex::buildAdjacency() {
+        const auto& nncs = this->m_connections;
+
+        std::vector< size_t > cells;
+        cells.reserve( 2 * nncs.size() );
+        for( const auto& nnc : nncs ) {
+            cells.push_back( nnc.cell1 );
+            cells.push_back( nnc.cell2 );
+        }
+        parallelStableSort( cells.begin(), cells.end(), std::less< size_t >() );
+        cells.erase( std::unique( cells.begin(), cells.end() ), cells.end() );
+
+        const auto row = [&cells]( size_t cell ) -> size_t {
+            return std::lower_bound( cells.begin(), cells.end(), cell ) - cells.begin();
+        };
+
+        std::vector< size_t > offsets( cells.size() + 1, 0 );
+        for( const auto& nnc : nncs ) {
+            offsets[ row( nnc.cell1 ) + 1 ]++;
+            if( nnc.cell2 != nnc.cell1 )
+                offsets[ row( nnc.cell2 ) + 1 ]++;
+        }
+        for( size_t r = 0; r < cells.size(); r++ )
+            offsets[ r + 1 ] += offsets[ r ];
+
+        std::vector< size_t > adjacency( offsets.back() );
+        std::vector< size_t > cursor( offsets.begin(), offsets.end() - 1 );
+        for( size_t index = 0; index < nncs.size(); index++ ) {
+            adjacency[ cursor[ row( nncs[ index ].cell1 ) ]++ ] = index;
+            if( nncs[ index ].cell2 != nncs[ index ].cell1 )
+                adjacency[ cursor[ row( nncs[ index ].cell2 ) ]++ ] = index;
+        }
+
+        this->m_cells = std::move( cells );
+        this->m_offsets = std::move( offsets );
+        this->m_adjacency = std::move( adjacency );
+    }
+
+    size_t NNCIndex::size() const {
+        return this->m_connections.size();
+    }
+
+    const std::vector< NNCdata >& NNCIndex::connections() const {
+        return this->m_connections;
+    }
+
+    const NNCdata* NNCIndex::find( size_t cell1, size_t cell2 ) const {
+        const NNCdata key{ std::min( cell1, cell2 ), std::max( cell1, cell2 ), 0 };
+        const auto pos = std::lower_bound( this->m_connections.begin(), this->m_connections.end(),
+                                           key, connectionLess );
+
+        if( pos == this->m_connections.end() || !sameConnection( *pos, key ) )
+            return nullptr;
+
+        return &*pos;
+    }
+
+    bool NNCIndex::hasConnection( size_t cell1, size_t cell2 ) const {
+        return this->find( cell1, cell2 ) != nullptr;
+    }
+
+    NNCIndex::Range NNCIndex::cellConnections( size_t cell ) const {
+        const auto pos = std::lower_bound( this->m_cells.begin(), this->m_cells.end(), cell );
+        if( pos == this->m_cells.end() || *pos != cell )
+            return Range( this->m_adjacency.end(), this->m_adjacency.end() );
+
+        const size_t r = pos - this->m_cells.begin();
+        return Range( this->m_adjacency.begin() + this->m_offsets[ r ],
+                      this->m_adjacency.begin() + this->m_offsets[ r + 1 ] );
+    }
+
+    const std::vector< size_t >& NNCIndex::cells() const {
+        return this->m_cells;
+    }
+
+    const std::vector< size_t >& NNCIndex::offsets() const {
+        return this->m_offsets;
+    }
+
+    const std::vector< size_t >& NNCIndex::adjacency() const {
+        return this->m_adjacency;
+    }
+
+}
@@ -0,0 +1,247 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+#include <opm/parser/eclipse/EclipseState/Grid/ConnectionGraph.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/Partition.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /* The cell centers of the active cells, along x, y and z. */
+    using Centers = std::array< std::vector< double >, 3 >;
+
+    /*
+      Assign the active cells [first, last) to the ranks [rank, rank +
+      num_ranks).
+    */
+    void bisectCells( const Centers& centers,
+                      std::vector< size_t >::iterator first,
+                      std::vector< size_t >::iterator last,
+                      int rank,
+                      int num_ranks,
+                      std::vector< int >& owner ) {
+        if( num_ranks == 1 || last - first < 2 ) {
+            for( auto it = first; it != last; ++it )
+                owner[ *it ] = rank;
+            return;
+        }
+
+        size_t axis = 0;
+        double widest = -1;
+        for( size_t dim = 0; dim < 3; dim++ ) {
+            const auto& center = centers[ dim ];
+            double low = std::numeric_limits< double >::max();
+            double high = std::numeric_limits< double >::lowest();
+            for( auto it = first; it != last; ++it ) {
+                const double c = center[ *it ];
+                low = std::min( low, c );
+                high = std::max( high, c );
+            }
+
+            if( high - low > widest ) {
+                widest = high - low;
+                axis = dim;
+            }
+        }
+
+        const int lower_ranks = num_ranks / 2;
+        const auto cut = first + ( last - first ) * lower_ranks / num_ranks;
+        const auto& center = centers[ axis ];
+
+        /* Ties are broken on the active index to make the split deterministic. */
+        std::nth_element( first, cut, last, [&]( size_t a, size_t b ) {
+            return center[ a ] < center[ b ] || ( center[ a ] == center[ b ] && a < b );
+        } );
+
+        bisectCells( centers, first, cut, rank, lower_ranks, owner );
+        bisectCells( centers, cut, last, rank + lower_ranks, num_ranks - lower_ranks, owner );
+    }
+
+}
+
+    Partition::Partition( const EclipseGrid& grid,
+                          const ConnectionGraph& graph,
+                          const std::vector< int >& owner,
+                          int rank ) :
+        m_rank( rank ),
+        m_cartesian_size( grid.getCartesianSize() ),
+        m_num_active( grid.getNumActive() )
+    {
+        if( owner.size() != this->m_num_active || graph.numCells() != this->m_num_active )
+            throw std::invalid_argument( "The partition must have one rank per active cell" );
+
+        const auto& graph_offsets = graph.offsets();
+        const auto& graph_neighbours = graph.neighbours();
+        const auto& graph_faces = graph.faces();
+        const auto& graph_multipliers = graph.multipliers();
+        const auto& graph_nnc_trans = graph.nncTrans();
+
+        for( size_t a = 0; a < this->m_num_active; a++ )
+            if( owner[ a ] == rank )
+                this->m_active.push_back( a );
+        this->m_num_owned = this->m_active.size();
+
+        std::vector< size_t > halo;
+        for( size_t l = 0; l < this->m_num_owned; l++ ) {
+            const size_t a = this->m_active[ l ];
+            for( size_t c = graph_offsets[ a ]; c < graph_offsets[ a + 1 ]; c++ )
+                if( owner[ graph_neighbours[ c ] ] != rank )
+                    halo.push_back( graph_neighbours[ c ] );
+        }
+        std::sort( halo.begin(), halo.end() );
+        halo.erase( std::unique( halo.begin(), halo.end() ), halo.end() );
+        this->m_active.insert( this->m_active.end(), halo.begin(), halo.end() );
+
+        std::vector< int > local( this->m_num_active, -1 );
+        this->m_global.resize( this->m_active.size() );
+        for( size_t l = 0; l < this->m_active.size(); l++ ) {
+            local[ this->m_active[ l ] ] = int( l );
+            this->m_global[ l ] = grid.getGlobalIndex( this->m_active[ l ] );
+        }
+
+        this->m_offsets.assign( this->m_num_owned + 1, 0 );
+        for( size_t l = 0; l < this->m_num_owned; l++ ) {
+            const size_t a = this->m_active[ l ];
+            this->m_offsets[ l + 1 ] = this->m_offsets[ l ] + graph_offsets[ a + 1 ] - graph_offsets[ a ];
+        }
+
+        const size_t num_connections = this->m_offsets.back();
+        this->m_neighbours.resize( num_connections );
+        this->m_faces.resize( num_connections );
+        this->m_multipliers.resize( num_connections );
+        this->m_nnc_trans.resize( num_connections );
+
+        #pragma omp parallel for schedule(static)
+        for( size_t l = 0; l < this->m_num_owned; l++ ) {
+            const size_t a = this->m_active[ l ];
+            size_t c = this->m_offsets[ l ];
+            for( size_t gc = graph_offsets[ a ]; gc < graph_offsets[ a + 1 ]; gc++, c++ ) {
+                this->m_neighbours[ c ] = local[ graph_neighbours[ gc ] ];
+                this->m_faces[ c ] = graph_faces[ gc ];
+                this->m_multipliers[ c ] = graph_multipliers[ gc ];
+                this->m_nnc_trans[ c ] = graph_nnc_trans[ gc ];
+            }
+        }
+    }
+
+    std::vector< int > Partition::bisect( const EclipseGrid& grid, int num_ranks ) {
+        if( num_ranks < 1 )
+            throw std::invalid_argument( "The number of ranks must be positive" );
+
+        const auto& geometry = grid.geometry();
+        const size_t num_active = grid.getNumActive();
+        Centers centers;
+        for( auto& center : centers )
+            center.resize( num_active );
+
+        std::vector< size_t > cells( num_active );
+
+        #pragma omp parallel for schedule(static)
+        for( size_t a = 0; a < num_active; a++ ) {
+            const size_t g = grid.getGlobalIndex( a );
+            centers[ 0 ][ a ] = geometry.centerX()[ g ];
+            centers[ 1 ][ a ] = geometry.centerY()[ g ];
+            centers[ 2 ][ a ] = geometry.depth()[ g ];
+            cells[ a ] = a;
+        }
+
+        std::vector< int > owner( num_active, 0 );
+        bisectCells( centers, cells.begin(), cells.end(), 0, num_ranks, owner );
+        return owner;
+    }
+
+    int Partition::rank() const {
+        return this->m_rank;
+    }
+
+    size_t Partition::numOwned() const {
+        return this->m_num_owned;
+    }
+
+    size_t Partition::numCells() const {
+        return this->m_global.size();
+    }
+
+    bool Partition::isOwned( size_t local ) const {
+        return local < this->m_num_owned;
+    }
+
+    const std::vector< size_t >& Partition::globalIndex() const {
+        return this->m_global;
+    }
+
+    const std::vector< size_t >& Partition::activeIndex() const {
+        return this->m_active;
+    }
+
+    int Partition::localIndex( size_t g ) const {
+        const auto owned_end = this->m_global.begin() + this->m_num_owned;
+        auto it = std::lower_bound( this->m_global.begin(), owned_end, g );
+        if( it == owned_end || *it != g ) {
+            it = std::lower_bound( owned_end, this->m_global.end(), g );
+            if( it == this->m_global.end() || *it != g )
+                return -1;
+        }
+
+        return int( it - this->m_global.begin() );
+    }
+
+    const std::vector< size_t >& Partition::offsets() const {
+        return this->m_offsets;
+    }
+
+    const std::vector< int >& Partition::neighbours() const {
+        return this->m_neighbours;
+    }
+
+    const std::vector< int >& Partition::faces() const {
+        return this->m_faces;
+    }
+
+    const std::vector< double >& Partition::multipliers() const {
+        return this->m_multipliers;
+    }
+
+    const std::vector< double >& Partition::nncTrans() const {
+        return this->m_nnc_trans;
+    }
+
+    std::vector< NNCdata > Partition::nncs( const NNC& nnc ) const {
+        const auto owned = [this]( size_t g ) {
+            const int l = this->localIndex( g );
+            return l >= 0 && this->isOwned( l );
+        };
+
+        std::vector< NNCdata > local;
+        for( const auto& data : nnc.nncdata() )
+            if( owned( data.cell1 ) || owned( data.cell2 ) )
+                local.push_back( data );
+
+        return local;
+    }
+
+}
@@ -0,0 +1,187 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/PinchProcessor.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /* The state of a cell after MINPV and PINCH. */
+    enum CellStatus : char {
+        ACTIVE = 0,
+        INACTIVE = 1,
+        REMOVED = 2
+    };
+
+    struct Settings {
+        size_t nx, ny, nz;
+        bool pinch;
+        double threshold;
+        bool gap;
+        double max_gap;
+        bool top_multz;
+    };
+
+    /*
+      Walk the column (i,j) from the top and call add( upper, lower,
+      multz ) for every pinch-out connection.
+    */
+    template< typename Add >
+    void connectColumn( const Settings& settings,
+                        const std::vector< char >& status,
+                        const std::vector< double >& thickness,
+                        const std::vector< double >& multz,
+                        size_t column,
+                        Add add ) {
+        const size_t layer = settings.nx * settings.ny;
+        const auto multzOf = [&multz]( size_t g ) { return multz.empty() ? 1.0 : multz[ g ]; };
+
+        bool have_upper = false;
+        size_t upper = 0;
+        size_t gap_cells = 0;
+        bool gap_ok = true;
+        double gap_thickness = 0;
+        double gap_multz = 1;
+
+        for( size_t k = 0; k < settings.nz; k++ ) {
+            const size_t g = column + k * layer;
+
+            if( status[ g ] == ACTIVE ) {
+                if( have_upper && gap_cells > 0 && gap_ok && gap_thickness <= settings.max_gap )
+                    add( upper, g, settings.top_multz ? multzOf( upper ) : gap_multz );
+
+                have_upper = true;
+                upper = g;
+                gap_cells = 0;
+                gap_ok = true;
+                gap_thickness = 0;
+                gap_multz = multzOf( g );
+                continue;
+            }
+
+            gap_cells++;
+            gap_thickness += thickness[ g ];
+            gap_multz = std::min( gap_multz, multzOf( g ) );
+            if( status[ g ] == INACTIVE && !settings.gap && thickness[ g ] >= settings.threshold )
+                gap_ok = false;
+        }
+    }
+
+}
+
+    PinchProcessor::PinchProcessor( const EclipseGrid& grid,
+                                    const std::vector< double >& porv,
+                                    const std::vector< double >& multz ) :
+        m_removed( 0 )
+    {
+        const size_t size = grid.getCartesianSize();
+        if( porv.size() != size )
+            throw std::invalid_argument( "The pore volume must have one value per cell" );
+
+        if( !multz.empty() && multz.size() != size )
+            throw std::invalid_argument( "MULTZ must have one value per cell" );
+
+        const Settings settings{ grid.getNX(), grid.getNY(), grid.getNZ(),
+                                 grid.isPinchActive(),
+                                 grid.isPinchActive() ? grid.getPinchThresholdThickness() : 0.0,
+                                 grid.getPinchGapMode(),
+                                 grid.getPinchMaxEmptyGap(),
+                                 grid.getMultzOption() != PinchMode::ModeEnum::ALL };
+
+        const bool minpv = grid.getMinpvMode() != MinpvMode::ModeEnum::Inactive;
+        const double minpv_value = grid.getMinpvValue();
+        const auto& thickness = grid.geometry().thickness();
+
+        std::vector< char > status( size );
+        this->m_actnum.resize( size );
+        size_t removed = 0;
+
+        #pragma omp parallel for schedule(static) reduction(+:removed)
+        for( size_t g = 0; g < size; g++ ) {
+            char cell = grid.cellActive( g ) ? ACTIVE : INACTIVE;
+            if( cell == ACTIVE && minpv && porv[ g ] < minpv_value )
+                cell = REMOVED;
+            if( cell == ACTIVE && settings.pinch && thickness[ g ] < settings.threshold )
+                cell = REMOVED;
+
+            status[ g ] = cell;
+            this->m_actnum[ g ] = cell == ACTIVE ? 1 : 0;
+            if( cell == REMOVED )
+                removed++;
+        }
+        this->m_removed = removed;
+
+        if( !settings.pinch )
+            return;
+
+        const size_t num_columns = settings.nx * settings.ny;
+        std::vector< size_t > offsets( num_columns + 1, 0 );
+
+        #pragma omp parallel for schedule(static)
+        for( size_t column = 0; column < num_columns; column++ ) {
+            size_t count = 0;
+            connectColumn( settings, status, thickness, multz, column,
+                           [&count]( size_t, size_t, double ) { count++; } );
+            offsets[ column + 1 ] = count;
+        }
+
+        for( size_t column = 0; column < num_columns; column++ )
+            offsets[ column + 1 ] += offsets[ column ];
+
+        this->m_connections.resize( offsets.back() );
+
+        #pragma omp parallel for schedule(static)
+        for( size_t column = 0; column < num_columns; column++ ) {
+            size_t c = offsets[ column ];
+            connectColumn( settings, status, thickness, multz, column,
+                           [this, &c]( size_t upper, size_t lower, double mult ) {
+                               this->m_connections[ c++ ] = Connection{ upper, lower, mult };
+                           } );
+        }
+    }
+
+    const std::vector< int >& PinchProcessor::actnum() const {
+        return this->m_actnum;
+    }
+
+    size_t PinchProcessor::numRemoved() const {
+        return this->m_removed;
+    }
+
+    const std::vector< PinchProcessor::Connection >& PinchProcessor::connections() const {
+        return this->m_connections;
+    }
+
+    std::vector< NNCdata > PinchProcessor::nncs() const {
+        std::vector< NNCdata > nncs;
+        nncs.reserve( this->m_connections.size() );
+        for( const auto& connection : this->m_connections )
+            nncs.push_back( NNCdata{ connection.cell1, connection.cell2, 0.0 } );
+
+        return nncs;
+    }
+
+}
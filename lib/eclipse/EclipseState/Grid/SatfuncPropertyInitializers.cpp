@@ -690,8 +690,8 @@ namespace Opm {
         std::vector< double > values( size, 0 );
         auto tabdims = tableManager->getTabdims();
 
-        const auto& satnum = intGridProperties->getKeyword("SATNUM");
-        const auto& endnum = intGridProperties->getKeyword("ENDNUM");
+        const auto& satnum = intGridProperties->getOrCreateKeyword("SATNUM");
+        const auto& endnum = intGridProperties->getOrCreateKeyword("ENDNUM");
         int numSatTables = tabdims.getNumSatTables();
 
         satnum.checkLimits( 1 , numSatTables );
@@ -705,10 +705,11 @@ namespace Opm {
         const auto& enptvdTables = tableManager->getEnptvdTables();
 
         const auto gridsize = eclipseGrid->getCartesianSize();
+        const auto& cellDepths = eclipseGrid->getCellDepths();
         for( size_t cellIdx = 0; cellIdx < gridsize; cellIdx++ ) {
             int satTableIdx = satnum.iget( cellIdx ) - 1;
             int endNum = endnum.iget( cellIdx ) - 1;
-            double cellDepth = eclipseGrid->getCellDepth( cellIdx );
+            double cellDepth = cellDepths[ cellIdx ];
 
 
             values[cellIdx] = selectValue(enptvdTables,
@@ -732,8 +733,8 @@ namespace Opm {
 
         std::vector< double > values( size, 0 );
 
-        const auto& imbnum = intGridProperties->getKeyword("IMBNUM");
-        const auto& endnum = intGridProperties->getKeyword("ENDNUM");
+        const auto& imbnum = intGridProperties->getOrCreateKeyword("IMBNUM");
+        const auto& endnum = intGridProperties->getOrCreateKeyword("ENDNUM");
 
         auto tabdims = tableManager->getTabdims();
         const int numSatTables = tabdims.getNumSatTables();
@@ -747,10 +748,11 @@ namespace Opm {
         const bool useImptvd = tableManager->useImptvd();
         const TableContainer& imptvdTables = tableManager->getImptvdTables();
         const auto gridsize = eclipseGrid->getCartesianSize();
+        const auto& cellDepths = eclipseGrid->getCellDepths();
         for( size_t cellIdx = 0; cellIdx < gridsize; cellIdx++ ) {
             int imbTableIdx = imbnum.iget( cellIdx ) - 1;
             int endNum = endnum.iget( cellIdx ) - 1;
-            double cellDepth = eclipseGrid->getCellDepth( cellIdx );
+            double cellDepth = cellDepths[ cellIdx ];
 
             values[cellIdx] = selectValue(imptvdTables,
                                                 (useImptvd && endNum >= 0) ? endNum : -1,
@@ -18,32 +18,79 @@
 */
 
 #include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/Fault.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaultFace.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaultCollection.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaultIndex.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridProperty.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
 
 
 namespace Opm {
 
+namespace {
+
+    size_t faceIndex(FaceDir::DirEnum faceDir) {
+        switch (faceDir) {
+            case FaceDir::XPlus:  return 0;
+            case FaceDir::XMinus: return 1;
+            case FaceDir::YPlus:  return 2;
+            case FaceDir::YMinus: return 3;
+            case FaceDir::ZPlus:  return 4;
+            case FaceDir::ZMinus: return 5;
+        }
+        throw std::invalid_argument("Invalid face direction");
+    }
+
+    using FaceUpdates = std::array< std::vector< std::pair< size_t , double > > , 6 >;
+
+    void addFaultFaces(const Fault& fault, FaceUpdates& updates) {
+        double transMult = fault.getTransMult();
+
+        for( const auto& face : fault ) {
+            auto& faceUpdates = updates[ faceIndex( face.getDir() ) ];
+            for( auto globalIndex : face )
+                faceUpdates.emplace_back( globalIndex , transMult );
+        }
+    }
+
+}
+
     TransMult::TransMult(const GridDims& dims, const Deck& deck, const Eclipse3DProperties& props) :
+        TransMult( dims, deck, props, Trace::Span( "TransMult", "state" ) )
+    {}
+
+    TransMult::TransMult(const GridDims& dims, const Deck& deck, const Eclipse3DProperties& props, const Trace::Span&) :
         m_nx( dims.getNX()),
         m_ny( dims.getNY()),
         m_nz( dims.getNZ()),
-        m_names( { { FaceDir::XPlus,  "MULTX"  },
-                   { FaceDir::YPlus,  "MULTY"  },
-                   { FaceDir::ZPlus,  "MULTZ"  },
-                   { FaceDir::XMinus, "MULTX-" },
-                   { FaceDir::YMinus, "MULTY-" },
-                   { FaceDir::ZMinus, "MULTZ-" }}),
         m_multregtScanner( props, deck.getKeywordList( "MULTREGT" ))
     {
+        m_multipliers.fill( FaceMultipliers( m_nx * m_ny * m_nz ) );
+    }
+
+    void TransMult::serialize(BinaryWriter& writer) const {
+        for (const auto& multipliers : m_multipliers)
+            multipliers.serialize( writer );
+    }
+
+    void TransMult::deserialize(BinaryReader& reader) {
+        for (auto& multipliers : m_multipliers) {
+            FaceMultipliers read( reader );
+            if (read.size() != m_nx * m_ny * m_nz)
+                throw std::runtime_error("The serialized face multipliers do not match the grid");
+
+            multipliers = std::move( read );
+        }
     }
 
     void TransMult::assertIJK(size_t i , size_t j , size_t k) const {
@@ -66,10 +113,7 @@ namespace Opm {
     }
 
     double TransMult::getMultiplier__(size_t globalIndex,  FaceDir::DirEnum faceDir) const {
-        if (hasDirectionProperty( faceDir )) {
-            return m_trans.at(faceDir).iget( globalIndex );
-        } else
-            return 1.0;
+        return m_multipliers[ faceIndex( faceDir ) ][ globalIndex ];
     }
 
 
@@ -84,53 +128,47 @@ namespace Opm {
         return m_multregtScanner.getRegionMultiplier(globalCellIndex1, globalCellIndex2, faceDir);
     }
 
-    bool TransMult::hasDirectionProperty(FaceDir::DirEnum faceDir) const {
-        return m_trans.count(faceDir) == 1;
+    std::vector< double > TransMult::getRegionMultipliers(const std::vector< size_t >& globalCellIndex1,
+                                                          const std::vector< size_t >& globalCellIndex2,
+                                                          const std::vector< FaceDir::DirEnum >& faceDir) const {
+        return m_multregtScanner.getRegionMultipliers(globalCellIndex1, globalCellIndex2, faceDir);
     }
 
-    void TransMult::insertNewProperty(FaceDir::DirEnum faceDir) {
-        GridPropertySupportedKeywordInfo<double> kwInfo(m_names[faceDir] , 1.0 , "1");
-        GridProperty< double > prop( m_nx, m_ny, m_nz, kwInfo );
-        m_trans.emplace( faceDir, std::move( prop ) );
-    }
-
-
-    GridProperty<double>& TransMult::getDirectionProperty(FaceDir::DirEnum faceDir) {
-        if (m_trans.count(faceDir) == 0)
-            insertNewProperty(faceDir);
-
-        return m_trans.at( faceDir );
+    const FaceMultipliers& TransMult::getMultipliers(FaceDir::DirEnum faceDir) const {
+        return m_multipliers[ faceIndex( faceDir ) ];
     }
 
     void TransMult::applyMULT(const GridProperty<double>& srcProp, FaceDir::DirEnum faceDir)
     {
-        auto& dstProp = getDirectionProperty(faceDir);
-
-        const std::vector<double> &srcData = srcProp.getData();
-        for (size_t i = 0; i < srcData.size(); ++i)
-            dstProp.multiplyValueAtIndex(i, srcData[i]);
+        m_multipliers[ faceIndex( faceDir ) ].multiply( srcProp.getData() );
     }
 
 
     void TransMult::applyMULTFLT(const Fault& fault) {
-        double transMult = fault.getTransMult();
+        FaceUpdates updates;
+        addFaultFaces( fault , updates );
 
-        for( const auto& face : fault ) {
-            FaceDir::DirEnum faceDir = face.getDir();
-            auto& multProperty = getDirectionProperty(faceDir);
-
-
-            for( auto globalIndex : face ) {
-                multProperty.multiplyValueAtIndex( globalIndex , transMult);
-            }
-        }
+        for (size_t index = 0; index < updates.size(); index++)
+            m_multipliers[ index ].multiplyFaces( std::move( updates[ index ] ) );
     }
 
 
     void TransMult::applyMULTFLT(const FaultCollection& faults) {
-        for (size_t faultIndex = 0; faultIndex < faults.size(); faultIndex++) {
-            auto& fault = faults.getFault(faultIndex);
-            applyMULTFLT(fault);
-        }
+        applyMULTFLT( faults , FaultIndex( GridDims( m_nx , m_ny , m_nz ) , faults ) );
     }
+
+
+    void TransMult::applyMULTFLT(const FaultCollection& faults, const FaultIndex& index) {
+        std::vector< double > transMult( faults.size() );
+        for (size_t faultIndex = 0; faultIndex < faults.size(); faultIndex++)
+            transMult[ faultIndex ] = faults.getFault( faultIndex ).getTransMult();
+
+        /* The index is sorted on cell, so each direction is sorted as well. */
+        FaceUpdates updates;
+        for (const auto& face : index.faces())
+            updates[ faceIndex( face.faceDir ) ].emplace_back( face.globalIndex , transMult[ face.fault ] );
+
+        for (size_t dir = 0; dir < updates.size(); dir++)
+            m_multipliers[ dir ].multiplyFaces( std::move( updates[ dir ] ) );
     }
+}
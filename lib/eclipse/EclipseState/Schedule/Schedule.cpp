@@ -53,6 +53,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/WellProductionProperties.hpp>
 #include <opm/parser/eclipse/Units/Dimension.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
 
 namespace Opm {
 
@@ -70,6 +71,7 @@ namespace Opm {
         m_messageLimits( this->m_timeMap ),
         m_phases(phases)
     {
+        Trace::Span span( "Schedule", "state" );
         m_controlModeWHISTCTL = WellProducer::CMODE_UNDEFINED;
         addGroup( "FIELD", 0 );
 
@@ -145,6 +147,7 @@ namespace Opm {
 
         for (size_t keywordIdx = 0; keywordIdx < section.size(); ++keywordIdx) {
             const auto& keyword = section.getKeyword(keywordIdx);
+            Trace::Span span( keyword.name(), "schedule" );
 
             if (keyword.name() == "DATES") {
                 checkIfAllConnectionsIsShut(currentStep);
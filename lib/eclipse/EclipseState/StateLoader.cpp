@@ -0,0 +1,133 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/StateLoader.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Utility/TaskGraph.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /*
+      The keywords read by the TableManager which are also valid in the
+      SCHEDULE section.
+    */
+    const std::vector< std::string > schedule_table_keywords = {
+        "PLYDHFLF", "PLYSHLOG", "PLYVISC", "VFPINJ", "VFPPROD"
+    };
+
+    /*
+      Parse the deck with parse(), and build the inputs of the state
+      from the head of the deck while the rest is parsed.
+    */
+    template< typename Parse >
+    Deck parseAndBuild( Parse parse, EclipseState::Inputs& inputs ) {
+        std::vector< size_t > head_counts;
+
+        auto deck = parse( [&]( const Deck& head ) {
+            for( const auto& name : schedule_table_keywords )
+                head_counts.push_back( head.count( name ) );
+
+            return std::async( std::launch::async, [&inputs, &head] {
+                Trace::Span span( "StateLoader::head", "state" );
+
+                TaskGraph graph;
+                graph.add( "TableManager", [&] { inputs.tables.reset( new TableManager( head ) ); } );
+                graph.add( "NNC", [&] { inputs.nnc.reset( new NNC( head ) ); } );
+                graph.add( "EclipseGrid", [&] { inputs.grid.reset( new EclipseGrid( head, nullptr ) ); } );
+
+                try {
+                    graph.run();
+                } catch( ... ) {
+                    /* the members which failed are built, and fail, with the state */
+                }
+            } );
+        } );
+
+        for( size_t i = 0; i < schedule_table_keywords.size(); i++ ) {
+            if( deck.count( schedule_table_keywords[ i ] ) != head_counts[ i ] )
+                inputs.tables.reset();
+        }
+
+        return deck;
+    }
+
+}
+
+    StateLoader StateLoader::loadFile( const Parser& parser,
+                                       const std::string& dataFile,
+                                       const ParseContext& parseContext ) {
+        Trace::Span span( "StateLoader::loadFile", "state", dataFile );
+        EclipseState::Inputs inputs;
+
+        StateLoader loader;
+        loader.m_deck.reset( new Deck( parseAndBuild( [&]( const Parser::HeadHandler& handler ) {
+                return parser.parseFile( dataFile, parseContext, "SCHEDULE", handler );
+            }, inputs ) ) );
+
+        loader.m_state.reset( new EclipseState( *loader.m_deck, parseContext, std::move( inputs ) ) );
+        loader.m_schedule.reset( new Schedule( *loader.m_deck, *loader.m_state, parseContext ) );
+        return loader;
+    }
+
+    StateLoader StateLoader::loadString( const Parser& parser,
+                                         const std::string& data,
+                                         const ParseContext& parseContext ) {
+        Trace::Span span( "StateLoader::loadString", "state" );
+        EclipseState::Inputs inputs;
+
+        StateLoader loader;
+        loader.m_deck.reset( new Deck( parseAndBuild( [&]( const Parser::HeadHandler& handler ) {
+                return parser.parseString( data, parseContext, "SCHEDULE", handler );
+            }, inputs ) ) );
+
+        loader.m_state.reset( new EclipseState( *loader.m_deck, parseContext, std::move( inputs ) ) );
+        loader.m_schedule.reset( new Schedule( *loader.m_deck, *loader.m_state, parseContext ) );
+        return loader;
+    }
+
+    StateLoader::StateLoader( StateLoader&& ) = default;
+    StateLoader::~StateLoader() = default;
+
+    const Deck& StateLoader::getDeck() const {
+        return *this->m_deck;
+    }
+
+    const EclipseState& StateLoader::getEclipseState() const {
+        return *this->m_state;
+    }
+
+    const Schedule& StateLoader::getSchedule() const {
+        return *this->m_schedule;
+    }
+
+}
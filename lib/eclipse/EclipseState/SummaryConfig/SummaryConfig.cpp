@@ -36,6 +36,7 @@
 #include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
 #include <opm/parser/eclipse/EclipseState/Schedule/Well.hpp>
 #include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
 
 #include <ert/ecl/Smspec.hpp>
 #include <ert/ecl/ecl_smspec.h>
@@ -380,6 +381,7 @@ SummaryConfig::SummaryConfig( const Deck& deck,
                               const TableManager& tables,
                               const ParseContext& parseContext,
                               const GridDims& dims) {
+    Trace::Span span( "SummaryConfig", "state" );
     SUMMARYSection section( deck );
     for( auto& x : section )
         handleKW( this->keywords, x, schedule, tables, parseContext, dims);
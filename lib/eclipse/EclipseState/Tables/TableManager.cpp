@@ -81,6 +81,7 @@
 #include <opm/parser/eclipse/EclipseState/Tables/Aqudims.hpp>
 
 #include <opm/parser/eclipse/Units/Units.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
 
 namespace Opm {
 
@@ -93,6 +94,8 @@ namespace Opm {
         hasEqlnum (deck.hasKeyword("EQLNUM")),
         m_jfunc( deck )
     {
+        Trace::Span span( "TableManager", "state" );
+
         // determine the default resevoir temperature in Kelvin
         m_rtemp = ParserKeywords::RTEMP::TEMP::defaultValue;
         m_rtemp += Metric::TemperatureOffset; // <- default values always use METRIC as the unit system!
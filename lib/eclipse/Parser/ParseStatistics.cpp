@@ -0,0 +1,176 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+
+#include <opm/parser/eclipse/Parser/ParseStatistics.hpp>
+
+namespace Opm {
+
+namespace {
+
+    ParseStatistics::allocation_counter installed_counter = nullptr;
+    ParseStatistics::allocation_counter installed_bytes = nullptr;
+
+    std::vector< ParseStatistics::entry > sorted( const std::map< std::string, ParseStatistics::Counters >& counters ) {
+        std::vector< ParseStatistics::entry > entries( counters.begin(), counters.end() );
+        std::stable_sort( entries.begin(), entries.end(),
+                          []( const ParseStatistics::entry& lhs, const ParseStatistics::entry& rhs ) {
+                              return lhs.second.total_time() > rhs.second.total_time();
+                          });
+        return entries;
+    }
+
+    void write_header( std::ostream& os, const std::string& name ) {
+        os << std::left << std::setw( 24 ) << name << std::right
+           << std::setw( 8 )  << "count"
+           << std::setw( 14 ) << "bytes"
+           << std::setw( 10 ) << "records"
+           << std::setw( 12 ) << "items"
+           << std::setw( 14 ) << "values"
+           << std::setw( 12 ) << "allocs"
+           << std::setw( 14 ) << "alloc[B]"
+           << std::setw( 11 ) << "lex[s]"
+           << std::setw( 11 ) << "scan[s]"
+           << std::setw( 11 ) << "conv[s]"
+           << std::setw( 11 ) << "total[s]"
+           << std::endl;
+    }
+
+    void write_row( std::ostream& os, const std::string& name, const ParseStatistics::Counters& c ) {
+        os << std::left << std::setw( 24 ) << name << std::right
+           << std::setw( 8 )  << c.count
+           << std::setw( 14 ) << c.bytes
+           << std::setw( 10 ) << c.records
+           << std::setw( 12 ) << c.items
+           << std::setw( 14 ) << c.values
+           << std::setw( 12 ) << c.allocations
+           << std::setw( 14 ) << c.allocated_bytes
+           << std::fixed << std::setprecision( 4 )
+           << std::setw( 11 ) << c.lex_time
+           << std::setw( 11 ) << c.scan_time
+           << std::setw( 11 ) << c.convert_time
+           << std::setw( 11 ) << c.total_time()
+           << std::endl;
+    }
+
+}
+
+    double ParseStatistics::Counters::total_time() const {
+        return this->lex_time + this->scan_time + this->convert_time;
+    }
+
+    ParseStatistics::Counters& ParseStatistics::Counters::operator+=( const Counters& other ) {
+        this->count        += other.count;
+        this->bytes        += other.bytes;
+        this->records      += other.records;
+        this->items        += other.items;
+        this->values       += other.values;
+        this->allocations  += other.allocations;
+        this->allocated_bytes += other.allocated_bytes;
+        this->lex_time     += other.lex_time;
+        this->scan_time    += other.scan_time;
+        this->convert_time += other.convert_time;
+        return *this;
+    }
+
+    void ParseStatistics::add( const std::string& keyword,
+                               const std::string& filename,
+                               const Counters& counters ) {
+        this->m_keywords[ keyword ] += counters;
+        this->m_files[ filename ] += counters;
+    }
+
+    void ParseStatistics::addConvert( const std::string& keyword,
+                                      const std::string& filename,
+                                      double seconds,
+                                      size_t allocations,
+                                      size_t allocated_bytes ) {
+        Counters counters;
+        counters.convert_time = seconds;
+        counters.allocations = allocations;
+        counters.allocated_bytes = allocated_bytes;
+
+        this->m_keywords[ keyword ] += counters;
+        this->m_files[ filename ] += counters;
+    }
+
+    const std::map< std::string, ParseStatistics::Counters >& ParseStatistics::keywords() const {
+        return this->m_keywords;
+    }
+
+    const std::map< std::string, ParseStatistics::Counters >& ParseStatistics::files() const {
+        return this->m_files;
+    }
+
+    ParseStatistics::Counters ParseStatistics::total() const {
+        Counters sum;
+        for( const auto& kw : this->m_keywords )
+            sum += kw.second;
+
+        return sum;
+    }
+
+    bool ParseStatistics::empty() const {
+        return this->m_keywords.empty();
+    }
+
+    std::vector< ParseStatistics::entry > ParseStatistics::sortedKeywords() const {
+        return sorted( this->m_keywords );
+    }
+
+    std::vector< ParseStatistics::entry > ParseStatistics::sortedFiles() const {
+        return sorted( this->m_files );
+    }
+
+    void ParseStatistics::report( std::ostream& os, size_t max_rows ) const {
+        const auto keywords = this->sortedKeywords();
+        const size_t rows = max_rows == 0 ? keywords.size()
+                                          : std::min( max_rows, keywords.size() );
+
+        write_header( os, "Keyword" );
+        for( size_t row = 0; row < rows; row++ )
+            write_row( os, keywords[ row ].first, keywords[ row ].second );
+
+        write_row( os, "TOTAL", this->total() );
+        os << std::endl;
+
+        write_header( os, "File" );
+        for( const auto& file : this->sortedFiles() )
+            write_row( os, file.first, file.second );
+    }
+
+    void ParseStatistics::setAllocationCounter( allocation_counter counter,
+                                                allocation_counter bytes ) {
+        installed_counter = counter;
+        installed_bytes = bytes;
+    }
+
+    size_t ParseStatistics::allocations() {
+        if( !installed_counter ) return 0;
+        return installed_counter();
+    }
+
+    size_t ParseStatistics::allocatedBytes() {
+        if( !installed_bytes ) return 0;
+        return installed_bytes();
+    }
+}
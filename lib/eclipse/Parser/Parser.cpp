@@ -18,8 +18,11 @@
  */
 
 #include <cctype>
+#include <cmath>
+#include <chrono>
 #include <fstream>
 #include <memory>
+#include <stdexcept>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -34,6 +37,7 @@
 #include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/ParseStatistics.hpp>
 #include <opm/parser/eclipse/Parser/Parser.hpp>
 #include <opm/parser/eclipse/Parser/ParserItem.hpp>
 #include <opm/parser/eclipse/Parser/ParserKeyword.hpp>
@@ -43,7 +47,9 @@
 #include <opm/parser/eclipse/RawDeck/RawRecord.hpp>
 #include <opm/parser/eclipse/RawDeck/RawKeyword.hpp>
 #include <opm/parser/eclipse/RawDeck/StarToken.hpp>
+#include <opm/parser/eclipse/Utility/EclipseArrayFile.hpp>
 #include <opm/parser/eclipse/Utility/Stringview.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
 
 namespace Opm {
 
@@ -177,6 +183,51 @@ inline std::string clean( const std::string& str ) {
 
 const std::string emptystr = "";
 
+#ifdef OPM_PARSE_PROFILING
+/*
+  Small helper to measure the wall time and the number of allocations
+  spent between construction and the calls to seconds(), allocations()
+  and allocatedBytes(). Only used when profiling has been enabled.
+*/
+struct probe {
+    using clock = std::chrono::steady_clock;
+
+    explicit probe( bool active = true ) {
+        if( !active ) return;
+
+        this->start = clock::now();
+        this->start_allocations = ParseStatistics::allocations();
+        this->start_bytes = ParseStatistics::allocatedBytes();
+    }
+
+    double seconds() const {
+        return std::chrono::duration< double >( clock::now() - this->start ).count();
+    }
+
+    size_t allocations() const {
+        return ParseStatistics::allocations() - this->start_allocations;
+    }
+
+    size_t allocatedBytes() const {
+        return ParseStatistics::allocatedBytes() - this->start_bytes;
+    }
+
+    clock::time_point start;
+    size_t start_allocations = 0;
+    size_t start_bytes = 0;
+};
+
+void countKeyword( const DeckKeyword& keyword, ParseStatistics::Counters& counters ) {
+    counters.count = 1;
+    counters.records = keyword.size();
+    for( const auto& record : keyword ) {
+        counters.items += record.size();
+        for( const auto& item : record )
+            counters.values += item.size();
+    }
+}
+#endif
+
 struct file {
     file( boost::filesystem::path p, const std::string& in ) :
         input( in ), path( p )
@@ -218,7 +269,7 @@ class ParserState {
         size_t line() const;
 
         bool done() const;
-        string_view getline();
+        template< bool profiled > string_view getline();
         void closeFile();
 
     private:
@@ -236,6 +287,35 @@ class ParserState {
         Deck deck;
         const ParseContext& parseContext;
         bool unknown_keyword = false;
+
+        /*
+          The statistics pointer is only set when profiling is enabled;
+          the lexed_bytes counter is the number of input bytes consumed
+          since it was last reset. The counters and the lex probe of the
+          current keyword live here rather than in the parse loop; all three
+          are only maintained by the profiled instantiation of parseState().
+        */
+        ParseStatistics* statistics = nullptr;
+        size_t lexed_bytes = 0;
+#ifdef OPM_PARSE_PROFILING
+        ParseStatistics::Counters counters;
+        probe lex_probe{ false };
+#endif
+
+        /*
+          When parsing with a head handler the keywords before the
+          split section are moved to head when the parser reaches it,
+          and split is the number of keywords moved. Until they are
+          moved back the keywords of the deck are looked up with
+          lastKeyword().
+        */
+        const Parser::HeadHandler* handler = nullptr;
+        std::string split_section;
+        size_t split = 0;
+        Deck head;
+        std::future< void > pending;
+
+        const DeckKeyword& lastKeyword( const std::string& name ) const;
 };
 
 
@@ -256,12 +336,16 @@ bool ParserState::done() const {
     return this->input_stack.empty();
 }
 
+template< bool profiled >
 string_view ParserState::getline() {
     string_view ln;
 
     Opm::getline( this->input_stack.top().input, ln );
     this->input_stack.top().lineNR++;
 
+    if( profiled )
+        this->lexed_bytes += ln.size() + 1;
+
     return ln;
 }
 
@@ -269,6 +353,13 @@ void ParserState::closeFile() {
     this->input_stack.pop();
 }
 
+const DeckKeyword& ParserState::lastKeyword( const std::string& name ) const {
+    if( this->head.count( name ) == this->deck.count( name ) )
+        return this->head.getKeyword( name );
+
+    return this->deck.getKeyword( name );
+}
+
 ParserState::ParserState(const ParseContext& __parseContext) :
     parseContext( __parseContext )
 {}
@@ -286,6 +377,7 @@ void ParserState::loadString(const std::string& input) {
 }
 
 void ParserState::loadFile(const boost::filesystem::path& inputFile) {
+    Trace::Span span( "loadFile", "io", inputFile.string() );
 
     boost::filesystem::path inputFileCanonical;
     try {
@@ -408,6 +500,13 @@ void ParserState::addPathAlias( const std::string& alias, const std::string& pat
     this->pathMap.emplace( alias, path );
 }
 
+void enableStatistics( ParserState& parserState ) {
+    const auto statistics = std::make_shared< ParseStatistics >();
+    parserState.deck.setParseStatistics( statistics );
+    parserState.head.setParseStatistics( statistics );
+    parserState.statistics = statistics.get();
+}
+
 std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserState& parserState, const Parser& parser ) {
     auto keywordString = ParserKeyword::getDeckName( kw );
 
@@ -453,7 +552,7 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
     const auto& deck = parserState.deck;
 
     if( deck.hasKeyword(keyword_size.keyword ) ) {
-        const auto& sizeDefinitionKeyword = deck.getKeyword(keyword_size.keyword);
+        const auto& sizeDefinitionKeyword = parserState.lastKeyword(keyword_size.keyword);
         const auto& record = sizeDefinitionKeyword.getRecord(0);
         const auto targetSize = record.getItem( keyword_size.item ).get< int >( 0 ) + keyword_size.shift;
         return std::make_shared< RawKeyword >( keywordString,
@@ -480,6 +579,7 @@ std::shared_ptr< RawKeyword > createRawKeyword( const string_view& kw, ParserSta
                                             parserKeyword->isTableCollection() );
 }
 
+template< bool profiled >
 bool tryParseKeyword( ParserState& parserState, const Parser& parser ) {
     if (parserState.nextKeyword.length() > 0) {
         parserState.rawKeyword = createRawKeyword( parserState.nextKeyword, parserState, parser );
@@ -490,7 +590,7 @@ bool tryParseKeyword( ParserState& parserState, const Parser& parser ) {
         return true;
 
     while( !parserState.done() ) {
-        auto line = parserState.getline();
+        auto line = parserState.getline< profiled >();
 
         if( line.empty() && !parserState.rawKeyword ) continue;
         if( line.empty() && !parserState.rawKeyword->is_title() ) continue;
@@ -540,16 +640,224 @@ bool tryParseKeyword( ParserState& parserState, const Parser& parser ) {
     return false;
 }
 
+/*
+  The IMPORT keyword reads the arrays of an Eclipse array file; each
+  array which is a known data keyword, e.g. PORO or ZCORN, is added to
+  the deck as if it had been given in the input. The path is resolved
+  like an INCLUDE path.
+*/
+void importArrays( ParserState& parserState, const Parser& parser ) {
+    auto& record = parserState.rawKeyword->getFirstRecord( );
+    const auto filename = parserState.getIncludeFilePath( readValueToken< std::string >( record.getItem( 0 ) ) );
+
+    bool formatted = false;
+    if( record.size() > 1 ) {
+        const auto flag = readValueToken< std::string >( record.getItem( 1 ) );
+        formatted = !flag.empty() && ( std::toupper( flag[ 0 ] ) == 'F' || std::toupper( flag[ 0 ] ) == 'Y' );
+    }
+
+    if( !boost::filesystem::is_regular_file( filename ) ) {
+        std::string msg = "Could not open IMPORT file: " + filename.string();
+        parserState.parseContext.handleError( ParseContext::PARSE_MISSING_INCLUDE , parserState.deck.getMessageContainer() , msg);
+        return;
+    }
+
+    /* The imported keywords are located at the IMPORT keyword. */
+    const auto& location = parserState.rawKeyword->getFilename();
+    const auto lineNR = parserState.rawKeyword->getLineNR();
+
+    Trace::Span span( "IMPORT", "io", filename.string() );
+    for( auto& array : readEclipseArrays( filename.string(), formatted ) ) {
+        const auto* parserKeyword = parser.isRecognizedKeyword( array.name )
+                                  ? parser.getParserKeywordFromDeckName( array.name )
+                                  : nullptr;
+
+        if( !parserKeyword || !parserKeyword->isDataKeyword() ) {
+            parserState.deck.getMessageContainer().warning(
+                "The array " + array.name + " in " + filename.string() + " is not a data keyword - ignored", location, lineNR );
+            continue;
+        }
+
+        const auto& parserItem = parserKeyword->getRecord( 0 ).get( 0 );
+        DeckRecord deckRecord;
+        if( parserItem.dataType() == type_tag::fdouble ) {
+            if( array.type == type_tag::integer )
+                array.dval.assign( array.ival.begin(), array.ival.end() );
+            deckRecord.addItem( DeckItem( parserItem.name(), std::move( array.dval ) ) );
+        } else if( parserItem.dataType() == type_tag::integer ) {
+            if( array.type == type_tag::fdouble )
+                for( const double value : array.dval )
+                    array.ival.push_back( static_cast< int >( std::lround( value ) ) );
+            deckRecord.addItem( DeckItem( parserItem.name(), std::move( array.ival ) ) );
+        } else {
+            parserState.deck.getMessageContainer().warning(
+                "The array " + array.name + " in " + filename.string() + " is not numeric - ignored", location, lineNR );
+            continue;
+        }
+
+        DeckKeyword keyword( array.name );
+        keyword.setLocation( location, lineNR );
+        keyword.setDataKeyword( true );
+        keyword.addRecord( std::move( deckRecord ) );
+        if( parserKeyword->hasFixedSize() )
+            keyword.setFixedSize();
+
+        parserState.deck.addKeyword( std::move( keyword ) );
+    }
+}
+
+bool isSectionName( const std::string& name ) {
+    for( const auto& x : { "RUNSPEC", "GRID", "EDIT", "PROPS",
+                           "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } )
+        if( name == x ) return true;
+
+    return false;
+}
+
+/*
+  If multiple unit systems are requested, metric is preferred over lab,
+  and field over metric, for as long as we have no easy way of figuring
+  out which was requested last.
+*/
+void selectUnitSystem( Deck& deck ) {
+    if( deck.hasKeyword( "LAB" ) )
+        deck.getActiveUnitSystem() = UnitSystem::newLAB();
+    if( deck.hasKeyword( "FIELD" ) )
+        deck.getActiveUnitSystem() = UnitSystem::newFIELD();
+    if( deck.hasKeyword( "METRIC" ) )
+        deck.getActiveUnitSystem() = UnitSystem::newMETRIC();
+}
+
+template< bool profiled >
+void applyUnits( const Parser& parser, Deck& deck, Deck::iterator first ) {
+    for( auto iter = first; iter != deck.end(); ++iter ) {
+        auto& deckKeyword = *iter;
+
+        if( !parser.isRecognizedKeyword( deckKeyword.name() ) ) continue;
+
+        const auto* parserKeyword = parser.getParserKeywordFromDeckName( deckKeyword.name() );
+        if( !parserKeyword->hasDimension() ) continue;
+
+#ifdef OPM_PARSE_PROFILING
+        if( profiled ) {
+            const probe convert_probe;
+            parserKeyword->applyUnitsToDeck(deck , deckKeyword);
+            deck.getParseStatistics().addConvert( deckKeyword.name(),
+                                    deckKeyword.getFileName(),
+                                    convert_probe.seconds(),
+                                    convert_probe.allocations(),
+                                    convert_probe.allocatedBytes() );
+            continue;
+        }
+#endif
+
+        parserKeyword->applyUnitsToDeck(deck , deckKeyword);
+    }
+}
+
+void applyUnits( const Parser& parser, Deck& deck, Deck::iterator first ) {
+#ifdef OPM_PARSE_PROFILING
+    if( deck.hasParseStatistics() )
+        return applyUnits< true >( parser, deck, first );
+#endif
+
+    applyUnits< false >( parser, deck, first );
+}
+
+/*
+  Move the keywords parsed so far to the head deck and hand it to the
+  head handler. The moved-from keywords stay in the deck as placeholders,
+  so the keyword index of the deck is still valid when they are moved
+  back in assembleDeck().
+*/
+void splitHead( ParserState& parserState, const Parser& parser ) {
+    Trace::Span span( "Parser::splitHead", "parser", parserState.split_section );
+    auto& deck = parserState.deck;
+    auto& head = parserState.head;
+
+    head.setDataFile( deck.getDataFile() );
+    for( auto& keyword : deck )
+        head.addKeyword( std::move( keyword ) );
+    parserState.split = head.size();
+
+    selectUnitSystem( head );
+    applyUnits( parser, head, head.begin() );
+
+    const auto& handler = *parserState.handler;
+    parserState.handler = nullptr;
+    parserState.pending = handler( head );
+}
+
+void assembleDeck( ParserState& parserState, const Parser& parser ) {
+    auto& deck = parserState.deck;
+    auto& head = parserState.head;
+
+    if( parserState.handler ) {
+        selectUnitSystem( deck );
+        applyUnits( parser, deck, deck.begin() );
+
+        const auto& handler = *parserState.handler;
+        parserState.handler = nullptr;
+        auto pending = handler( deck );
+        if( pending.valid() )
+            pending.get();
+        return;
+    }
+
+    if( parserState.pending.valid() )
+        parserState.pending.get();
+
+    Trace::Span span( "Parser::assembleDeck", "parser" );
+    for( size_t index = 0; index < parserState.split; index++ )
+        deck.getKeyword( index ) = std::move( head.getKeyword( index ) );
+    deck.getMessageContainer().appendMessages( head.getMessageContainer() );
+
+    selectUnitSystem( deck );
+    if( deck.getActiveUnitSystem().getType() != head.getActiveUnitSystem().getType() )
+        throw std::invalid_argument( "The unit system must be selected before the "
+                                     + parserState.split_section + " section" );
+
+    applyUnits( parser, deck, deck.begin() + parserState.split );
+}
+
+/*
+  The parse loop is instantiated twice, and the profiled instantiation is
+  only selected when statistics are collected; the profiling bookkeeping
+  is compiled out of the unprofiled loop.
+*/
+template< bool profiled >
 bool parseState( ParserState& parserState, const Parser& parser ) {
 
     while( !parserState.done() ) {
 
         parserState.rawKeyword.reset();
 
-        const bool streamOK = tryParseKeyword( parserState, parser );
+#ifdef OPM_PARSE_PROFILING
+        if( profiled ) {
+            parserState.counters = ParseStatistics::Counters();
+            parserState.lexed_bytes = 0;
+            parserState.lex_probe = probe();
+        }
+#endif
+
+        bool streamOK;
+        {
+            Trace::Span span( "lex", "lexer" );
+            streamOK = tryParseKeyword< profiled >( parserState, parser );
+        }
         if( !parserState.rawKeyword && !streamOK )
             continue;
 
+#ifdef OPM_PARSE_PROFILING
+        if( profiled ) {
+            auto& counters = parserState.counters;
+            counters.lex_time = parserState.lex_probe.seconds();
+            counters.allocations = parserState.lex_probe.allocations();
+            counters.allocated_bytes = parserState.lex_probe.allocatedBytes();
+            counters.bytes = parserState.lexed_bytes;
+        }
+#endif
+
         if (parserState.rawKeyword->getKeywordName() == Opm::RawConsts::end)
             return true;
 
@@ -568,6 +876,11 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
             continue;
         }
 
+        if (parserState.rawKeyword->getKeywordName() == Opm::RawConsts::import) {
+            importArrays( parserState, parser );
+            continue;
+        }
+
         if (parserState.rawKeyword->getKeywordName() == Opm::RawConsts::include) {
             auto& firstRecord = parserState.rawKeyword->getFirstRecord( );
             std::string includeFileAsString = readValueToken<std::string>(firstRecord.getItem(0));
@@ -580,6 +893,24 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         if( parser.isRecognizedKeyword( parserState.rawKeyword->getKeywordName() ) ) {
             const auto& kwname = parserState.rawKeyword->getKeywordName();
             const auto* parserKeyword = parser.getParserKeywordFromDeckName( kwname );
+            if( parserState.handler && kwname == parserState.split_section )
+                splitHead( parserState, parser );
+
+            Trace::Span span( kwname, "parser" );
+#ifdef OPM_PARSE_PROFILING
+            if( profiled ) {
+                auto& counters = parserState.counters;
+                const probe scan_probe;
+                auto keyword = parserKeyword->parse( parserState.parseContext, parserState.deck.getMessageContainer(), parserState.rawKeyword );
+                counters.scan_time = scan_probe.seconds();
+                counters.allocations += scan_probe.allocations();
+                counters.allocated_bytes += scan_probe.allocatedBytes();
+                countKeyword( keyword, counters );
+                parserState.statistics->add( keyword.name(), parserState.rawKeyword->getFilename(), counters );
+                parserState.deck.addKeyword( std::move( keyword ) );
+                continue;
+            }
+#endif
             parserState.deck.addKeyword( parserKeyword->parse( parserState.parseContext, parserState.deck.getMessageContainer(), parserState.rawKeyword ) );
         } else {
             DeckKeyword deckKeyword( parserState.rawKeyword->getKeywordName(), false );
@@ -595,6 +926,38 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     return true;
 }
 
+bool parseState( ParserState& parserState, const Parser& parser ) {
+#ifdef OPM_PARSE_PROFILING
+    if( parserState.statistics )
+        return parseState< true >( parserState, parser );
+#endif
+
+    return parseState< false >( parserState, parser );
+}
+
+/*
+  Parse with a head handler; the head deck must stay alive until the
+  handler is done with it, also when the parser fails.
+*/
+void parseSplit( ParserState& parserState, const Parser& parser,
+                 const std::string& section, const Parser::HeadHandler& handler ) {
+    if( !isSectionName( section ) )
+        throw std::invalid_argument( "Not a section keyword: " + section );
+
+    parserState.handler = &handler;
+    parserState.split_section = section;
+
+    try {
+        parseState( parserState, parser );
+    } catch( ... ) {
+        if( parserState.pending.valid() )
+            parserState.pending.wait();
+        throw;
+    }
+
+    assembleDeck( parserState, parser );
+}
+
 }
 
 
@@ -665,15 +1028,36 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
     }
 
     Deck Parser::parseFile(const std::string &dataFileName, const ParseContext& parseContext) const {
+        Trace::Span span( "Parser::parseFile", "parser", dataFileName );
         ParserState parserState( parseContext, dataFileName );
+        if( this->profiling() )
+            enableStatistics( parserState );
+
         parseState( parserState, *this );
         applyUnitsToDeck( parserState.deck );
 
         return std::move( parserState.deck );
     }
 
+    Deck Parser::parseFile(const std::string &dataFileName,
+                           const ParseContext& parseContext,
+                           const std::string& section,
+                           const HeadHandler& handler) const {
+        Trace::Span span( "Parser::parseFile", "parser", dataFileName );
+        ParserState parserState( parseContext, dataFileName );
+        if( this->profiling() )
+            enableStatistics( parserState );
+
+        parseSplit( parserState, *this, section, handler );
+
+        return std::move( parserState.deck );
+    }
+
     Deck Parser::parseString(const std::string &data, const ParseContext& parseContext) const {
+        Trace::Span span( "Parser::parseString", "parser" );
         ParserState parserState( parseContext );
+        if( this->profiling() )
+            enableStatistics( parserState );
         parserState.loadString( data );
 
         parseState( parserState, *this );
@@ -682,10 +1066,37 @@ bool parseState( ParserState& parserState, const Parser& parser ) {
         return std::move( parserState.deck );
     }
 
+    Deck Parser::parseString(const std::string &data,
+                             const ParseContext& parseContext,
+                             const std::string& section,
+                             const HeadHandler& handler) const {
+        Trace::Span span( "Parser::parseString", "parser" );
+        ParserState parserState( parseContext );
+        if( this->profiling() )
+            enableStatistics( parserState );
+        parserState.loadString( data );
+
+        parseSplit( parserState, *this, section, handler );
+
+        return std::move( parserState.deck );
+    }
+
     size_t Parser::size() const {
         return m_deckParserKeywords.size();
     }
 
+    void Parser::setProfiling( bool profiling ) {
+        this->m_profiling = profiling;
+    }
+
+    bool Parser::profiling() const {
+#ifdef OPM_PARSE_PROFILING
+        return this->m_profiling;
+#else
+        return false;
+#endif
+    }
+
     const ParserKeyword* Parser::matchingKeyword(const string_view& name) const {
         for (auto iter = m_wildCardKeywords.begin(); iter != m_wildCardKeywords.end(); ++iter) {
             if (iter->second->matches(name))
@@ -827,36 +1238,13 @@ std::vector<std::string> Parser::getAllDeckNames () const {
 
 
     void Parser::applyUnitsToDeck(Deck& deck) const {
-        /*
-         * If multiple unit systems are requested, metric is preferred over
-         * lab, and field over metric, for as long as we have no easy way of
-         * figuring out which was requested last.
-         */
-        if( deck.hasKeyword( "LAB" ) )
-            deck.getActiveUnitSystem() = UnitSystem::newLAB();
-        if( deck.hasKeyword( "FIELD" ) )
-            deck.getActiveUnitSystem() = UnitSystem::newFIELD();
-        if( deck.hasKeyword( "METRIC" ) )
-            deck.getActiveUnitSystem() = UnitSystem::newMETRIC();
-
-        for( auto& deckKeyword : deck ) {
-
-            if( !isRecognizedKeyword( deckKeyword.name() ) ) continue;
-
-            const auto* parserKeyword = getParserKeywordFromDeckName( deckKeyword.name() );
-            if( !parserKeyword->hasDimension() ) continue;
-
-            parserKeyword->applyUnitsToDeck(deck , deckKeyword);
-        }
+        Trace::Span span( "Parser::applyUnitsToDeck", "units" );
+        selectUnitSystem( deck );
+        applyUnits( *this, deck, deck.begin() );
     }
 
     static bool isSectionDelimiter( const DeckKeyword& keyword ) {
-        const auto& name = keyword.name();
-        for( const auto& x : { "RUNSPEC", "GRID", "EDIT", "PROPS",
-                               "REGIONS", "SOLUTION", "SUMMARY", "SCHEDULE" } )
-            if( name == x ) return true;
-
-        return false;
+        return isSectionName( keyword.name() );
     }
 
     bool Section::checkSectionTopology(const Deck& deck,
@@ -269,6 +269,10 @@ void ParserItem::push_backDimension( const std::string& dim ) {
         return m_sizeType;
     }
 
+    type_tag ParserItem::dataType() const {
+        return this->type;
+    }
+
     bool ParserItem::scalar() const {
         return this->m_sizeType == item_size::SINGLE;
     }
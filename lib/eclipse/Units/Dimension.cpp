@@ -18,6 +18,7 @@
 */
 
 #include <opm/parser/eclipse/Units/Dimension.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
 
 #include <string>
 #include <stdexcept>
@@ -36,6 +37,20 @@ namespace Opm {
         m_SIoffset = SIoffset;
     }
 
+    /* The name is not validated, as composite dimensions are serialized too. */
+    Dimension::Dimension(BinaryReader& reader) :
+        m_name( reader.readString() ),
+        m_SIfactor( reader.read< double >() ),
+        m_SIoffset( reader.read< double >() )
+    {
+    }
+
+    void Dimension::serialize(BinaryWriter& writer) const {
+        writer.write( m_name );
+        writer.write( m_SIfactor );
+        writer.write( m_SIoffset );
+    }
+
     double Dimension::getSIScaling() const {
         if (!std::isfinite(m_SIfactor))
             throw std::logic_error("The DeckItem contains a field with a context dependent unit. "
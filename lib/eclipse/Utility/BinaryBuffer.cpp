@@ -0,0 +1,181 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <fstream>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
+#include <opm/parser/eclipse/Utility/MappedFile.hpp>
+
+namespace Opm {
+
+namespace {
+
+    const char magic[ 8 ] = { 'O', 'P', 'M', 'B', 'U', 'F', 'R', '\0' };
+    const uint32_t byte_order_mark = 0x01020304;
+    const size_t alignment = 8;
+    const size_t header_size = sizeof( magic ) + 2 * sizeof( uint32_t );
+
+}
+
+    const uint32_t BinaryWriter::version;
+
+    BinaryWriter::BinaryWriter() {
+        this->append( magic, sizeof( magic ) );
+        this->write( version );
+        this->write( byte_order_mark );
+    }
+
+    void BinaryWriter::write( const std::string& value ) {
+        this->write( uint64_t( value.size() ) );
+        this->append( value.data(), value.size() );
+    }
+
+    void BinaryWriter::writeArray( const std::vector< bool >& values ) {
+        std::vector< uint8_t > bytes( values.begin(), values.end() );
+        this->writeArray( bytes );
+    }
+
+    void BinaryWriter::writeArray( const std::vector< std::string >& values ) {
+        this->write( uint64_t( values.size() ) );
+        for( const auto& value : values )
+            this->write( value );
+    }
+
+    const std::vector< char >& BinaryWriter::data() const {
+        return this->m_buffer;
+    }
+
+    std::vector< char > BinaryWriter::release() {
+        std::vector< char > buffer;
+        buffer.swap( this->m_buffer );
+        return buffer;
+    }
+
+    void BinaryWriter::writeFile( const std::string& filename ) const {
+        std::ofstream stream( filename, std::ios::binary );
+        if( !stream )
+            throw std::invalid_argument( "Could not open file for writing: " + filename );
+
+        stream.write( this->m_buffer.data(), this->m_buffer.size() );
+        if( !stream )
+            throw std::invalid_argument( "Could not write file: " + filename );
+    }
+
+    void BinaryWriter::append( const void* data, size_t size ) {
+        const auto* bytes = static_cast< const char* >( data );
+        this->m_buffer.insert( this->m_buffer.end(), bytes, bytes + size );
+    }
+
+    void BinaryWriter::pad() {
+        const size_t rem = this->m_buffer.size() % alignment;
+        if( rem != 0 )
+            this->m_buffer.resize( this->m_buffer.size() + alignment - rem, 0 );
+    }
+
+
+    BinaryReader::BinaryReader( const char* data, size_t size ) :
+        BinaryReader( nullptr, data, data + size )
+    {}
+
+    BinaryReader::BinaryReader( std::shared_ptr< const std::vector< char > > buffer ) :
+        BinaryReader( buffer, buffer->data(), buffer->data() + buffer->size() )
+    {}
+
+    BinaryReader::BinaryReader( const std::string& filename ) :
+        BinaryReader( std::make_shared< const MappedFile >( filename ) )
+    {}
+
+    BinaryReader::BinaryReader( const std::shared_ptr< const MappedFile >& file ) :
+        BinaryReader( file, file->begin(), file->end() )
+    {}
+
+    BinaryReader::BinaryReader( std::shared_ptr< const void > owner, const char* begin, const char* end ) :
+        m_owner( std::move( owner ) ),
+        m_begin( begin ),
+        m_end( end ),
+        m_pos( begin )
+    {
+        this->init();
+    }
+
+    void BinaryReader::init() {
+        if( reinterpret_cast< uintptr_t >( this->m_begin ) % alignment != 0 )
+            throw std::runtime_error( "The binary buffer is not 8 byte aligned" );
+
+        if( size_t( this->m_end - this->m_begin ) < header_size
+            || std::memcmp( this->m_begin, magic, sizeof( magic ) ) != 0 )
+            throw std::runtime_error( "Not a binary buffer" );
+
+        this->m_pos += sizeof( magic );
+        if( this->read< uint32_t >() != BinaryWriter::version )
+            throw std::runtime_error( "Unsupported binary buffer version" );
+
+        if( this->read< uint32_t >() != byte_order_mark )
+            throw std::runtime_error( "The binary buffer was written with a different byte order" );
+    }
+
+    std::string BinaryReader::readString() {
+        const auto size = this->read< uint64_t >();
+        const char* data = this->takeArray( size, 1 );
+        return std::string( data, data + size );
+    }
+
+    std::vector< bool > BinaryReader::readBoolArray() {
+        const auto view = this->readView< uint8_t >();
+        return std::vector< bool >( view.begin(), view.end() );
+    }
+
+    std::vector< std::string > BinaryReader::readStringArray() {
+        const auto size = this->read< uint64_t >();
+        std::vector< std::string > values;
+        for( uint64_t i = 0; i < size; i++ )
+            values.push_back( this->readString() );
+
+        return values;
+    }
+
+    bool BinaryReader::atEnd() const {
+        return this->m_pos == this->m_end;
+    }
+
+    const char* BinaryReader::take( size_t size ) {
+        if( size > size_t( this->m_end - this->m_pos ) )
+            throw std::runtime_error( "Read past the end of the binary buffer" );
+
+        const char* data = this->m_pos;
+        this->m_pos += size;
+        return data;
+    }
+
+    const char* BinaryReader::takeArray( uint64_t count, size_t element_size ) {
+        if( count > uint64_t( this->m_end - this->m_pos ) / element_size )
+            throw std::runtime_error( "Read past the end of the binary buffer" );
+
+        return this->take( count * element_size );
+    }
+
+    void BinaryReader::skipPadding() {
+        const size_t rem = size_t( this->m_pos - this->m_begin ) % alignment;
+        if( rem != 0 )
+            this->take( alignment - rem );
+    }
+
+}
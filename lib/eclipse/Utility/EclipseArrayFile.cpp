@@ -0,0 +1,287 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <opm/parser/eclipse/Utility/EclipseArrayFile.hpp>
+#include <opm/parser/eclipse/Utility/MappedFile.hpp>
+
+namespace Opm {
+
+namespace {
+
+    uint32_t big_endian32( const char* p ) {
+        const auto* u = reinterpret_cast< const unsigned char* >( p );
+        return ( uint32_t( u[ 0 ] ) << 24 ) | ( uint32_t( u[ 1 ] ) << 16 )
+             | ( uint32_t( u[ 2 ] ) << 8 )  |   uint32_t( u[ 3 ] );
+    }
+
+    uint64_t big_endian64( const char* p ) {
+        return ( uint64_t( big_endian32( p ) ) << 32 ) | big_endian32( p + 4 );
+    }
+
+    std::string trim_name( const std::string& name ) {
+        const auto end = name.find_last_not_of( ' ' );
+        return end == std::string::npos ? "" : name.substr( 0, end + 1 );
+    }
+
+    /*
+      The size in bytes of one element of the given type; the MESS
+      arrays have no elements.
+    */
+    size_t element_size( const std::string& type, const std::string& filename ) {
+        if( type == "INTE" || type == "REAL" || type == "LOGI" ) return 4;
+        if( type == "DOUB" || type == "CHAR" ) return 8;
+        if( type == "MESS" ) return 1;
+        if( type.size() == 4 && type[ 0 ] == 'C' && std::atoi( type.c_str() + 1 ) > 0 )
+            return std::atoi( type.c_str() + 1 );
+
+        throw std::runtime_error( "Unknown array type '" + type + "' in file: " + filename );
+    }
+
+    EclipseArray make_array( const std::string& name, const std::string& type, size_t count ) {
+        EclipseArray array;
+        array.name = name;
+        if( type == "INTE" || type == "LOGI" ) {
+            array.type = type_tag::integer;
+            array.ival.reserve( count );
+        } else if( type == "REAL" || type == "DOUB" ) {
+            array.type = type_tag::fdouble;
+            array.dval.reserve( count );
+        }
+        return array;
+    }
+
+    void append_values( EclipseArray& array, const std::string& type, const char* data, size_t count ) {
+        if( type == "INTE" ) {
+            for( size_t i = 0; i < count; i++ )
+                array.ival.push_back( int32_t( big_endian32( data + 4 * i ) ) );
+        } else if( type == "LOGI" ) {
+            for( size_t i = 0; i < count; i++ )
+                array.ival.push_back( big_endian32( data + 4 * i ) != 0 ? 1 : 0 );
+        } else if( type == "REAL" ) {
+            for( size_t i = 0; i < count; i++ ) {
+                const uint32_t bits = big_endian32( data + 4 * i );
+                float value;
+                std::memcpy( &value, &bits, sizeof value );
+                array.dval.push_back( value );
+            }
+        } else if( type == "DOUB" ) {
+            for( size_t i = 0; i < count; i++ ) {
+                const uint64_t bits = big_endian64( data + 8 * i );
+                double value;
+                std::memcpy( &value, &bits, sizeof value );
+                array.dval.push_back( value );
+            }
+        }
+    }
+
+    /*
+      The unformatted file is a sequence of Fortran records, each of
+      them enclosed in big endian byte counts. An array is a 16 byte
+      header record followed by the data in records of at most 1000
+      elements.
+    */
+    class RecordReader {
+    public:
+        RecordReader( const MappedFile& file, const std::string& filename ) :
+            m_pos( file.begin() ),
+            m_end( file.end() ),
+            m_filename( filename )
+        {}
+
+        bool done() const {
+            return this->m_pos == this->m_end;
+        }
+
+        size_t remaining() const {
+            return this->m_end - this->m_pos;
+        }
+
+        const char* next( size_t& length ) {
+            if( this->m_end - this->m_pos < 8 )
+                this->corrupt();
+
+            length = big_endian32( this->m_pos );
+            if( size_t( this->m_end - this->m_pos ) < length + 8 )
+                this->corrupt();
+
+            const char* data = this->m_pos + 4;
+            if( big_endian32( data + length ) != length )
+                this->corrupt();
+
+            this->m_pos = data + length + 4;
+            return data;
+        }
+
+    private:
+        void corrupt() const {
+            throw std::runtime_error( "Invalid record in unformatted file: " + this->m_filename );
+        }
+
+        const char* m_pos;
+        const char* m_end;
+        const std::string& m_filename;
+    };
+
+    std::vector< EclipseArray > read_unformatted( const MappedFile& file, const std::string& filename ) {
+        std::vector< EclipseArray > arrays;
+        RecordReader reader( file, filename );
+
+        while( !reader.done() ) {
+            size_t length;
+            const char* header = reader.next( length );
+            if( length != 16 )
+                throw std::runtime_error( "Invalid array header in unformatted file: " + filename );
+
+            const auto name = trim_name( std::string( header, 8 ) );
+            const int32_t count = int32_t( big_endian32( header + 8 ) );
+            const std::string type( header + 12, 4 );
+            const size_t size = element_size( type, filename );
+            if( count < 0 || size_t( count ) > reader.remaining() / size )
+                throw std::runtime_error( "Invalid array header in unformatted file: " + filename );
+
+            auto array = make_array( name, type, count );
+            size_t read = 0;
+            while( read < size_t( count ) ) {
+                const char* data = reader.next( length );
+                if( length % size != 0 || read + length / size > size_t( count ) )
+                    throw std::runtime_error( "Invalid data record for " + name + " in unformatted file: " + filename );
+
+                append_values( array, type, data, length / size );
+                read += length / size;
+            }
+
+            if( array.type != type_tag::unknown )
+                arrays.push_back( std::move( array ) );
+        }
+
+        return arrays;
+    }
+
+    /*
+      The formatted file has the same structure, with a header line
+      'NAME' count 'TYPE' followed by the values; quoted tokens may
+      contain spaces, and the exponent of DOUB values is written with D.
+    */
+    class Tokenizer {
+    public:
+        explicit Tokenizer( const MappedFile& file ) :
+            m_pos( file.begin() ),
+            m_end( file.end() )
+        {}
+
+        bool next( std::string& token ) {
+            while( this->m_pos != this->m_end && std::isspace( static_cast< unsigned char >( *this->m_pos ) ) )
+                ++this->m_pos;
+
+            if( this->m_pos == this->m_end ) return false;
+
+            const char* begin = this->m_pos;
+            if( *begin == '\'' ) {
+                const char* end = std::find( begin + 1, this->m_end, '\'' );
+                token.assign( begin + 1, end );
+                this->m_pos = end == this->m_end ? end : end + 1;
+                return true;
+            }
+
+            while( this->m_pos != this->m_end && !std::isspace( static_cast< unsigned char >( *this->m_pos ) ) )
+                ++this->m_pos;
+
+            token.assign( begin, this->m_pos );
+            return true;
+        }
+
+        size_t remaining() const {
+            return this->m_end - this->m_pos;
+        }
+
+    private:
+        const char* m_pos;
+        const char* m_end;
+    };
+
+    std::vector< EclipseArray > read_formatted( const MappedFile& file, const std::string& filename ) {
+        std::vector< EclipseArray > arrays;
+        Tokenizer tokenizer( file );
+        std::string token;
+
+        while( tokenizer.next( token ) ) {
+            const auto name = trim_name( token );
+            std::string count_token;
+            std::string type;
+            if( !tokenizer.next( count_token ) || !tokenizer.next( type ) )
+                throw std::runtime_error( "Invalid array header in formatted file: " + filename );
+
+            /*
+              Every value is at least one character and all but the last
+              are followed by whitespace, which bounds the count before
+              any memory is reserved for it.
+            */
+            char* end = nullptr;
+            const long count = std::strtol( count_token.c_str(), &end, 10 );
+            if( end == count_token.c_str() || *end != '\0' || count < 0
+                || size_t( count ) > ( tokenizer.remaining() + 1 ) / 2 )
+                throw std::runtime_error( "Invalid array header in formatted file: " + filename );
+
+            element_size( type, filename );
+
+            auto array = make_array( name, type, count );
+            for( long i = 0; i < count; i++ ) {
+                if( !tokenizer.next( token ) )
+                    throw std::runtime_error( "Too few values for " + name + " in formatted file: " + filename );
+
+                if( type == "INTE" )
+                    array.ival.push_back( std::stoi( token ) );
+                else if( type == "LOGI" )
+                    array.ival.push_back( token == "T" ? 1 : 0 );
+                else if( array.type == type_tag::fdouble ) {
+                    std::replace( token.begin(), token.end(), 'D', 'E' );
+                    array.dval.push_back( std::strtod( token.c_str(), nullptr ) );
+                }
+            }
+
+            if( array.type != type_tag::unknown )
+                arrays.push_back( std::move( array ) );
+        }
+
+        return arrays;
+    }
+
+}
+
+    size_t EclipseArray::size() const {
+        return this->type == type_tag::integer ? this->ival.size() : this->dval.size();
+    }
+
+    std::vector< EclipseArray > readEclipseArrays( const std::string& filename, bool formatted ) {
+        const MappedFile file( filename );
+        if( formatted )
+            return read_formatted( file, filename );
+
+        return read_unformatted( file, filename );
+    }
+
+}
@@ -0,0 +1,61 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <opm/parser/eclipse/Utility/MappedFile.hpp>
+
+namespace Opm {
+
+    MappedFile::MappedFile( const std::string& filename ) {
+        this->m_fd = ::open( filename.c_str(), O_RDONLY );
+        if( this->m_fd < 0 )
+            throw std::invalid_argument( "Could not open file: " + filename );
+
+        struct stat st;
+        if( ::fstat( this->m_fd, &st ) != 0 ) {
+            ::close( this->m_fd );
+            throw std::invalid_argument( "Could not stat file: " + filename );
+        }
+
+        this->m_size = st.st_size;
+        if( this->m_size == 0 ) return;
+
+        void* addr = ::mmap( nullptr, this->m_size, PROT_READ, MAP_PRIVATE, this->m_fd, 0 );
+        if( addr == MAP_FAILED ) {
+            ::close( this->m_fd );
+            throw std::invalid_argument( "Could not map file: " + filename );
+        }
+
+        this->m_data = static_cast< const char* >( addr );
+    }
+
+    MappedFile::~MappedFile() {
+        if( this->m_data )
+            ::munmap( const_cast< char* >( this->m_data ), this->m_size );
+        ::close( this->m_fd );
+    }
+
+}
@@ -0,0 +1,447 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include <opm/parser/eclipse/Utility/SyntheticDeck.hpp>
+
+namespace Opm {
+
+namespace {
+
+    /*
+      A splitmix64 generator; the standard library distributions are not
+      guaranteed to give the same sequence on all platforms.
+    */
+    class random {
+    public:
+        explicit random( uint64_t seed ) : state( seed ) {}
+
+        uint64_t next() {
+            uint64_t z = ( this->state += 0x9E3779B97F4A7C15ULL );
+            z = ( z ^ ( z >> 30 ) ) * 0xBF58476D1CE4E5B9ULL;
+            z = ( z ^ ( z >> 27 ) ) * 0x94D049BB133111EBULL;
+            return z ^ ( z >> 31 );
+        }
+
+        double uniform( double low, double high ) {
+            const double unit = ( this->next() >> 11 ) * ( 1.0 / 9007199254740992.0 );
+            return low + ( high - low ) * unit;
+        }
+
+        size_t index( size_t size ) {
+            return this->next() % size;
+        }
+
+    private:
+        uint64_t state;
+    };
+
+    std::string format( double value ) {
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision( 4 ) << value;
+        return ss.str();
+    }
+
+    /*
+      Write the values of a keyword with repeat counts for runs of equal
+      values, eight tokens per line.
+    */
+    void write_array( std::ostream& os, const std::string& keyword, const std::vector< std::string >& values ) {
+        os << keyword << std::endl;
+
+        size_t tokens = 0;
+        for( size_t index = 0; index < values.size(); ) {
+            size_t count = 1;
+            while( index + count < values.size() && values[ index + count ] == values[ index ] )
+                count++;
+
+            if( count > 1 )
+                os << " " << count << "*" << values[ index ];
+            else
+                os << " " << values[ index ];
+
+            index += count;
+            if( ++tokens % 8 == 0 )
+                os << std::endl;
+        }
+        os << " /" << std::endl << std::endl;
+    }
+
+    std::vector< std::string > random_array( random& rng, size_t size, size_t repeat, double low, double high ) {
+        std::vector< std::string > values;
+        values.reserve( size );
+
+        std::string value;
+        for( size_t index = 0; index < size; index++ ) {
+            if( index % repeat == 0 )
+                value = format( rng.uniform( low, high ) );
+            values.push_back( value );
+        }
+        return values;
+    }
+
+    /*
+      The cells with I index >= fault_index( f ) are on the far side of
+      fault f; the faults are evenly spaced in the x direction.
+    */
+    size_t fault_index( size_t fault, size_t faults, size_t nx ) {
+        return ( fault + 1 ) * nx / ( faults + 1 );
+    }
+
+}
+
+    SyntheticDeck::SyntheticDeck( const Options& options ) :
+        m_options( options )
+    {
+        const auto nx = options.nx;
+        const auto ny = options.ny;
+        const auto nz = options.nz;
+        const auto cells = nx * ny * nz;
+
+        if( cells == 0 )
+            throw std::invalid_argument( "The grid dimensions must be positive" );
+
+        if( options.wells > nx * ny )
+            throw std::invalid_argument( "Can not place " + std::to_string( options.wells )
+                                         + " wells in " + std::to_string( nx * ny ) + " columns" );
+
+        if( options.faults >= nx )
+            throw std::invalid_argument( "At most nx - 1 faults are supported" );
+
+        const size_t repeat = std::max< size_t >( options.repeat, 1 );
+        const size_t regions = std::max< size_t >( std::min( options.regions, nx ), 1 );
+        random rng( options.seed );
+
+        {
+            std::ostringstream os;
+            os << "TITLE" << std::endl
+               << "Synthetic deck " << nx << "x" << ny << "x" << nz
+               << " wells=" << options.wells
+               << " steps=" << options.steps
+               << " seed=" << options.seed << std::endl << std::endl
+               << "DIMENS" << std::endl
+               << " " << nx << " " << ny << " " << nz << " /" << std::endl << std::endl
+               << "OIL" << std::endl << std::endl
+               << "WATER" << std::endl << std::endl
+               << "GAS" << std::endl << std::endl
+               << "METRIC" << std::endl << std::endl
+               << "TABDIMS" << std::endl
+               << " 1 1 20 20 /" << std::endl << std::endl
+               << "EQLDIMS" << std::endl
+               << " 1 /" << std::endl << std::endl
+               << "REGDIMS" << std::endl
+               << " " << regions << " 1 /" << std::endl << std::endl
+               << "WELLDIMS" << std::endl
+               << " " << options.wells << " " << nz << " 1 " << options.wells << " /" << std::endl << std::endl
+               << "START" << std::endl
+               << " 1 'JAN' 2018 /" << std::endl << std::endl;
+            this->m_runspec = os.str();
+        }
+
+        {
+            const double dx = 100;
+            const double dy = 100;
+            const double top = 2000;
+            const double fault_throw = 10;
+            const size_t nodes = ( nx + 1 ) * ( ny + 1 );
+
+            /* depth of the layer interfaces in each pillar */
+            std::vector< double > depth( nodes * ( nz + 1 ) );
+            for( size_t j = 0; j <= ny; j++ ) {
+                for( size_t i = 0; i <= nx; i++ )
+                    depth[ i + j * ( nx + 1 ) ] = top + 0.5 * ( i + j );
+            }
+
+            for( size_t k = 1; k <= nz; k++ ) {
+                for( size_t n = 0; n < nodes; n++ )
+                    depth[ n + k * nodes ] = depth[ n + ( k - 1 ) * nodes ] + rng.uniform( 5, 15 );
+            }
+
+            std::vector< double > offset( nx, 0 );
+            for( size_t f = 0; f < options.faults; f++ ) {
+                for( size_t i = fault_index( f, options.faults, nx ); i < nx; i++ )
+                    offset[ i ] += fault_throw;
+            }
+
+            const double bottom = top + 0.5 * ( nx + ny ) + 15 * nz + fault_throw * options.faults;
+
+            std::vector< std::string > coord;
+            coord.reserve( 6 * nodes );
+            for( size_t j = 0; j <= ny; j++ ) {
+                for( size_t i = 0; i <= nx; i++ ) {
+                    for( const auto z : { top - 1, bottom + 1 } ) {
+                        coord.push_back( format( i * dx ) );
+                        coord.push_back( format( j * dy ) );
+                        coord.push_back( format( z ) );
+                    }
+                }
+            }
+
+            std::vector< std::string > zcorn;
+            zcorn.reserve( 8 * cells );
+            for( size_t k = 0; k < nz; k++ ) {
+                for( size_t layer = k; layer <= k + 1; layer++ ) {
+                    for( size_t j = 0; j < ny; j++ ) {
+                        for( size_t jj = 0; jj < 2; jj++ ) {
+                            for( size_t i = 0; i < nx; i++ ) {
+                                for( size_t ii = 0; ii < 2; ii++ ) {
+                                    const size_t node = ( i + ii ) + ( j + jj ) * ( nx + 1 );
+                                    zcorn.push_back( format( depth[ node + layer * nodes ] + offset[ i ] ) );
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            std::ostringstream os;
+            os << "SPECGRID" << std::endl
+               << " " << nx << " " << ny << " " << nz << " 1 F /" << std::endl << std::endl;
+            write_array( os, "COORD", coord );
+            write_array( os, "ZCORN", zcorn );
+            this->m_geometry = os.str();
+        }
+
+        {
+            std::ostringstream os;
+            write_array( os, "PORO",  random_array( rng, cells, repeat, 0.10, 0.35 ) );
+            write_array( os, "PERMX", random_array( rng, cells, repeat, 10, 1000 ) );
+            write_array( os, "PERMY", random_array( rng, cells, repeat, 10, 1000 ) );
+            write_array( os, "PERMZ", random_array( rng, cells, repeat, 1, 100 ) );
+            write_array( os, "NTG",   random_array( rng, cells, repeat, 0.5, 1.0 ) );
+
+            std::vector< std::string > multnum;
+            multnum.reserve( cells );
+            for( size_t g = 0; g < cells; g++ )
+                multnum.push_back( std::to_string( 1 + ( g % nx ) * regions / nx ) );
+            write_array( os, "MULTNUM", multnum );
+
+            if( options.faults > 0 ) {
+                os << "FAULTS" << std::endl;
+                for( size_t f = 0; f < options.faults; f++ ) {
+                    const auto i = fault_index( f, options.faults, nx );
+                    os << " 'F" << f + 1 << "' " << i << " " << i
+                       << " 1 " << ny << " 1 " << nz << " 'X' /" << std::endl;
+                }
+                os << "/" << std::endl << std::endl;
+
+                os << "MULTFLT" << std::endl;
+                for( size_t f = 0; f < options.faults; f++ )
+                    os << " 'F" << f + 1 << "' " << format( rng.uniform( 0.01, 1 ) ) << " /" << std::endl;
+                os << "/" << std::endl << std::endl;
+            }
+
+            if( regions > 1 ) {
+                os << "MULTREGT" << std::endl;
+                for( size_t region = 1; region < regions; region++ )
+                    os << " " << region << " " << region + 1 << " "
+                       << format( rng.uniform( 0.1, 1 ) ) << " XYZ ALL M /" << std::endl;
+                os << "/" << std::endl << std::endl;
+            }
+
+            this->m_properties = os.str();
+        }
+
+        this->m_props =
+            "SWOF\n"
+            " 0.2000 0.0000 1.0000 0.0000\n"
+            " 0.4000 0.0500 0.6000 0.0000\n"
+            " 0.6000 0.2000 0.2500 0.0000\n"
+            " 0.8000 0.5000 0.0500 0.0000\n"
+            " 1.0000 1.0000 0.0000 0.0000 /\n\n"
+            "SGOF\n"
+            " 0.0000 0.0000 1.0000 0.0000\n"
+            " 0.2000 0.0500 0.5000 0.0000\n"
+            " 0.4000 0.2000 0.1500 0.0000\n"
+            " 0.8000 0.7000 0.0000 0.0000 /\n\n"
+            "PVDO\n"
+            " 100.0 1.2000 1.0000\n"
+            " 200.0 1.1800 1.1000\n"
+            " 300.0 1.1600 1.2000 /\n\n"
+            "PVDG\n"
+            " 100.0 0.0100 0.0150\n"
+            " 200.0 0.0050 0.0200\n"
+            " 300.0 0.0035 0.0250 /\n\n"
+            "PVTW\n"
+            " 250.0 1.03 4.5E-05 0.5 0.0 /\n\n"
+            "DENSITY\n"
+            " 850.0 1000.0 0.9 /\n\n"
+            "ROCK\n"
+            " 250.0 4.0E-05 /\n\n";
+
+        {
+            std::ostringstream os;
+            os << "SATNUM" << std::endl << " " << cells << "*1 /" << std::endl << std::endl
+               << "PVTNUM" << std::endl << " " << cells << "*1 /" << std::endl << std::endl;
+
+            std::vector< std::string > fipnum;
+            fipnum.reserve( cells );
+            for( size_t g = 0; g < cells; g++ )
+                fipnum.push_back( std::to_string( 1 + ( ( g / nx ) % ny ) * regions / ny ) );
+            write_array( os, "FIPNUM", fipnum );
+            this->m_regions = os.str();
+        }
+
+        this->m_solution =
+            "EQUIL\n"
+            " 2050.0 250.0 2100.0 0.0 2000.0 0.0 /\n\n";
+
+        this->m_summary =
+            "FOPR\n\n"
+            "FWPR\n\n"
+            "FGPR\n\n"
+            "WOPR\n"
+            "/\n\n"
+            "WBHP\n"
+            "/\n\n";
+
+        {
+            std::vector< size_t > columns( nx * ny );
+            for( size_t c = 0; c < columns.size(); c++ )
+                columns[ c ] = c;
+
+            for( size_t w = 0; w < options.wells; w++ )
+                std::swap( columns[ w ], columns[ w + rng.index( columns.size() - w ) ] );
+
+            std::ostringstream os;
+            os << "WELSPECS" << std::endl;
+            for( size_t w = 0; w < options.wells; w++ )
+                os << " 'P" << w + 1 << "' 'G1' "
+                   << columns[ w ] % nx + 1 << " " << columns[ w ] / nx + 1
+                   << " 1* 'OIL' /" << std::endl;
+            os << "/" << std::endl << std::endl;
+
+            os << "COMPDAT" << std::endl;
+            for( size_t w = 0; w < options.wells; w++ )
+                os << " 'P" << w + 1 << "' "
+                   << columns[ w ] % nx + 1 << " " << columns[ w ] / nx + 1
+                   << " 1 " << nz << " 'OPEN' 2* 0.2 /" << std::endl;
+            os << "/" << std::endl << std::endl;
+
+            for( size_t step = 0; step < options.steps; step++ ) {
+                if( options.wells > 0 ) {
+                    os << "WCONHIST" << std::endl;
+                    for( size_t w = 0; w < options.wells; w++ )
+                        os << " 'P" << w + 1 << "' 'OPEN' 'RESV' "
+                           << format( rng.uniform( 100, 1000 ) ) << " "
+                           << format( rng.uniform( 0, 500 ) ) << " "
+                           << format( rng.uniform( 1000, 100000 ) ) << " /" << std::endl;
+                    os << "/" << std::endl << std::endl;
+                }
+
+                os << "TSTEP" << std::endl
+                   << " 30 /" << std::endl << std::endl;
+            }
+
+            this->m_schedule = os.str();
+        }
+    }
+
+    const SyntheticDeck::Options& SyntheticDeck::options() const {
+        return this->m_options;
+    }
+
+    const std::string& SyntheticDeck::runspec() const {
+        return this->m_runspec;
+    }
+
+    const std::string& SyntheticDeck::geometry() const {
+        return this->m_geometry;
+    }
+
+    const std::string& SyntheticDeck::properties() const {
+        return this->m_properties;
+    }
+
+    const std::string& SyntheticDeck::props() const {
+        return this->m_props;
+    }
+
+    const std::string& SyntheticDeck::regions() const {
+        return this->m_regions;
+    }
+
+    const std::string& SyntheticDeck::solution() const {
+        return this->m_solution;
+    }
+
+    const std::string& SyntheticDeck::summary() const {
+        return this->m_summary;
+    }
+
+    const std::string& SyntheticDeck::schedule() const {
+        return this->m_schedule;
+    }
+
+    std::string SyntheticDeck::str() const {
+        return "RUNSPEC\n\n" + this->m_runspec
+             + "GRID\n\n" + this->m_geometry + this->m_properties
+             + "PROPS\n\n" + this->m_props
+             + "REGIONS\n\n" + this->m_regions
+             + "SOLUTION\n\n" + this->m_solution
+             + "SUMMARY\n\n" + this->m_summary
+             + "SCHEDULE\n\n" + this->m_schedule;
+    }
+
+    void SyntheticDeck::write( const std::string& filename ) const {
+        std::ofstream stream( filename );
+        if( !stream )
+            throw std::runtime_error( "Could not open file: " + filename );
+
+        stream << this->str();
+    }
+
+    void SyntheticDeck::writeSplit( const std::string& filename ) const {
+        const boost::filesystem::path path( filename );
+        const auto base = path.stem().string();
+
+        const auto write_file = [&path]( const std::string& name, const std::string& content ) {
+            const auto include = path.parent_path() / name;
+            std::ofstream stream( include.string() );
+            if( !stream )
+                throw std::runtime_error( "Could not open file: " + include.string() );
+            stream << content;
+        };
+
+        write_file( base + "_GRID.INC", this->m_geometry );
+        write_file( base + "_PROPS.INC", this->m_properties );
+        write_file( base + "_SCHEDULE.INC", this->m_schedule );
+
+        const auto include = []( const std::string& name ) {
+            return "INCLUDE\n '" + name + "' /\n\n";
+        };
+
+        write_file( path.filename().string(),
+                    "RUNSPEC\n\n" + this->m_runspec
+                    + "GRID\n\n" + include( base + "_GRID.INC" ) + include( base + "_PROPS.INC" )
+                    + "PROPS\n\n" + this->m_props
+                    + "REGIONS\n\n" + this->m_regions
+                    + "SOLUTION\n\n" + this->m_solution
+                    + "SUMMARY\n\n" + this->m_summary
+                    + "SCHEDULE\n\n" + include( base + "_SCHEDULE.INC" ) );
+    }
+}
@@ -0,0 +1,132 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+
+#include <opm/parser/eclipse/Utility/TaskGraph.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
+
+namespace Opm {
+
+    size_t TaskGraph::add( const std::string& name,
+                           Task task,
+                           const std::vector< size_t >& dependencies ) {
+        const size_t index = this->m_nodes.size();
+        for( const auto dependency : dependencies ) {
+            if( dependency >= index )
+                throw std::invalid_argument( "Task " + name + " depends on a task which has not been added" );
+        }
+
+        for( const auto dependency : dependencies )
+            this->m_nodes[ dependency ].dependents.push_back( index );
+
+        this->m_nodes.push_back( { name, std::move( task ), dependencies.size(), {} } );
+        return index;
+    }
+
+    size_t TaskGraph::size() const {
+        return this->m_nodes.size();
+    }
+
+    void TaskGraph::run( size_t num_threads ) {
+        const size_t size = this->m_nodes.size();
+        if( size == 0 ) return;
+
+        if( num_threads == 0 )
+            num_threads = std::max( 1U, std::thread::hardware_concurrency() );
+        num_threads = std::min( num_threads, size );
+
+        std::vector< size_t > remaining( size );
+        std::vector< bool > skip( size, false );
+        std::vector< std::exception_ptr > errors( size );
+        std::priority_queue< size_t, std::vector< size_t >, std::greater< size_t > > ready;
+        size_t finished = 0;
+
+        for( size_t i = 0; i < size; i++ ) {
+            remaining[ i ] = this->m_nodes[ i ].num_dependencies;
+            if( remaining[ i ] == 0 )
+                ready.push( i );
+        }
+
+        std::mutex mutex;
+        std::condition_variable cv;
+
+        /*
+          The ready task which was added first is run first, so that one
+          thread runs the tasks in the order of add(); a task which is
+          skipped, or throws, marks its dependents as skipped.
+        */
+        const auto worker = [&] {
+            std::unique_lock< std::mutex > lock( mutex );
+            while( true ) {
+                cv.wait( lock, [&] { return !ready.empty() || finished == size; } );
+                if( ready.empty() ) return;
+
+                const size_t index = ready.top();
+                ready.pop();
+                const auto& node = this->m_nodes[ index ];
+
+                if( !skip[ index ] ) {
+                    lock.unlock();
+                    try {
+                        Trace::Span span( node.name, "task" );
+                        node.task();
+                    } catch( ... ) {
+                        errors[ index ] = std::current_exception();
+                    }
+                    lock.lock();
+                }
+
+                const bool failed = skip[ index ] || errors[ index ];
+                for( const auto dependent : node.dependents ) {
+                    if( failed )
+                        skip[ dependent ] = true;
+
+                    if( --remaining[ dependent ] == 0 )
+                        ready.push( dependent );
+                }
+
+                finished++;
+                cv.notify_all();
+            }
+        };
+
+        std::vector< std::thread > threads;
+        for( size_t t = 1; t < num_threads; t++ )
+            threads.emplace_back( worker );
+
+        worker();
+        for( auto& thread : threads )
+            thread.join();
+
+        for( const auto& error : errors ) {
+            if( error )
+                std::rethrow_exception( error );
+        }
+    }
+
+}
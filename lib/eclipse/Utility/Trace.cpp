@@ -0,0 +1,250 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <opm/parser/eclipse/Utility/Trace.hpp>
+
+namespace Opm {
+namespace Trace {
+
+namespace {
+
+    struct event {
+        std::string name;
+        std::string detail;
+        const char* category;
+        int64_t start;
+        int64_t duration;
+        int tid;
+    };
+
+    struct recorder {
+        recorder() : epoch( std::chrono::steady_clock::now() ) {
+            const char* env = std::getenv( "OPM_TRACE_FILE" );
+            if( env && *env ) {
+                this->filename = env;
+                this->active = true;
+            }
+        }
+
+        ~recorder() {
+            if( !this->active || this->events.size() == this->saved ) return;
+
+            try {
+                this->save();
+            } catch( const std::exception& ) {
+                /* there is nobody to report the error to at exit */
+            }
+        }
+
+        /* must be called with the mutex held */
+        void save();
+
+        int64_t now() const {
+            using namespace std::chrono;
+            return duration_cast< microseconds >( steady_clock::now() - this->epoch ).count();
+        }
+
+        /* must be called with the mutex held */
+        int thread_index() {
+            const auto id = std::this_thread::get_id();
+            const auto iter = this->threads.find( id );
+            if( iter != this->threads.end() ) return iter->second;
+
+            const int index = this->threads.size() + 1;
+            this->threads.emplace( id, index );
+            return index;
+        }
+
+        std::atomic< bool > active{ false };
+        std::mutex mutex;
+        std::string filename;
+        std::vector< event > events;
+        size_t saved = 0;
+        std::map< std::thread::id, int > threads;
+        const std::chrono::steady_clock::time_point epoch;
+    };
+
+    recorder& instance() {
+        static recorder rec;
+        return rec;
+    }
+
+    void write_escaped( std::ostream& os, const std::string& str ) {
+        os << '"';
+        for( const char c : str ) {
+            switch( c ) {
+                case '"':  os << "\\\""; break;
+                case '\\': os << "\\\\"; break;
+                case '\n': os << "\\n";  break;
+                case '\t': os << "\\t";  break;
+                default:
+                    if( static_cast< unsigned char >( c ) < 0x20 ) {
+                        char buffer[ 8 ];
+                        std::snprintf( buffer, sizeof( buffer ), "\\u%04x", c );
+                        os << buffer;
+                    } else
+                        os << c;
+            }
+        }
+        os << '"';
+    }
+
+    void write_events( std::ostream& os, const std::vector< event >& events ) {
+        os << "{\"traceEvents\":[";
+        bool first = true;
+        for( const auto& ev : events ) {
+            if( !first ) os << ",";
+            first = false;
+
+            os << "\n{\"name\":";
+            write_escaped( os, ev.name );
+            os << ",\"cat\":\"" << ev.category << "\""
+               << ",\"ph\":\"X\""
+               << ",\"ts\":" << ev.start
+               << ",\"dur\":" << ev.duration
+               << ",\"pid\":1"
+               << ",\"tid\":" << ev.tid;
+
+            if( !ev.detail.empty() ) {
+                os << ",\"args\":{\"detail\":";
+                write_escaped( os, ev.detail );
+                os << "}";
+            }
+            os << "}";
+        }
+        os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+    }
+
+    /*
+      The trace file is one JSON document, so it is rewritten with all the
+      events recorded so far; the events are kept until clear().
+    */
+    void recorder::save() {
+        if( this->filename.empty() ) return;
+
+        std::ofstream stream( this->filename );
+        if( !stream )
+            throw std::runtime_error( "Could not open trace file: " + this->filename );
+
+        write_events( stream, this->events );
+        this->saved = this->events.size();
+    }
+
+}
+
+    void enable( const std::string& filename ) {
+        auto& rec = instance();
+        std::lock_guard< std::mutex > lock( rec.mutex );
+        rec.filename = filename;
+        rec.active = true;
+    }
+
+    void disable() {
+        instance().active = false;
+    }
+
+    bool enabled() {
+        return instance().active.load( std::memory_order_relaxed );
+    }
+
+    void flush() {
+        auto& rec = instance();
+        std::lock_guard< std::mutex > lock( rec.mutex );
+        rec.save();
+    }
+
+    void write( std::ostream& os ) {
+        auto& rec = instance();
+        std::lock_guard< std::mutex > lock( rec.mutex );
+        write_events( os, rec.events );
+    }
+
+    size_t size() {
+        auto& rec = instance();
+        std::lock_guard< std::mutex > lock( rec.mutex );
+        return rec.events.size();
+    }
+
+    void clear() {
+        auto& rec = instance();
+        std::lock_guard< std::mutex > lock( rec.mutex );
+        rec.events.clear();
+        rec.saved = 0;
+    }
+
+    Span::Span( const char* name, const char* category ) :
+        m_active( enabled() ),
+        m_category( category ),
+        m_start( 0 )
+    {
+        if( !this->m_active ) return;
+        this->m_name = name;
+        this->m_start = instance().now();
+    }
+
+    Span::Span( const std::string& name, const char* category ) :
+        m_active( enabled() ),
+        m_category( category ),
+        m_start( 0 )
+    {
+        if( !this->m_active ) return;
+        this->m_name = name;
+        this->m_start = instance().now();
+    }
+
+    Span::Span( const std::string& name, const char* category, const std::string& detail ) :
+        m_active( enabled() ),
+        m_category( category ),
+        m_start( 0 )
+    {
+        if( !this->m_active ) return;
+        this->m_name = name;
+        this->m_detail = detail;
+        this->m_start = instance().now();
+    }
+
+    Span::~Span() {
+        if( !this->m_active ) return;
+
+        auto& rec = instance();
+        const auto end = rec.now();
+
+        std::lock_guard< std::mutex > lock( rec.mutex );
+        rec.events.push_back( { std::move( this->m_name ),
+                                std::move( this->m_detail ),
+                                this->m_category,
+                                this->m_start,
+                                end - this->m_start,
+                                rec.thread_index() } );
+    }
+
+}
+}
@@ -31,6 +31,7 @@
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Units/UnitSystem.hpp>
 #include <opm/parser/eclipse/Parser/MessageContainer.hpp>
+#include <opm/parser/eclipse/Parser/ParseStatistics.hpp>
 
 #ifdef OPM_PARSER_DECK_API_WARNING
 #ifndef OPM_PARSER_DECK_API
@@ -55,6 +56,8 @@ namespace Opm {
      * alive as long as DeckItem (and friends) are needed, to avoid
      * use-after-free.
      */
+    class BinaryReader;
+    class BinaryWriter;
     class DeckOutput;
 
     class DeckView {
@@ -131,6 +134,16 @@ namespace Opm {
             Deck( std::initializer_list< std::string > );
 
             Deck( const Deck& );
+            Deck( Deck&& );
+
+            /*
+              Read a deck written with serialize(), e.g. on the other
+              ranks of a parallel run, which can then build the
+              EclipseState and Schedule without parsing the input
+              again. The messages and parse statistics are not part of
+              the serialized deck.
+            */
+            explicit Deck( BinaryReader& reader );
 
             void addKeyword( DeckKeyword&& keyword );
             void addKeyword( const DeckKeyword& keyword );
@@ -146,9 +159,19 @@ namespace Opm {
             const std::string getDataFile() const;
             void setDataFile(const std::string& dataFile);
 
+            /*
+              The parse statistics are only present if the deck was
+              parsed with profiling enabled, see Parser::setProfiling().
+            */
+            bool hasParseStatistics() const;
+            const ParseStatistics& getParseStatistics() const;
+            ParseStatistics& getParseStatistics();
+            void setParseStatistics( std::shared_ptr< ParseStatistics > statistics );
+
             iterator begin();
             iterator end();
             void write( DeckOutput& output ) const ;
+            void serialize( BinaryWriter& writer ) const;
             friend std::ostream& operator<<(std::ostream& os, const Deck& deck);
         private:
             Deck( std::vector< DeckKeyword >&& );
@@ -159,6 +182,7 @@ namespace Opm {
             UnitSystem activeUnits;
 
             std::string m_dataFile;
+            std::shared_ptr< ParseStatistics > m_statistics;
     };
 }
 #endif  /* DECK_HPP */
@@ -20,6 +20,7 @@
 #ifndef DECKITEM_HPP
 #define DECKITEM_HPP
 
+#include <atomic>
 #include <string>
 #include <vector>
 #include <memory>
@@ -29,6 +30,8 @@
 #include <opm/parser/eclipse/Utility/Typetools.hpp>
 
 namespace Opm {
+    class BinaryReader;
+    class BinaryWriter;
     class DeckOutput;
 
     class DeckItem {
@@ -40,6 +43,26 @@ namespace Opm {
         DeckItem( const std::string&, double, size_t size_hint = 8 );
         DeckItem( const std::string&, std::string, size_t size_hint = 8 );
 
+        /*
+          An item with all the values of data, none of them defaulted;
+          used for arrays which are read from binary files.
+        */
+        DeckItem( const std::string&, std::vector< int >&& data );
+        DeckItem( const std::string&, std::vector< double >&& data );
+
+        /* Read an item written with serialize(). */
+        explicit DeckItem( BinaryReader& reader );
+
+        /*
+          The SI values are converted on the first call to
+          getSIDoubleData(), which is safe to call concurrently from
+          several threads; copying an item takes the same lock.
+        */
+        DeckItem( const DeckItem& other );
+        DeckItem( DeckItem&& other ) noexcept;
+        DeckItem& operator=( const DeckItem& other );
+        DeckItem& operator=( DeckItem&& other ) noexcept;
+
         const std::string& name() const;
 
         // return true if the default value was used for a given data point
@@ -65,6 +88,13 @@ namespace Opm {
         template< typename T > const std::vector< T >& getData() const;
         const std::vector< double >& getSIDoubleData() const;
 
+        /*
+          Move the SI converted data out of the item; the conversion is
+          done in place, so the data is never held twice. The item is
+          left without values.
+        */
+        std::vector< double > releaseSIDoubleData();
+
         void push_back( int );
         void push_back( double );
         void push_back( std::string );
@@ -83,6 +113,7 @@ namespace Opm {
         type_tag getType() const;
 
         void write(DeckOutput& writer) const;
+        void serialize( BinaryWriter& writer ) const;
         friend std::ostream& operator<<(std::ostream& os, const DeckItem& item);
 
 
@@ -117,6 +148,7 @@ namespace Opm {
         std::vector< bool > defaulted;
         std::vector< Dimension > dimensions;
         mutable std::vector< double > SIdata;
+        mutable std::atomic< bool > SIconverted{ false };
 
         template< typename T > std::vector< T >& value_ref();
         template< typename T > const std::vector< T >& value_ref() const;
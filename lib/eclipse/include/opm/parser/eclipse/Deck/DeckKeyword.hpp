@@ -36,6 +36,7 @@ namespace Opm {
 
         explicit DeckKeyword(const std::string& keywordName);
         DeckKeyword(const std::string& keywordName, bool knownKeyword);
+        explicit DeckKeyword(BinaryReader& reader);
 
         const std::string& name() const;
         void setFixedSize();
@@ -55,11 +56,13 @@ namespace Opm {
         const std::vector<int>& getIntData() const;
         const std::vector<double>& getRawDoubleData() const;
         const std::vector<double>& getSIDoubleData() const;
+        std::vector<double> releaseSIDoubleData();
         const std::vector<std::string>& getStringData() const;
         size_t getDataSize() const;
         void write( DeckOutput& output ) const;
         void write_data( DeckOutput& output ) const;
         void write_TITLE( DeckOutput& output ) const;
+        void serialize( BinaryWriter& writer ) const;
 
         template <class Keyword>
         bool isKeyword() const {
@@ -35,6 +35,7 @@ namespace Opm {
 
         DeckRecord() = default;
         DeckRecord( std::vector< DeckItem >&& );
+        explicit DeckRecord( BinaryReader& reader );
 
         size_t size() const;
         void addItem( DeckItem deckItem );
@@ -64,6 +65,7 @@ namespace Opm {
 
         void write(DeckOutput& writer) const;
         void write_data(DeckOutput& writer) const;
+        void serialize( BinaryWriter& writer ) const;
         friend std::ostream& operator<<(std::ostream& os, const DeckRecord& record);
 
         bool equal(const DeckRecord& other, bool cmp_default, bool cmp_numeric) const;
@@ -32,6 +32,8 @@
 
 namespace Opm {
 
+    class BinaryReader;
+    class BinaryWriter;
     class Box;
     class BoxManager;
     class Deck;
@@ -43,15 +45,29 @@ namespace Opm {
     class TableManager;
     class UnitSystem;
 
+    namespace Trace { class Span; }
+
     /// Class representing properties on 3D grid for use in EclipseState.
     class Eclipse3DProperties
     {
     public:
 
         Eclipse3DProperties() = default;
+
+        /*
+          If reader is not null the properties are read from it, as
+          written by serialize(), instead of being processed from the
+          GRID, EDIT, PROPS and REGIONS sections of the deck.
+        */
         Eclipse3DProperties(const Deck& deck,
                             const TableManager& tableManager,
-                            const EclipseGrid& eclipseGrid);
+                            const EclipseGrid& eclipseGrid,
+                            BinaryReader* reader = nullptr);
+
+        Eclipse3DProperties(const Eclipse3DProperties& other);
+        Eclipse3DProperties& operator=(const Eclipse3DProperties& other);
+        Eclipse3DProperties(Eclipse3DProperties&& other) = default;
+        Eclipse3DProperties& operator=(Eclipse3DProperties&& other) = default;
 
 
         std::vector< int > getRegions( const std::string& keyword ) const;
@@ -68,7 +84,30 @@ namespace Opm {
         bool supportsGridProperty(const std::string& keyword) const;
         MessageContainer getMessageContainer();
 
+        /*
+          The properties which are not in the deck are created, and the
+          post processors are run, on first access. The const methods
+          are safe to call from several threads; finalize() runs the
+          post processors of all the properties created so far, and
+          creates PORV and ACTNUM, so that concurrent readers of those
+          properties do not contend for the lock. After finalize() the
+          getKeyword() method of getIntProperties() and
+          getDoubleProperties() throws for a missing property instead of
+          creating it.
+        */
+        void finalize() const;
+
+        /* Write all the properties, after running finalize(). */
+        void serialize(BinaryWriter& writer) const;
+
     private:
+        /* The span covers the construction of the members. */
+        Eclipse3DProperties(const Deck& deck,
+                            const TableManager& tableManager,
+                            const EclipseGrid& eclipseGrid,
+                            BinaryReader* reader,
+                            const Trace::Span&);
+
         const GridProperty<int>& getRegion(const DeckItem& regionItem) const;
         void processGridProperties(const Deck& deck,
                                    const EclipseGrid& eclipseGrid);
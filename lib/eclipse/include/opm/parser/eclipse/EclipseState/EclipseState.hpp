@@ -25,9 +25,13 @@
 
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/EclipseConfig.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/ConnectionGraph.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaultCollection.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaultIndex.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/Partition.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/PinchProcessor.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/TransMult.hpp>
 #include <opm/parser/eclipse/EclipseState/Runspec.hpp>
 #include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
@@ -40,6 +44,8 @@ namespace Opm {
     template< typename > class GridProperty;
     template< typename > class GridProperties;
 
+    class BinaryReader;
+    class BinaryWriter;
     class Box;
     class BoxManager;
     class Deck;
@@ -56,6 +62,8 @@ namespace Opm {
     class TableManager;
     class UnitSystem;
 
+    namespace Trace { class Span; }
+
     class EclipseState {
     public:
         enum EnabledTypes {
@@ -65,8 +73,33 @@ namespace Opm {
             AllProperties = IntProperties | DoubleProperties
         };
 
+        /// The members which only depend on the deck - the tables, the
+        /// NNC and the grid - are built concurrently, see Inputs; the
+        /// messages are collected in the same order as when they are
+        /// built in sequence.
         EclipseState(const Deck& deck , ParseContext parseContext = ParseContext());
 
+        /// The members which only depend on the deck. They can be built
+        /// up front, e.g. from the first sections of the deck while the
+        /// schedule is parsed, see StateLoader; the ones which are not
+        /// set are built concurrently from the deck.
+        struct Inputs {
+            std::unique_ptr< TableManager > tables;
+            std::unique_ptr< NNC > nnc;
+            std::unique_ptr< EclipseGrid > grid;
+        };
+
+        EclipseState(const Deck& deck, ParseContext parseContext, Inputs&& inputs);
+
+        /// Read the state written by serialize() for the same deck,
+        /// e.g. a deck read with Deck(BinaryReader&) on the other ranks
+        /// of a parallel run. The grid, NNC, 3D properties and
+        /// transmissibility multipliers are read instead of computed;
+        /// the COORD and ZCORN arrays of the grid point into the buffer
+        /// if the reader owns it. The messages of the grid and the
+        /// properties are not serialized.
+        EclipseState(const Deck& deck, ParseContext parseContext, BinaryReader& reader);
+
         const ParseContext& getParseContext() const;
         const IOConfig& getIOConfig() const;
         IOConfig& getIOConfig();
@@ -79,6 +112,8 @@ namespace Opm {
         const EclipseGrid& getInputGrid() const;
 
         const FaultCollection& getFaults() const;
+        /// the faults of the faces, as indices into getFaults()
+        const FaultIndex& getFaultIndex() const;
         const TransMult& getTransMult() const;
 
         /// non-neighboring connections
@@ -86,6 +121,18 @@ namespace Opm {
         const NNC& getInputNNC() const;
         bool hasInputNNC() const;
 
+        /// The connections between the active cells, with the
+        /// transmissibility multipliers applied; see ConnectionGraph.
+        ConnectionGraph getConnectionGraph() const;
+
+        /// The cells removed by MINPV and PINCH, and the vertical
+        /// connections across them; see PinchProcessor.
+        PinchProcessor getPinchProcessor() const;
+
+        /// The active cells of rank, given the owning rank of each
+        /// active cell, e.g. from Partition::bisect().
+        Partition getPartition( const std::vector< int >& owner, int rank ) const;
+
         const Eclipse3DProperties& get3DProperties() const;
         const TableManager& getTableManager() const;
         const EclipseConfig& getEclipseConfig() const;
@@ -106,7 +153,27 @@ namespace Opm {
 
         const Runspec& runspec() const;
 
+        /// Compute the state which is otherwise created on first use:
+        /// the grid geometry and locator, and the PORV, ACTNUM and the
+        /// post processed grid properties. The const methods are safe
+        /// to call concurrently with or without finalize(); it only
+        /// moves the work out of the concurrent phase.
+        void finalize() const;
+
+        /// Write the grid, the NNC, the 3D properties and the
+        /// transmissibility multipliers, after running finalize(). The
+        /// rest of the state is built from the deck, which is
+        /// serialized on its own with Deck::serialize().
+        void serialize(BinaryWriter& writer) const;
+
     private:
+        /* The span covers the construction of the members. */
+        EclipseState(const Deck& deck, ParseContext parseContext, Inputs&& inputs, BinaryReader* reader,
+                     const Trace::Span&);
+
+        static Inputs& buildInputs(const Deck& deck, Inputs& inputs);
+        static Inputs readInputs(BinaryReader& reader);
+
         void initIOConfigPostSchedule(const Deck& deck);
         void initTransMult();
         void initFaults(const Deck& deck);
@@ -128,6 +195,7 @@ namespace Opm {
         TransMult m_transMult;
 
         FaultCollection m_faults;
+        FaultIndex m_faultIndex;
         std::string m_title;
 
         MessageContainer m_messageContainer;
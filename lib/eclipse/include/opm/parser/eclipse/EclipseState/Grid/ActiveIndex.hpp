@@ -0,0 +1,89 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARSER_ACTIVE_INDEX_HPP
+#define OPM_PARSER_ACTIVE_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      The ActiveIndex class is the mapping between global and active cell
+      indices. ACTNUM is stored as a bitset, with the number of active
+      cells before each 64 bit word stored alongside, so the active index
+      of a global cell is found with one popcount:
+
+          activeIndex( g ) = rank[ g / 64 ] + popcount( bits[ g / 64 ] & mask )
+
+      The inverse mapping is a dense array of global indices. The memory
+      use is 1.5 bits per cell plus one int per active cell, and both
+      lookups are O(1). The index is built once, in parallel, and is
+      immutable afterwards; it is therefore safe to use from several
+      threads concurrently.
+    */
+
+    class ActiveIndex {
+    public:
+        ActiveIndex() = default;
+
+        /*
+          The actnum pointer must point to size values, where a cell is
+          active if the value is positive. If actnum is null all cells
+          are active.
+        */
+        ActiveIndex( size_t size, const int* actnum );
+
+        size_t size() const;
+        size_t numActive() const;
+        bool allActive() const;
+
+        bool active( size_t globalIndex ) const;
+
+        /*
+          The active index of the cell, the result is undefined if the
+          cell is not active.
+        */
+        size_t activeIndex( size_t globalIndex ) const;
+
+        /*
+          The active index of the cell, or -1 if the cell is not active.
+        */
+        int activeIndexOrNegative( size_t globalIndex ) const;
+
+        size_t globalIndex( size_t activeIndex ) const;
+
+        /*
+          The global index of each active cell.
+        */
+        const std::vector< int >& globalIndices() const;
+
+        bool operator==( const ActiveIndex& other ) const;
+
+    private:
+        size_t m_size = 0;
+        std::vector< std::uint64_t > m_bits;
+        std::vector< std::uint32_t > m_rank;
+        std::vector< int > m_global;
+    };
+}
+
+#endif
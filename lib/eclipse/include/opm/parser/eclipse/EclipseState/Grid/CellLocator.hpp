@@ -0,0 +1,118 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_PARSER_CELL_LOCATOR_HPP
+#define OPM_PARSER_CELL_LOCATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+
+namespace Opm {
+
+    /*
+      The CellLocator class answers the questions "which cell contains
+      this point" and "which cells does this line segment cross" for a
+      corner point grid.
+
+      The bounding box of the grid is divided into a uniform lattice of
+      buckets, with roughly one bucket per cell, and each cell is listed
+      in all the buckets its bounding box overlaps. A query only looks at
+      the cells of the buckets the point or segment falls in; those
+      candidates are first checked against their bounding box, and then
+      with an exact test against the trilinear hexahedron spanned by the
+      eight corners, i.e. the same cell shape as used for the volume in
+      GridGeometry.
+
+      The bounding boxes of the cells and the lists of cells in each
+      bucket are computed in parallel with OpenMP when available. The
+      locator keeps a shared reference to the COORD and ZCORN arrays of
+      the grid, or to whatever the corner function refers to.
+    */
+
+    class CellLocator : public GridDims {
+    public:
+        using point = std::array< double, 3 >;
+        using corners = GridGeometry::corners;
+
+        CellLocator( const GridDims& dims,
+                     std::shared_ptr< const std::vector< double > > coord,
+                     std::shared_ptr< const std::vector< double > > zcorn );
+
+        /* The arrays must hold the 6*(nx+1)*(ny+1) and 8*nx*ny*nz values of the grid. */
+        CellLocator( const GridDims& dims,
+                     std::shared_ptr< const double > coord,
+                     std::shared_ptr< const double > zcorn );
+
+        /*
+          For grids whose cells do not share corners with their
+          neighbours; the corner function is kept by the locator, and
+          called for the candidate cells of each query.
+        */
+        CellLocator( const GridDims& dims,
+                     GridGeometry::CornerFunction cellCorners );
+
+        /*
+          The global index of a cell containing p, or -1 if p is outside
+          the grid. A point on the face between two cells is reported in
+          the cell with the lowest global index.
+        */
+        int findCell( const point& p ) const;
+
+        /*
+          The global indices of the cells crossed by the segment from a
+          to b, ordered by where the segment enters the cell.
+        */
+        std::vector< size_t > findCells( const point& a, const point& b ) const;
+
+        /*
+          The exact tests used by the queries. contains() inverts the
+          trilinear map of the cell with Newton's method; intersects()
+          checks the segment against the six bilinear faces of the cell,
+          and returns the segment parameter t in [0,1] where the segment
+          enters the cell.
+        */
+        static bool contains( const corners& cell, const point& p );
+        static bool intersects( const corners& cell, const point& a, const point& b, double& t );
+
+    private:
+        void cellCorners( size_t g, corners& cell ) const;
+        std::array< size_t, 3 > bucket( const point& p ) const;
+        size_t bucketIndex( const std::array< size_t, 3 >& b ) const;
+        void addCandidates( size_t bucket, std::vector< size_t >& candidates ) const;
+
+        GridGeometry::CornerFunction m_cell_corners;
+
+        point m_lower;
+        point m_upper;
+        point m_bucket_size;
+        std::array< size_t, 3 > m_buckets;
+
+        /* The cells of bucket b are m_cells[ m_offsets[ b ] .. m_offsets[ b + 1 ] ). */
+        std::vector< size_t > m_offsets;
+        std::vector< size_t > m_cells;
+    };
+}
+
+#endif
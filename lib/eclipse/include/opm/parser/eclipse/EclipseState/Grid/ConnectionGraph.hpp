@@ -0,0 +1,79 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_PARSER_CONNECTION_GRAPH_HPP
+#define OPM_PARSER_CONNECTION_GRAPH_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm {
+
+    class EclipseGrid;
+    class NNC;
+    class TransMult;
+
+    /*
+      The ConnectionGraph class is the cell to cell connection graph of
+      the active cells, in compressed sparse row form. The connections
+      of active cell a are the entries [offsets()[a], offsets()[a+1]) of
+      the neighbours(), faces(), multipliers() and nncTrans() arrays:
+
+        neighbours:  The active index of the cell in the other end.
+        faces:       The FaceDir of the face of cell a the connection
+                     goes through, or 0 for an NNC.
+        multipliers: The product of the MULTX/Y/Z, MULTX-/Y-/Z-, MULTFLT
+                     and MULTREGT multipliers of the connection; for an
+                     NNC this is the MULTREGT multiplier alone, subject
+                     to the NNC behaviour of the MULTREGT record.
+        nncTrans:    The transmissibility of an NNC, and 0 for the
+                     Cartesian connections.
+
+      The graph is symmetric, i.e. each connection is listed from both
+      cells. The Cartesian connections of a cell come first, ordered by
+      the global index of the neighbour, followed by the NNCs in input
+      order; NNCs with an inactive cell, or from a cell to itself, are
+      left out. The rows are computed in parallel with OpenMP when
+      available.
+    */
+
+    class ConnectionGraph {
+    public:
+        ConnectionGraph( const EclipseGrid& grid, const TransMult& transMult, const NNC& nnc );
+
+        size_t numCells() const;
+        size_t numConnections() const;
+
+        const std::vector< size_t >& offsets() const;
+        const std::vector< int >& neighbours() const;
+        const std::vector< int >& faces() const;
+        const std::vector< double >& multipliers() const;
+        const std::vector< double >& nncTrans() const;
+
+    private:
+        std::vector< size_t > m_offsets;
+        std::vector< int > m_neighbours;
+        std::vector< int > m_faces;
+        std::vector< double > m_multipliers;
+        std::vector< double > m_nnc_trans;
+    };
+}
+
+#endif
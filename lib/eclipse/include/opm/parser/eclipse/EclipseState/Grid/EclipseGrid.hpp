@@ -23,33 +23,47 @@
 
 
 #include <opm/parser/eclipse/EclipseState/Util/Value.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/ActiveIndex.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/CellLocator.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MinpvMode.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/PinchMode.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
 
 #include <opm/parser/eclipse/Parser/MessageContainer.hpp>
 
 #include <ert/ecl/ecl_grid.h>
-#include <ert/util/ert_unique_ptr.hpp>
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace Opm {
 
+    class BinaryReader;
+    class BinaryWriter;
     class Deck;
     class ZcornMapper;
 
     /**
        About cell information and dimension: The actual grid
        information is held in a pointer to an ERT ecl_grid_type
-       instance. This pointer must be used for access to all cell
-       related properties, including:
-
-         - Size of cells
-         - Real world position of cells
-         - Active/inactive status of cells
+       instance. This pointer is used for the corner positions and for
+       input and output of the grid. A corner point grid which has
+       adopted its COORD and ZCORN buffers keeps them as they are, and
+       only creates the ERT grid when c_ptr() is called. The active/inactive status of the
+       cells is held in an ActiveIndex, which gives O(1) mappings
+       between global and active indices. The size and position of the cells are computed for all
+       cells at once by the GridGeometry class the first time they are
+       requested, and the result is kept for the lifetime of the grid.
+
+       All of this state is immutable once created, and is shared
+       between copies of the grid; copying an EclipseGrid, or creating a
+       grid with a new ACTNUM from an existing grid, is therefore cheap.
+       A change of ACTNUM replaces the ActiveIndex of the grid, and the
+       shared ERT grid is only copied if it is used afterwards.
     */
 
     class EclipseGrid : public GridDims {
@@ -73,11 +87,37 @@ namespace Opm {
                     const int * actnum = nullptr,
                     const double * mapaxes = nullptr);
 
+        /*
+          As above, but the grid takes ownership of the coord and zcorn
+          buffers instead of copying them.
+        */
+        EclipseGrid(std::array<int, 3>& dims ,
+                    std::vector<double>&& coord ,
+                    std::vector<double>&& zcorn ,
+                    const int * actnum = nullptr,
+                    const double * mapaxes = nullptr);
 
         /// EclipseGrid ignores ACTNUM in Deck, and therefore needs ACTNUM
         /// explicitly.  If a null pointer is passed, every cell is active.
         EclipseGrid(const Deck& deck, const int * actnum = nullptr);
 
+        /*
+          As above; if consumeDeck is true a corner point grid moves the
+          COORD and ZCORN data out of the deck instead of copying them,
+          and the keywords are left empty in the deck.
+        */
+        EclipseGrid(Deck& deck, const int * actnum, bool consumeDeck);
+
+        /*
+          Read a grid written with serialize(). A grid from DX/DY/DZ/TOPS
+          or DXV/DYV/DZV/DEPTHZ is created from those arrays again; any
+          other grid is read as a corner point grid, and its COORD and
+          ZCORN arrays point into the buffer if the reader owns it, see
+          BinaryReader::readShared(). Throws std::runtime_error if the
+          arrays do not match the dimensions.
+        */
+        explicit EclipseGrid(BinaryReader& reader);
+
         static bool hasCylindricalKeywords(const Deck& deck);
         static bool hasCornerPointKeywords(const Deck&);
         static bool hasCartesianKeywords(const Deck&);
@@ -107,6 +147,9 @@ namespace Opm {
         double getPinchThresholdThickness( ) const;
         PinchMode::ModeEnum getPinchOption( ) const;
         PinchMode::ModeEnum getMultzOption( ) const;
+        /* false for the PINCH control option NOGAP. */
+        bool getPinchGapMode( ) const;
+        double getPinchMaxEmptyGap( ) const;
 
         MinpvMode::ModeEnum getMinpvMode() const;
         double getMinpvValue( ) const;
@@ -151,6 +194,13 @@ namespace Opm {
         std::array<double, 3> getCellCenter(size_t i,size_t j, size_t k) const;
         std::array<double, 3> getCellCenter(size_t globalIndex) const;
         std::array<double, 3> getCornerPos(size_t i,size_t j, size_t k, size_t corner_index) const;
+        /*
+          The volume is the exact volume of the trilinear cell spanned by
+          the eight corners, see GridGeometry. For cells with planar faces
+          this is the ERT volume; for warped cells ERT approximates the
+          volume, and the two differ by up to about 1% when the corners are
+          displaced by 5% of the cell thickness.
+        */
         double getCellVolume(size_t globalIndex) const;
         double getCellVolume(size_t i , size_t j , size_t k) const;
         double getCellThicknes(size_t globalIndex) const;
@@ -163,18 +213,63 @@ namespace Opm {
         double getCellDepth(size_t globalIndex) const;
         ZcornMapper zcornMapper() const;
 
+        /*
+          The geometry of all cells, computed from the COORD and ZCORN
+          arrays of the grid on first use.
+        */
+        const GridGeometry& geometry() const;
+
+        /*
+          The spatial index used to find the cells containing a point or
+          crossed by a segment; it is built on first use, and shared
+          between copies of the grid.
+        */
+        const CellLocator& locator() const;
+
+        /*
+          The const methods of the grid can be called concurrently from
+          several threads; the state computed on first use is guarded by
+          a mutex. finalize() computes the geometry, the locator and the
+          bulk geometry vectors up front, so that concurrent readers do
+          not contend for the lock.
+        */
+        void finalize() const;
+
+        /*
+          Bulk accessors for the geometry of all cells. The vectors are
+          indexed by global index, or by active index if active_only is
+          true. They are computed in parallel on first use and kept with
+          the grid; the active vectors are recomputed after a call to
+          resetACTNUM().
+        */
+        const std::vector<double>& getCellVolumes(bool active_only = false) const;
+        const std::vector<double>& getCellDepths(bool active_only = false) const;
+        const std::vector<double>& getCellThicknesses(bool active_only = false) const;
+        const std::vector<std::array<double, 3>>& getCellCenters(bool active_only = false) const;
+        const std::vector<std::array<double, 3>>& getCellDimensions(bool active_only = false) const;
+
         /*
           The exportZCORN method will adjust the z coordinates to ensure that cells do not
           overlap. The return value is the number of points which have been adjusted.
+          The zcorn vector is overwritten in place, i.e. a vector which is
+          reused between calls is not reallocated.
         */
         size_t exportZCORN( std::vector<double>& zcorn) const;
 
+        /*
+          The number of points exportZCORN() would adjust, computed
+          without copying the z coordinates of a grid with adopted
+          buffers.
+        */
+        size_t countZCORNOverlaps() const;
+
 
         void exportMAPAXES( std::vector<double>& mapaxes) const;
         void exportCOORD( std::vector<double>& coord) const;
         void exportACTNUM( std::vector<int>& actnum) const;
         void resetACTNUM( const int * actnum);
         bool equal(const EclipseGrid& other) const;
+        void serialize(BinaryWriter& writer) const;
         const ecl_grid_type * c_ptr() const;
         const MessageContainer& getMessageContainer() const;
         MessageContainer& getMessageContainer();
@@ -186,38 +281,112 @@ namespace Opm {
         Value<double> m_pinch;
         PinchMode::ModeEnum m_pinchoutMode;
         PinchMode::ModeEnum m_multzMode;
-        mutable std::vector< int > activeMap;
+        bool m_pinchGap;
+        double m_pinchMaxEmptyGap;
+        std::shared_ptr< const ActiveIndex > m_active;
+
+        struct CellGeometry {
+            std::vector< double > volumes;
+            std::vector< double > depths;
+            std::vector< double > thicknesses;
+            std::vector< std::array< double, 3 > > centers;
+            std::vector< std::array< double, 3 > > dims;
+        };
+
+        /*
+          The state computed on first use by the const methods:
+
+            geometry, locator: See geometry() and locator(). The
+              locator of a grid without COORD and ZCORN arrays keeps a
+              reference to the ERT grid for the cell corners.
+
+            cell_geometry, active_geometry: The volumes, depths and
+              thicknesses of all cells are the GridGeometry arrays;
+              only the centers and dims are stored in cell_geometry.
+
+            grid: The ERT grid is shared between copies of the grid,
+              and is not modified once it is shared. A change of ACTNUM
+              of a grid with a shared ERT grid only marks the ERT grid
+              as stale, and c_ptr() then replaces it with a copy with
+              the current ACTNUM. The ERT grid of a corner point grid
+              with adopted buffers is created from m_coord, m_zcorn and
+              m_mapaxes on the first call to c_ptr(); the buffers are
+              shared between copies of the grid.
+
+          Since the computed state is shared between copies of the grid,
+          so is the mutex guarding it; copying the grid takes the lock,
+          so a grid can be copied while other threads are querying it.
+          The geometry and locator are also published through atomic
+          pointers, so geometry() and locator() do not lock once they
+          have been computed.
+        */
+        struct LazyState {
+            LazyState();
+            LazyState( const LazyState& other );
+            LazyState( LazyState&& other ) noexcept;
+            LazyState& operator=( const LazyState& other );
+            LazyState& operator=( LazyState&& other ) noexcept;
+
+            std::shared_ptr< std::recursive_mutex > mutex;
+            std::shared_ptr< const GridGeometry > geometry;
+            std::shared_ptr< const CellLocator > locator;
+            std::shared_ptr< CellGeometry > cell_geometry;
+            std::shared_ptr< CellGeometry > active_geometry;
+            std::shared_ptr< ecl_grid_type > grid;
+            bool grid_actnum_stale = false;
+
+            std::atomic< const GridGeometry* > geometry_ptr;
+            std::atomic< const CellLocator* > locator_ptr;
+        };
+
+        mutable LazyState m_lazy;
         bool m_circle = false;
 
         /*
-          The internal class grid_ptr is a a std::unique_ptr with
-          special copy semantics. The purpose of implementing this is
-          that the EclipseGrid class can now use the default
-          implementation for the copy and move constructors.
+          The COORD and ZCORN arrays of a corner point grid with adopted
+          buffers; the sizes follow from the dimensions. They point into
+          vectors owned by the grid, or into the buffer of a grid read
+          with EclipseGrid(BinaryReader&).
+        */
+        std::shared_ptr< const double > m_coord;
+        std::shared_ptr< const double > m_zcorn;
+        std::vector< double > m_mapaxes;
+
+        /*
+          The input arrays of a grid created by ERT from DX, DY, DZ and
+          TOPS, or from DXV, DYV, DZV and DEPTHZ. The cells of these grids
+          need not share corners with their neighbours, so they can not
+          be written as COORD and ZCORN; serialize() writes the input
+          arrays instead, and the reader creates the ERT grid from them.
         */
-        using ert_ptr = ERT::ert_unique_ptr<ecl_grid_type , ecl_grid_free>;
-        class grid_ptr : public ert_ptr {
-        public:
-            using ert_ptr::unique_ptr;
-            grid_ptr() = default;
-            grid_ptr(grid_ptr&&) = default;
-            grid_ptr(const grid_ptr& src) :
-                ert_ptr( ecl_grid_alloc_copy( src.get() ) ) {}
+        struct CartesianInput {
+            bool depthz;
+            std::array< std::vector< double >, 4 > arrays;
         };
-        grid_ptr m_grid;
+        std::shared_ptr< const CartesianInput > m_cartesian;
 
         void initCornerPointGrid(const std::array<int,3>& dims ,
-                                 const std::vector<double>& coord ,
-                                 const std::vector<double>& zcorn ,
+                                 const double * coord ,
+                                 const double * zcorn ,
                                  const int * actnum,
-                                 const double * mapaxes);
-
+                                 const double * mapaxes) const;
+
+        void adoptCornerPointGrid(std::vector<double>&& coord ,
+                                  std::vector<double>&& zcorn ,
+                                  const int * actnum,
+                                  const double * mapaxes);
+
+        void initCartesianInput(std::shared_ptr< const CartesianInput > input, const int * actnum);
+        void initDeckGrid(const Deck& deck, const int * actnum, Deck * consumeDeck);
+        CellGeometry& cellGeometry(bool active_only) const;
+        void initActiveIndex();
+        void initBinaryGrid(            const std::array<int, 3>&, const Deck&);
         void initCylindricalGrid(       const std::array<int, 3>&, const Deck&);
         void initCartesianGrid(         const std::array<int, 3>&, const Deck&);
-        void initCornerPointGrid(       const std::array<int, 3>&, const Deck&);
+        void initCornerPointGrid(       const std::array<int, 3>&, const Deck&, Deck * consumeDeck);
         void initDTOPSGrid(             const std::array<int, 3>&, const Deck&);
         void initDVDEPTHZGrid(          const std::array<int, 3>&, const Deck&);
-        void initGrid(                  const std::array<int, 3>&, const Deck&);
+        void initGrid(                  const std::array<int, 3>&, const Deck&, Deck * consumeDeck);
         void assertCornerPointKeywords( const std::array<int, 3>&, const Deck&);
 
         static bool hasDVDEPTHZKeywords(const Deck&);
@@ -273,7 +442,21 @@ namespace Opm {
         */
         size_t fixupZCORN( std::vector<double>& zcorn);
         bool validZCORN( const std::vector<double>& zcorn) const;
+
+        /*
+          The pointer versions of fixupZCORN() and validZCORN() work on a
+          caller owned buffer of size() elements. The four corner columns
+          of each pillar are independent, and are processed in parallel.
+          countOverlaps() returns the number of points fixupZCORN() would
+          adjust, without modifying the buffer.
+        */
+        size_t fixupZCORN( double* zcorn ) const;
+        size_t countOverlaps( const double* zcorn ) const;
+        bool validZCORN( const double* zcorn ) const;
     private:
+        template< typename T >
+        size_t processZCORN( T* zcorn ) const;
+
         std::array<size_t,3> dims;
         std::array<size_t,3> stride;
         std::array<size_t,8> cell_shift;
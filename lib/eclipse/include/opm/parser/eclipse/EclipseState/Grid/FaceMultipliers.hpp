@@ -0,0 +1,105 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_PARSER_FACE_MULTIPLIERS_HPP
+#define OPM_PARSER_FACE_MULTIPLIERS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+    class BinaryReader;
+    class BinaryWriter;
+
+    /*
+      The transmissibility multipliers through one face direction of all
+      the cells in the grid, where most multipliers are typically 1.
+
+      The multipliers are stored either dense, as one value per cell, or
+      sparse, as a sorted list of the cells with a multiplier different
+      from 1. The representation is chosen after every update from the
+      fill ratio: the sparse form is used as long as at most one cell in
+      eight has a multiplier, i.e. while it takes less than a quarter of
+      the memory of the dense form.
+    */
+    class FaceMultipliers {
+    public:
+        explicit FaceMultipliers( size_t size = 0 );
+
+        /* Read multipliers written with serialize(), in the same representation. */
+        explicit FaceMultipliers( BinaryReader& reader );
+        void serialize( BinaryWriter& writer ) const;
+
+        size_t size() const;
+        bool isDense() const;
+
+        /* The number of cells with a multiplier different from 1. */
+        size_t numMultipliers() const;
+
+        double operator[]( size_t globalIndex ) const;
+
+        /*
+          The dense multipliers, one per cell, or the sparse multipliers
+          and their sorted cell indices. The vectors of the unused
+          representation are empty.
+        */
+        const std::vector< double >& data() const;
+        const std::vector< size_t >& indices() const;
+        const std::vector< double >& values() const;
+
+        /* All the multipliers, one per cell. */
+        std::vector< double > exportDense() const;
+
+        /* Multiply every cell with the corresponding value. */
+        void multiply( const std::vector< double >& values );
+
+        /*
+          Multiply the cells in the (global index, multiplier) list; a
+          cell may be listed several times, and the multipliers are then
+          applied in order.
+        */
+        void multiplyFaces( std::vector< std::pair< size_t, double > > updates );
+
+    private:
+        void compact();
+
+        size_t m_size;
+        std::vector< double > m_dense;
+        std::vector< size_t > m_indices;
+        std::vector< double > m_values;
+    };
+
+    inline double FaceMultipliers::operator[]( size_t globalIndex ) const {
+        if( !this->m_dense.empty() )
+            return this->m_dense[ globalIndex ];
+
+        const auto pos = std::lower_bound( this->m_indices.begin(), this->m_indices.end(), globalIndex );
+        if( pos == this->m_indices.end() || *pos != globalIndex )
+            return 1.0;
+
+        return this->m_values[ pos - this->m_indices.begin() ];
+    }
+
+}
+
+#endif
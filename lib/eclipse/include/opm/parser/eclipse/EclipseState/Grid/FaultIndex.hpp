@@ -0,0 +1,75 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_PARSER_FAULT_INDEX_HPP
+#define OPM_PARSER_FAULT_INDEX_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
+
+namespace Opm {
+
+    class FaultCollection;
+
+    /*
+      The FaultIndex maps the cell faces in a FaultCollection to the
+      faults they belong to. All the faces of all the faults are kept in
+      one vector sorted on (global index, face direction); a face which is
+      listed several times, e.g. by two faults, has one entry per listing,
+      in the order of the faults in the collection. The entries are
+      filled in parallel and sorted in parallel chunks.
+
+      The queries are binary searches, and see both sides of a face,
+      i.e. the face (i,j,k,XPlus) is on the same fault as (i+1,j,k,XMinus).
+    */
+    class FaultIndex : public GridDims {
+    public:
+        struct Face {
+            size_t globalIndex;
+            FaceDir::DirEnum faceDir;
+            int fault;
+        };
+
+        FaultIndex();
+        FaultIndex( const GridDims& dims, const FaultCollection& faults );
+
+        /* The number of fault faces, counted as listed by the faults. */
+        size_t size() const;
+        const std::vector< Face >& faces() const;
+
+        /*
+          The index in the FaultCollection of a fault containing the face,
+          or -1 if the face is not on a fault. If several faults contain
+          the face, the first one listing it from this side is returned.
+        */
+        int getFault( size_t globalIndex, FaceDir::DirEnum faceDir ) const;
+        bool hasFault( size_t globalIndex, FaceDir::DirEnum faceDir ) const;
+
+    private:
+        int find( size_t globalIndex, FaceDir::DirEnum faceDir ) const;
+
+        std::vector< Face > m_faces;
+    };
+}
+
+#endif
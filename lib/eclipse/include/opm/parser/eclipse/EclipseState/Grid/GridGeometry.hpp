@@ -0,0 +1,118 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARSER_GRID_GEOMETRY_HPP
+#define OPM_PARSER_GRID_GEOMETRY_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
+
+namespace Opm {
+
+    /*
+      The GridGeometry class computes the geometry of all the cells in a
+      corner point grid from the COORD and ZCORN arrays, and stores the
+      results as one array per quantity, indexed by global cell index:
+
+        volume:    The volume of the cell, taken as the exact volume of
+                   the trilinear hexahedron spanned by the eight corners.
+        centerX/Y: The mean of the eight corner positions.
+        depth:     The mean z value of the eight corners, i.e. the z
+                   coordinate of the cell center.
+        thickness: The mean length of the four pillar segments of the
+                   cell, i.e. the mean difference between the bottom and
+                   top z value of each pillar.
+        dx, dy:    The mean horizontal length of the four cell edges in
+                   the i and j direction respectively.
+
+      The corner positions are found by interpolating the x and y
+      coordinates along the pillars, in the same way as the ERT grid. A
+      grid whose cells do not share corners with their neighbours, e.g. a
+      grid from DX/DY/DZ/TOPS where DX varies with j or k, can not be
+      described by pillars; the geometry of such a grid is computed from
+      the corners of each cell instead. All cells are computed in one
+      pass, which is parallelized with OpenMP when available.
+    */
+
+    class GridGeometry : public GridDims {
+    public:
+        using corners = std::array< std::array< double, 3 >, 8 >;
+
+        /*
+          Fills in the corners of the cell with the given global index,
+          numbered as in cellCorners(); it is called concurrently from
+          several threads.
+        */
+        using CornerFunction = std::function< void( size_t, corners& ) >;
+
+        GridGeometry( size_t nx, size_t ny, size_t nz,
+                      const double* coord,
+                      const double* zcorn );
+
+        GridGeometry( const GridDims& dims,
+                      const std::vector< double >& coord,
+                      const std::vector< double >& zcorn );
+
+        GridGeometry( const GridDims& dims,
+                      const CornerFunction& cellCorners );
+
+        const std::vector< double >& volume() const;
+        const std::vector< double >& centerX() const;
+        const std::vector< double >& centerY() const;
+        const std::vector< double >& depth() const;
+        const std::vector< double >& thickness() const;
+        const std::vector< double >& dx() const;
+        const std::vector< double >& dy() const;
+
+        std::array< double, 3 > center( size_t globalIndex ) const;
+        std::array< double, 3 > cellDims( size_t globalIndex ) const;
+
+        /*
+          The position of the eight corners of cell (i,j,k), numbered as
+          in ZcornMapper; i.e. corner c has offset (c & 1) in the i
+          direction, (c >> 1) & 1 in the j direction and (c >> 2) in the k
+          direction.
+        */
+        static void cellCorners( size_t nx, size_t ny,
+                                 const double* coord,
+                                 const double* zcorn,
+                                 size_t i, size_t j, size_t k,
+                                 corners& cell );
+
+        static double cellVolume( const corners& cell );
+
+    private:
+        template< typename F >
+        void compute( const F& cellCorners );
+
+        std::vector< double > m_volume;
+        std::vector< double > m_center_x;
+        std::vector< double > m_center_y;
+        std::vector< double > m_depth;
+        std::vector< double > m_thickness;
+        std::vector< double > m_dx;
+        std::vector< double > m_dy;
+    };
+}
+
+#endif
@@ -19,6 +19,8 @@
 #ifndef ECLIPSE_GRIDPROPERTIES_HPP_
 #define ECLIPSE_GRIDPROPERTIES_HPP_
 
+#include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -47,9 +49,17 @@
        methods.
 
     3. When you ask the container to get a keyword with the
-       getKeyword() method it will automatically create a new
+       getOrCreateKeyword() method it will automatically create a new
        GridProperty object if the container does not have this
-       property.
+       property. getKeyword() does the same until the container has
+       been finalized by Eclipse3DProperties::finalize(), and throws
+       for a missing keyword after that.
+
+  Since getOrCreateKeyword() can modify the container the const methods
+  are serialized with a mutex, and can be called concurrently from
+  several threads. The iterators are not guarded; iterate over the
+  container only when no other thread can auto create a property, e.g.
+  after Eclipse3DProperties::finalize().
 */
 
 
@@ -58,6 +68,8 @@ namespace Opm {
     void setKeywordBox( const DeckRecord& deckRecord,
                         BoxManager& boxManager);
 
+    class BinaryReader;
+    class BinaryWriter;
     class Eclipse3DProperties;
 
     template <typename T>
@@ -68,6 +80,10 @@ namespace Opm {
         struct const_iterator;
 
         GridProperties() = default;
+        GridProperties(const GridProperties& other);
+        GridProperties& operator=(const GridProperties& other);
+        GridProperties(GridProperties&& other);
+        GridProperties& operator=(GridProperties&& other);
         GridProperties(const EclipseGrid& eclipseGrid,
                        const UnitSystem*  deckUnitSystem,
                        std::vector< SupportedKeywordInfo >&& supportedKeywords);
@@ -95,14 +111,18 @@ namespace Opm {
         void assertKeyword(const std::string& keyword) const;
 
         /*
-          The getKeyword() method will auto create a keyword if
-          requested, the getDeckKeyword() method will onyl return a
-          keyword if it has been explicitly mentioned in the deck. The
-          getDeckKeyword( ) method will throw an exception instead of
-          auto creating the keyword.
+          The getOrCreateKeyword() method will auto create a keyword if
+          requested, and is what the post processors use. The
+          getKeyword() method will also auto create a keyword until the
+          container has been finalized, and throw an exception for a
+          missing keyword after that. The getDeckKeyword() method will
+          only return a keyword if it has been explicitly mentioned in
+          the deck. The getDeckKeyword( ) method will throw an exception
+          instead of auto creating the keyword.
         */
 
         const GridProperty<T>& getKeyword(const std::string& keyword) const;
+        const GridProperty<T>& getOrCreateKeyword(const std::string& keyword) const;
         const GridProperty<T>& getDeckKeyword(const std::string& keyword) const;
 
 
@@ -115,6 +135,15 @@ namespace Opm {
         const MessageContainer& getMessageContainer() const;
         MessageContainer& getMessageContainer();
 
+        /*
+          Write the properties created so far with their current values;
+          Eclipse3DProperties::finalize() runs the post processors
+          first. deserialize() creates them again in a container with
+          the same supported keywords, as post processed properties.
+        */
+        void serialize( BinaryWriter& writer ) const;
+        void deserialize( BinaryReader& reader );
+
 
         template <class Keyword>
         bool hasKeyword() const {
@@ -190,6 +219,7 @@ namespace Opm {
         bool addAutoGeneratedKeyword_(const std::string& keywordName) const;
         void insertKeyword(const SupportedKeywordInfo& supportedKeyword) const;
         bool isAutoGenerated_(const std::string& keyword) const;
+        std::recursive_mutex& mutex() const;
 
         friend class Eclipse3DProperties; // needed for PORV keyword entanglement
         size_t nx = 0;
@@ -201,6 +231,16 @@ namespace Opm {
         mutable std::unordered_map<std::string, SupportedKeywordInfo> m_supportedKeywords;
         mutable storage m_properties;
         mutable std::set<std::string> m_autoGeneratedProperties;
+
+        /* Set by Eclipse3DProperties::finalize(). */
+        mutable bool m_finalized = false;
+
+        /*
+          A copy of the container gets a mutex of its own. Eclipse3DProperties
+          shares one mutex between its int and double containers, since the
+          post processors of one container look up properties in the other.
+        */
+        std::shared_ptr< std::recursive_mutex > m_mutex = std::make_shared< std::recursive_mutex >();
     };
 
 }
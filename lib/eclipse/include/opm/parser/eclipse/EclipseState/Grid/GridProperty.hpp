@@ -151,6 +151,13 @@ public:
       assembling the properties.
     */
     void runPostProcessor();
+
+    /*
+      Replace the values with values which have been post processed
+      already, e.g. read from a serialized EclipseState; the post
+      processor will then not be run.
+    */
+    void assignProcessed( const T* data, size_t size );
      /*
       Will scan through the roperty and return a vector of all the
       indices where the property value agrees with the input value.
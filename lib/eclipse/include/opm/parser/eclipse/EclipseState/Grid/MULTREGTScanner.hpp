@@ -21,6 +21,12 @@
 #ifndef OPM_PARSER_MULTREGTSCANNER_HPP
 #define OPM_PARSER_MULTREGTSCANNER_HPP
 
+#include <cstddef>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
 #include <opm/parser/eclipse/EclipseState/Util/Value.hpp>
@@ -67,6 +73,19 @@ namespace Opm {
 
 
 
+    /*
+      The MULTREGT records are compiled at construction into one lookup
+      table per region array. The region values which appear in the
+      records are numbered consecutively; each cell stores the number of
+      its region, or -1 if the region is not mentioned by any record. The
+      entries for all (region1, region2) pairs are kept in a dense matrix
+      when there are few regions, and otherwise as a sorted list of the
+      pairs which have a record. An entry packs the multiplier, the
+      direction mask and the NNC behaviour.
+
+      The scanner keeps a copy of the region arrays it needs, and all
+      queries are const and thread safe.
+    */
     class MULTREGTScanner {
 
     public:
@@ -74,12 +93,42 @@ namespace Opm {
                         const std::vector< const DeckKeyword* >& keywords);
         double getRegionMultiplier(size_t globalCellIdx1, size_t globalCellIdx2, FaceDir::DirEnum faceDir) const;
 
+        /*
+          The region multipliers for the cell pairs (globalCellIdx1[i],
+          globalCellIdx2[i]) through the faces faceDir[i]; the three
+          vectors must have equal length.
+        */
+        std::vector< double > getRegionMultipliers(const std::vector< size_t >& globalCellIdx1,
+                                                   const std::vector< size_t >& globalCellIdx2,
+                                                   const std::vector< FaceDir::DirEnum >& faceDir) const;
+
     private:
+        /* Tables with more regions than this are stored sparse. */
+        static const size_t maxDenseRegions = 256;
+
+        struct Entry {
+            double multiplier;
+            int directions;
+            MULTREGT::NNCBehaviourEnum nncBehaviour;
+        };
+
+        struct RegionTable {
+            std::string keyword;
+            std::vector< int > cellRegion;
+            size_t numRegions;
+            std::vector< Entry > dense;
+            std::vector< std::pair< size_t , Entry > > sparse;
+
+            const Entry* find(int region1 , int region2) const;
+        };
+
         void addKeyword( const DeckKeyword& deckKeyword, const std::string& defaultRegion);
         void assertKeywordSupported(const DeckKeyword& deckKeyword, const std::string& defaultRegion);
+        double lookup(size_t globalIndex1 , size_t globalIndex2, FaceDir::DirEnum faceDir) const;
+
         std::vector< MULTREGTRecord > m_records;
-        std::map<std::string , MULTREGTSearchMap> m_searchMap;
-        const Eclipse3DProperties& m_e3DProps;
+        std::vector< RegionTable > m_tables;
+        size_t m_nx , m_ny , m_size;
     };
 
 }
@@ -33,6 +33,8 @@ struct NNCdata {
     double trans;
 };
 
+class BinaryReader;
+class BinaryWriter;
 class Deck;
 
 /// Represents non-neighboring connections (non-standard adjacencies).
@@ -44,6 +46,10 @@ public:
 
     /// Construct from input deck.
     explicit NNC(const Deck& deck);
+
+    /// Read the connections written with serialize().
+    explicit NNC(BinaryReader& reader);
+    void serialize(BinaryWriter& writer) const;
     void addNNC(const size_t cell1, const size_t cell2, const double trans);
     const std::vector<NNCdata>& nncdata() const { return m_nnc; }
     size_t numNNC() const;
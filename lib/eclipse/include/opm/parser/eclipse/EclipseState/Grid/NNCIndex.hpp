@@ -0,0 +1,100 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_PARSER_NNC_INDEX_HPP
+#define OPM_PARSER_NNC_INDEX_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+
+namespace Opm {
+
+    /*
+      A sorted and indexed view of non-neighbouring connections. The
+      connections are undirected: each is stored with cell1 <= cell2,
+      sorted on (cell1, cell2), and the transmissibilities of connections
+      listed more than once, in either direction, are summed in input
+      order. The sort is a parallel stable sort.
+
+      The connections of each cell are indexed in compressed row form,
+      over the sorted list of cells which have at least one connection;
+      a cell with no connections costs nothing. A connection from a cell
+      to itself is listed once for that cell.
+    */
+    class NNCIndex {
+    public:
+        /* The positions in connections() of the connections of one cell. */
+        class Range {
+        public:
+            using const_iterator = std::vector< size_t >::const_iterator;
+
+            Range( const_iterator first, const_iterator last );
+            const_iterator begin() const;
+            const_iterator end() const;
+            size_t size() const;
+            bool empty() const;
+
+        private:
+            const_iterator m_first;
+            const_iterator m_last;
+        };
+
+        NNCIndex();
+        explicit NNCIndex( const NNC& nnc );
+        explicit NNCIndex( std::vector< NNCdata > nncs );
+
+        /*
+          Add more connections, e.g. generated ones, to the index; they
+          are merged with the connections already present.
+        */
+        void merge( std::vector< NNCdata > nncs );
+
+        size_t size() const;
+        const std::vector< NNCdata >& connections() const;
+
+        /*
+          The connection between cell1 and cell2 in either order, or
+          nullptr if the cells are not connected.
+        */
+        const NNCdata* find( size_t cell1, size_t cell2 ) const;
+        bool hasConnection( size_t cell1, size_t cell2 ) const;
+
+        Range cellConnections( size_t cell ) const;
+
+        /* The compressed row form: cell c = cells()[r] has the
+           connections adjacency()[offsets()[r] .. offsets()[r+1]). */
+        const std::vector< size_t >& cells() const;
+        const std::vector< size_t >& offsets() const;
+        const std::vector< size_t >& adjacency() const;
+
+    private:
+        void buildAdjacency();
+
+        std::vector< NNCdata > m_connections;
+        std::vector< size_t > m_cells;
+        std::vector< size_t > m_offsets;
+        std::vector< size_t > m_adjacency;
+    };
+
+}
+
+#endif
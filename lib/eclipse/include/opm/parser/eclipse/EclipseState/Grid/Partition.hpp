@@ -0,0 +1,131 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_PARSER_PARTITION_HPP
+#define OPM_PARSER_PARTITION_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+
+namespace Opm {
+
+    class ConnectionGraph;
+    class EclipseGrid;
+
+    /*
+      The Partition class is the part of the active cells owned by one
+      rank of a distributed run, given the owning rank of every active
+      cell. The local cells are the owned cells followed by the halo,
+      i.e. the cells owned by other ranks with a connection to an owned
+      cell; both groups are ordered by global index. globalIndex() and
+      activeIndex() map the local cells back to the input grid, so
+      results can be written with the global numbering.
+
+      The local connection graph has one row per owned cell, with the
+      neighbours given as local indices; otherwise it is as the
+      ConnectionGraph. extract() picks the values of the local cells
+      from a global array, e.g. the data of a GridProperty, so a rank
+      can keep only its share of the property arrays and NNCs.
+    */
+
+    class Partition {
+    public:
+        Partition( const EclipseGrid& grid,
+                   const ConnectionGraph& graph,
+                   const std::vector< int >& owner,
+                   int rank );
+
+        /*
+          Assign the active cells to num_ranks ranks by recursive
+          coordinate bisection of the cell centers; the result is the
+          owning rank of each active cell. The cells are split across
+          the widest extent of the bounding box, in proportion to the
+          number of ranks on each side.
+        */
+        static std::vector< int > bisect( const EclipseGrid& grid, int num_ranks );
+
+        int rank() const;
+        size_t numOwned() const;
+        size_t numCells() const;
+        bool isOwned( size_t local ) const;
+
+        const std::vector< size_t >& globalIndex() const;
+        const std::vector< size_t >& activeIndex() const;
+
+        /* The local index of the cell with global index g, or -1. */
+        int localIndex( size_t g ) const;
+
+        const std::vector< size_t >& offsets() const;
+        const std::vector< int >& neighbours() const;
+        const std::vector< int >& faces() const;
+        const std::vector< double >& multipliers() const;
+        const std::vector< double >& nncTrans() const;
+
+        /*
+          The NNCs of the input with at least one owned cell, with the
+          cells given as global indices.
+        */
+        std::vector< NNCdata > nncs( const NNC& nnc ) const;
+
+        /*
+          The values of the local cells, from an array with either one
+          value per cell in the grid, or one per active cell.
+        */
+        template< typename T >
+        std::vector< T > extract( const std::vector< T >& data ) const {
+            const std::vector< size_t >* index;
+            if( data.size() == this->m_cartesian_size )
+                index = &this->m_global;
+            else if( data.size() == this->m_num_active )
+                index = &this->m_active;
+            else
+                throw std::invalid_argument( "Can not extract the local cells from an array of size "
+                                             + std::to_string( data.size() ) );
+
+            std::vector< T > local;
+            local.reserve( index->size() );
+            for( const auto i : *index )
+                local.push_back( data[ i ] );
+
+            return local;
+        }
+
+    private:
+        int m_rank;
+        size_t m_cartesian_size;
+        size_t m_num_active;
+        size_t m_num_owned;
+
+        std::vector< size_t > m_global;
+        std::vector< size_t > m_active;
+
+        std::vector< size_t > m_offsets;
+        std::vector< int > m_neighbours;
+        std::vector< int > m_faces;
+        std::vector< double > m_multipliers;
+        std::vector< double > m_nnc_trans;
+    };
+}
+
+#endif
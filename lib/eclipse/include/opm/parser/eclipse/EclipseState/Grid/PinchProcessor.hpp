@@ -0,0 +1,97 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_PARSER_PINCH_PROCESSOR_HPP
+#define OPM_PARSER_PINCH_PROCESSOR_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+
+namespace Opm {
+
+    class EclipseGrid;
+
+    /*
+      The PinchProcessor applies the MINPV/MINPVFIL and PINCH settings of
+      a grid, and finds the vertical connections across the cells they
+      remove:
+
+        1. An active cell with pore volume below the MINPV value is made
+           inactive.
+
+        2. With PINCH, an active cell thinner than the threshold thickness
+           is made inactive, i.e. pinched out.
+
+        3. With PINCH, two active cells in the same column which have
+           only inactive cells between them are connected, provided the
+           cells between them are all pinched out, removed by MINPV,
+           or - with the GAP option - inactive, and their total thickness
+           does not exceed the maximum empty gap.
+
+      For every connection the upper and lower cell and the MULTZ value
+      to use are given. With the MULTZ option TOP, this is the MULTZ of
+      the upper cell. With ALL, it is the smallest MULTZ of the upper
+      cell and the cells in the gap. The transmissibility itself depends
+      on the simulator's discretization and is not computed.
+
+      The columns are processed in parallel.
+    */
+    class PinchProcessor {
+    public:
+        struct Connection {
+            size_t cell1;
+            size_t cell2;
+            double multz;
+        };
+
+        /*
+          The pore volume and MULTZ arrays have one value per cell in the
+          grid; MULTZ may be empty, which means MULTZ is 1 everywhere.
+        */
+        PinchProcessor( const EclipseGrid& grid,
+                        const std::vector< double >& porv,
+                        const std::vector< double >& multz );
+
+        /* The ACTNUM array after MINPV and PINCH have been applied. */
+        const std::vector< int >& actnum() const;
+
+        /* The number of cells made inactive by MINPV and PINCH. */
+        size_t numRemoved() const;
+
+        /* Sorted by column, and from top to bottom within a column. */
+        const std::vector< Connection >& connections() const;
+
+        /*
+          The connections as NNCs with zero transmissibility, e.g. for
+          merging into an NNCIndex.
+        */
+        std::vector< NNCdata > nncs() const;
+
+    private:
+        std::vector< int > m_actnum;
+        std::vector< Connection > m_connections;
+        size_t m_removed;
+    };
+
+}
+
+#endif
@@ -25,25 +25,36 @@
 
       {MULTX , MULTX- , MULTY , MULTY- , MULTZ , MULTZ-, MULTFLT , MULTREGT}
 
+   The multipliers of each face direction are kept in a FaceMultipliers
+   container, which stores only the faces with a multiplier different
+   from 1 as long as they are few, e.g. when the only multipliers come
+   from MULTFLT.
 */
 #ifndef OPM_PARSER_TRANSMULT_HPP
 #define OPM_PARSER_TRANSMULT_HPP
 
 
+#include <array>
 #include <cstddef>
-#include <map>
 #include <memory>
+#include <vector>
 
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaceMultipliers.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/MULTREGTScanner.hpp>
 
 namespace Opm {
     template< typename > class GridProperty;
+    class BinaryReader;
+    class BinaryWriter;
     class Fault;
     class FaultCollection;
+    class FaultIndex;
     class Eclipse3DProperties;
     class DeckKeyword;
 
+    namespace Trace { class Span; }
+
     class TransMult {
 
     public:
@@ -51,21 +62,33 @@ namespace Opm {
         double getMultiplier(size_t globalIndex, FaceDir::DirEnum faceDir) const;
         double getMultiplier(size_t i , size_t j , size_t k, FaceDir::DirEnum faceDir) const;
         double getRegionMultiplier( size_t globalCellIndex1, size_t globalCellIndex2, FaceDir::DirEnum faceDir) const;
+        std::vector< double > getRegionMultipliers( const std::vector< size_t >& globalCellIndex1,
+                                                    const std::vector< size_t >& globalCellIndex2,
+                                                    const std::vector< FaceDir::DirEnum >& faceDir) const;
+        const FaceMultipliers& getMultipliers(FaceDir::DirEnum faceDir) const;
         void applyMULT(const GridProperty<double>& srcMultProp, FaceDir::DirEnum faceDir);
         void applyMULTFLT(const FaultCollection& faults);
+        void applyMULTFLT(const FaultCollection& faults, const FaultIndex& index);
         void applyMULTFLT(const Fault& fault);
 
+        /*
+          Write the face multipliers, and replace them with multipliers
+          written by serialize(). The MULTREGT multipliers are not part
+          of it; they are always computed from the deck.
+        */
+        void serialize(BinaryWriter& writer) const;
+        void deserialize(BinaryReader& reader);
+
     private:
+        /* The span covers the construction of the members. */
+        TransMult(const GridDims& dims, const Deck& deck, const Eclipse3DProperties& props, const Trace::Span&);
+
         size_t getGlobalIndex(size_t i , size_t j , size_t k) const;
         void assertIJK(size_t i , size_t j , size_t k) const;
         double getMultiplier__(size_t globalIndex , FaceDir::DirEnum faceDir) const;
-        void insertNewProperty(FaceDir::DirEnum faceDir);
-        bool hasDirectionProperty(FaceDir::DirEnum faceDir) const;
-        GridProperty<double>& getDirectionProperty(FaceDir::DirEnum faceDir);
 
         size_t m_nx , m_ny , m_nz;
-        std::map<FaceDir::DirEnum , GridProperty<double> > m_trans;
-        std::map<FaceDir::DirEnum , std::string> m_names;
+        std::array< FaceMultipliers , 6 > m_multipliers;
         MULTREGTScanner m_multregtScanner;
     };
 
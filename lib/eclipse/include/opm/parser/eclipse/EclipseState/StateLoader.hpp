@@ -0,0 +1,78 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_STATE_LOADER_HPP
+#define OPM_STATE_LOADER_HPP
+
+#include <memory>
+#include <string>
+
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+
+namespace Opm {
+
+    class Deck;
+    class EclipseState;
+    class Parser;
+    class Schedule;
+
+    /*
+      Parse a deck and build the EclipseState and the Schedule, with the
+      grid, the NNC and the tables built from the sections before
+      SCHEDULE while the schedule is still being parsed; see the head
+      handler of Parser::parseFile(). The Eclipse3DProperties keep
+      pointers to the tables and grid of the state, and are built with
+      the state when the deck is complete.
+
+      The tables are built from the full deck instead if the schedule
+      has any of the table keywords which are also valid in the
+      SCHEDULE section, e.g. VFPPROD. If building a member from the head
+      fails it is built again with the state, so the errors, and the
+      messages, are the same as when the state is built from the parsed
+      deck.
+    */
+    class StateLoader {
+    public:
+        static StateLoader loadFile( const Parser& parser,
+                                     const std::string& dataFile,
+                                     const ParseContext& parseContext = ParseContext() );
+
+        static StateLoader loadString( const Parser& parser,
+                                       const std::string& data,
+                                       const ParseContext& parseContext = ParseContext() );
+
+        StateLoader( StateLoader&& );
+        ~StateLoader();
+
+        const Deck& getDeck() const;
+        const EclipseState& getEclipseState() const;
+        const Schedule& getSchedule() const;
+
+    private:
+        StateLoader() = default;
+
+        std::unique_ptr< Deck > m_deck;
+        std::unique_ptr< EclipseState > m_state;
+        std::unique_ptr< Schedule > m_schedule;
+    };
+
+}
+
+#endif
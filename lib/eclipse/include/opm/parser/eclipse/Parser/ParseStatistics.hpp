@@ -0,0 +1,111 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PARSE_STATISTICS_HPP
+#define OPM_PARSE_STATISTICS_HPP
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      The ParseStatistics class holds profiling counters collected while
+      parsing a deck. The counters are aggregated both per keyword name and
+      per source file. The statistics are only collected when profiling has
+      been enabled with Parser::setProfiling( true ), and the library has
+      been compiled with OPM_PARSE_PROFILING defined; otherwise the
+      instrumentation is not present in the parser at all.
+
+      The three timers measure different phases of the parsing:
+
+        lex:     Reading lines from the input and assembling the RawKeyword.
+        scan:    Splitting the raw records into items and converting the
+                 string tokens to values, i.e. ParserKeyword::parse().
+        convert: Applying units to the deck values; only keywords with
+                 a dimension have a nonzero convert time.
+
+      The allocation counters are only updated if allocation counters
+      have been installed with setAllocationCounter(); that requires an
+      application to replace the global operator new. The allocations
+      field is the number of calls to operator new, allocated_bytes is
+      the sum of the requested sizes.
+    */
+
+    class ParseStatistics {
+    public:
+        struct Counters {
+            size_t count = 0;
+            size_t bytes = 0;
+            size_t records = 0;
+            size_t items = 0;
+            size_t values = 0;
+            size_t allocations = 0;
+            size_t allocated_bytes = 0;
+            double lex_time = 0;
+            double scan_time = 0;
+            double convert_time = 0;
+
+            double total_time() const;
+            Counters& operator+=( const Counters& other );
+        };
+
+        using allocation_counter = size_t (*)();
+        using entry = std::pair< std::string, Counters >;
+
+        void add( const std::string& keyword, const std::string& filename, const Counters& counters );
+        void addConvert( const std::string& keyword, const std::string& filename,
+                         double seconds, size_t allocations,
+                         size_t allocated_bytes = 0 );
+
+        const std::map< std::string, Counters >& keywords() const;
+        const std::map< std::string, Counters >& files() const;
+        Counters total() const;
+        bool empty() const;
+
+        /*
+          The sortedKeywords() and sortedFiles() methods return the
+          (name, counters) pairs ordered with the most expensive, i.e.
+          largest total_time(), first.
+        */
+        std::vector< entry > sortedKeywords() const;
+        std::vector< entry > sortedFiles() const;
+
+        /*
+          Write a table of the counters to the stream, sorted by cost. If
+          max_rows is nonzero only the max_rows most expensive keywords
+          are listed.
+        */
+        void report( std::ostream& os, size_t max_rows = 0 ) const;
+
+        static void setAllocationCounter( allocation_counter counter,
+                                          allocation_counter bytes = nullptr );
+        static size_t allocations();
+        static size_t allocatedBytes();
+
+    private:
+        std::map< std::string, Counters > m_keywords;
+        std::map< std::string, Counters > m_files;
+    };
+}
+
+#endif
@@ -20,6 +20,8 @@
 #ifndef OPM_PARSER_HPP
 #define OPM_PARSER_HPP
 
+#include <functional>
+#include <future>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -58,6 +60,35 @@ namespace Opm {
                          const ParseContext& = ParseContext()) const;
         Deck parseStream(std::unique_ptr<std::istream>&& inputStream , const ParseContext& parseContext) const;
 
+        /*
+          Called with the keywords before the split section, see below;
+          the head deck is only valid until the returned future is ready.
+        */
+        using HeadHandler = std::function< std::future< void >( const Deck& head ) >;
+
+        /*
+          As parseFile() and parseString(), but when the parser reaches
+          the section keyword 'section', e.g. "SCHEDULE", the keywords
+          before it are moved to a separate deck, the units are applied,
+          and the deck is passed to handler. The handler can start work on
+          it, e.g. in a std::async task, while the rest of the input is
+          parsed. When the input is parsed the future from the handler, if
+          valid, is waited for and any exception stored in it is rethrown,
+          and the head keywords are moved back into the returned deck. If
+          the section is not in the input the handler is called with the
+          complete deck.
+
+          The unit system keywords must come before the section.
+        */
+        Deck parseFile(const std::string &dataFile,
+                       const ParseContext& parseContext,
+                       const std::string& section,
+                       const HeadHandler& handler) const;
+        Deck parseString(const std::string &data,
+                         const ParseContext& parseContext,
+                         const std::string& section,
+                         const HeadHandler& handler) const;
+
         /// Method to add ParserKeyword instances, these holding type and size information about the keywords and their data.
         void addParserKeyword(const Json::JsonObject& jsonKeyword);
         void addParserKeyword(std::unique_ptr< const ParserKeyword >&& parserKeyword);
@@ -85,6 +116,16 @@ namespace Opm {
          */
         size_t size() const;
 
+        /*
+          When profiling is enabled the Deck instances returned from
+          parseFile() and parseString() carry a ParseStatistics object
+          with per keyword and per file counters. Profiling support must
+          also be compiled in with OPM_PARSE_PROFILING, otherwise
+          profiling() will always return false.
+        */
+        void setProfiling( bool profiling );
+        bool profiling() const;
+
         template <class T>
         void addKeyword() {
             addParserKeyword( std::unique_ptr< ParserKeyword >( new T ) );
@@ -120,6 +161,7 @@ namespace Opm {
         // associative map of the parser internal names and the corresponding
         // ParserKeyword object for keywords which match a regular expression
         std::map< string_view, const ParserKeyword* > m_wildCardKeywords;
+        bool m_profiling = false;
 
         bool hasWildCardKeyword(const std::string& keyword) const;
         const ParserKeyword* matchingKeyword(const string_view& keyword) const;
@@ -57,6 +57,7 @@ namespace Opm {
         size_t numDimensions() const;
         const std::string& name() const;
         item_size sizeType() const;
+        type_tag dataType() const;
         std::string getDescription() const;
         bool scalar() const;
         void setDescription(std::string helpText);
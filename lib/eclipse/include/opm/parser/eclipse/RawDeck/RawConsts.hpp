@@ -32,6 +32,7 @@ namespace Opm {
         const std::string end = "END";
         const std::string endinclude = "ENDINC";
         const std::string paths = "PATHS";
+        const std::string import = "IMPORT";
         const unsigned int maxKeywordLength = 8;
 
         /* The lookup uses some bit-tricks to achieve branchless lookup in the
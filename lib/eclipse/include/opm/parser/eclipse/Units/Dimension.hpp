@@ -24,10 +24,14 @@
 
 namespace Opm {
 
+    class BinaryReader;
+    class BinaryWriter;
+
     class Dimension {
     public:
         Dimension() = default;
         Dimension(const std::string& name, double SIfactor, double SIoffset = 0.0);
+        explicit Dimension(BinaryReader& reader);
 
         double getSIScaling() const;
         double getSIOffset() const;
@@ -40,6 +44,8 @@ namespace Opm {
         bool isCompositable() const;
         static Dimension newComposite(const std::string& dim, double SIfactor, double SIoffset = 0.0);
 
+        void serialize(BinaryWriter& writer) const;
+
         bool operator==( const Dimension& ) const;
         bool operator!=( const Dimension& ) const;
 
@@ -0,0 +1,192 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_UTILITY_BINARY_BUFFER_HPP
+#define OPM_UTILITY_BINARY_BUFFER_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Opm {
+
+    class MappedFile;
+
+    /*
+      The binary buffer format is a 16 byte header - the magic string
+      "OPMBUFR\0", a 32 bit format version and a byte order mark - and
+      a sequence of values in native byte order:
+
+        scalars:  The raw bytes of an integral or floating point value.
+        strings:  A 64 bit length followed by the characters.
+        arrays:   A 64 bit element count, padded to an 8 byte boundary,
+                  followed by the elements and padded again.
+
+      The buffer is contiguous and position independent, so it can be
+      broadcast as a byte array or written to a file and memory mapped.
+      Since the arrays are aligned relative to the start of the buffer,
+      the reader can hand out views straight into the buffer, provided
+      the buffer itself is 8 byte aligned, as heap allocations and
+      memory mappings are.
+    */
+
+    class BinaryWriter {
+    public:
+        static const uint32_t version = 2;
+
+        BinaryWriter();
+
+        template< typename T >
+        void write( T value ) {
+            static_assert( std::is_arithmetic< T >::value, "Only arithmetic values can be written" );
+            this->append( &value, sizeof( T ) );
+        }
+
+        void write( const std::string& value );
+
+        template< typename T >
+        void writeArray( const T* values, size_t size ) {
+            static_assert( std::is_arithmetic< T >::value, "Only arithmetic arrays can be written" );
+            this->write( uint64_t( size ) );
+            this->pad();
+            this->append( values, size * sizeof( T ) );
+            this->pad();
+        }
+
+        template< typename T >
+        void writeArray( const std::vector< T >& values ) {
+            this->writeArray( values.data(), values.size() );
+        }
+
+        void writeArray( const std::vector< bool >& values );
+        void writeArray( const std::vector< std::string >& values );
+
+        const std::vector< char >& data() const;
+        std::vector< char > release();
+
+        /* Throws std::invalid_argument if the file can not be written. */
+        void writeFile( const std::string& filename ) const;
+
+    private:
+        void append( const void* data, size_t size );
+        void pad();
+
+        std::vector< char > m_buffer;
+    };
+
+
+    /*
+      A view of an array in a BinaryReader buffer; valid as long as the
+      buffer is.
+    */
+    template< typename T >
+    struct ArrayView {
+        const T* data;
+        size_t size;
+
+        const T* begin() const { return this->data; }
+        const T* end() const { return this->data + this->size; }
+    };
+
+
+    /*
+      Read the values from a BinaryWriter buffer, in the order they were
+      written. The reader does not own a buffer given as a pointer; it
+      shares the ownership of a buffer given as a shared vector, and of
+      a file, which is memory mapped. Throws std::runtime_error if the
+      header does not match this build, or if a read goes past the end
+      of the buffer.
+    */
+
+    class BinaryReader {
+    public:
+        BinaryReader( const char* data, size_t size );
+        explicit BinaryReader( std::shared_ptr< const std::vector< char > > buffer );
+        explicit BinaryReader( const std::string& filename );
+
+        template< typename T >
+        T read() {
+            static_assert( std::is_arithmetic< T >::value, "Only arithmetic values can be read" );
+            T value;
+            std::memcpy( &value, this->take( sizeof( T ) ), sizeof( T ) );
+            return value;
+        }
+
+        std::string readString();
+
+        template< typename T >
+        ArrayView< T > readView() {
+            static_assert( std::is_arithmetic< T >::value, "Only arithmetic arrays can be read" );
+            const auto size = this->read< uint64_t >();
+            this->skipPadding();
+            const char* data = this->takeArray( size, sizeof( T ) );
+            this->skipPadding();
+            return { reinterpret_cast< const T* >( data ), size_t( size ) };
+        }
+
+        /*
+          Read an array as a pointer which shares the ownership of the
+          buffer, so the array can be kept after the reader is gone
+          without being copied. If the reader does not own the buffer
+          the array is copied.
+        */
+        template< typename T >
+        std::shared_ptr< const T > readShared( size_t& size ) {
+            const auto view = this->readView< T >();
+            size = view.size;
+            if( this->m_owner )
+                return std::shared_ptr< const T >( this->m_owner, view.data );
+
+            const auto copy = std::make_shared< const std::vector< T > >( view.begin(), view.end() );
+            return std::shared_ptr< const T >( copy, copy->data() );
+        }
+
+        template< typename T >
+        std::vector< T > readArray() {
+            const auto view = this->readView< T >();
+            return std::vector< T >( view.begin(), view.end() );
+        }
+
+        std::vector< bool > readBoolArray();
+        std::vector< std::string > readStringArray();
+
+        bool atEnd() const;
+
+    private:
+        void init();
+        const char* take( size_t size );
+        const char* takeArray( uint64_t count, size_t element_size );
+        void skipPadding();
+
+        explicit BinaryReader( const std::shared_ptr< const MappedFile >& file );
+        BinaryReader( std::shared_ptr< const void > owner, const char* begin, const char* end );
+
+        std::shared_ptr< const void > m_owner;
+        const char* m_begin;
+        const char* m_end;
+        const char* m_pos;
+    };
+
+}
+
+#endif
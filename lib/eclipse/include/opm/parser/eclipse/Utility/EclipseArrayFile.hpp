@@ -0,0 +1,61 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_UTILITY_ECLIPSE_ARRAY_FILE_HPP
+#define OPM_UTILITY_ECLIPSE_ARRAY_FILE_HPP
+
+#include <string>
+#include <vector>
+
+#include <opm/parser/eclipse/Utility/Typetools.hpp>
+
+namespace Opm {
+
+    /*
+      One array of an Eclipse array file; INTE and LOGI arrays are held
+      in ival, REAL and DOUB arrays in dval.
+    */
+    struct EclipseArray {
+        std::string name;
+        type_tag type = type_tag::unknown;
+        std::vector< int > ival;
+        std::vector< double > dval;
+
+        size_t size() const;
+    };
+
+    /*
+      Read the arrays of an Eclipse array file, i.e. a sequence of
+      records with an eight character name, an element count, a type
+      and the data. This is the format of the GRDECL, INIT and EGRID
+      files written by Eclipse, and of the files read with the IMPORT
+      keyword.
+
+      An unformatted (big endian binary) file is memory mapped and the
+      values are converted straight from the mapping into the vectors
+      of the arrays. CHAR and MESS arrays are skipped. Throws
+      std::invalid_argument if the file can not be opened and
+      std::runtime_error if it is not a valid array file.
+    */
+    std::vector< EclipseArray > readEclipseArrays( const std::string& filename, bool formatted );
+
+}
+
+#endif
@@ -0,0 +1,55 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_UTILITY_MAPPED_FILE_HPP
+#define OPM_UTILITY_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+
+namespace Opm {
+
+    /*
+      A read only memory mapping of a whole file; the mapping is page
+      aligned. Throws std::invalid_argument if the file can not be
+      opened or mapped.
+    */
+    class MappedFile {
+    public:
+        explicit MappedFile( const std::string& filename );
+
+        MappedFile( const MappedFile& ) = delete;
+        MappedFile& operator=( const MappedFile& ) = delete;
+
+        ~MappedFile();
+
+        const char* begin() const { return this->m_data; }
+        const char* end() const { return this->m_data + this->m_size; }
+        size_t size() const { return this->m_size; }
+
+    private:
+        int m_fd = -1;
+        size_t m_size = 0;
+        const char* m_data = nullptr;
+    };
+
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_PARALLEL_SORT_HPP
+#define OPM_PARALLEL_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+namespace Opm {
+
+    /*
+      A stable sort of the random access range [first, last). Chunks of
+      the range are sorted in parallel with OpenMP when available, and
+      then merged pairwise in parallel, doubling the width in each
+      round. The result is the same as std::stable_sort.
+    */
+    template< typename Iter, typename Less >
+    void parallelStableSort( Iter first, Iter last, Less less ) {
+        const size_t chunk = 1 << 16;
+        const size_t size = last - first;
+        const size_t num_chunks = ( size + chunk - 1 ) / chunk;
+
+        #pragma omp parallel for schedule(static)
+        for( size_t c = 0; c < num_chunks; c++ )
+            std::stable_sort( first + c * chunk,
+                              first + std::min( size, ( c + 1 ) * chunk ),
+                              less );
+
+        for( size_t width = chunk; width < size; width *= 2 ) {
+            const size_t num_merges = ( size + 2 * width - 1 ) / ( 2 * width );
+
+            #pragma omp parallel for schedule(static)
+            for( size_t m = 0; m < num_merges; m++ ) {
+                const size_t begin = m * 2 * width;
+                const size_t middle = std::min( size, begin + width );
+                const size_t end = std::min( size, begin + 2 * width );
+                std::inplace_merge( first + begin, first + middle, first + end, less );
+            }
+        }
+    }
+
+}
+
+#endif
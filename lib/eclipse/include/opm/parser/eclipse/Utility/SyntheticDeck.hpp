@@ -0,0 +1,111 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_SYNTHETIC_DECK_HPP
+#define OPM_SYNTHETIC_DECK_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace Opm {
+
+    /*
+      The SyntheticDeck class generates complete and valid decks of
+      configurable size; it is intended for benchmarking and for reporting
+      performance problems without sharing production decks. The deck
+      contains:
+
+        RUNSPEC:  DIMENS, phases, table and well dimensions and START.
+        GRID:     A corner point grid (SPECGRID, COORD and ZCORN) with
+                  random layer thickness, PORO, PERMX, PERMY, PERMZ, NTG,
+                  MULTNUM, FAULTS, MULTFLT and MULTREGT.
+        PROPS:    SWOF, SGOF, PVDO, PVDG, PVTW, DENSITY and ROCK.
+        REGIONS:  SATNUM, PVTNUM and FIPNUM.
+        SOLUTION: EQUIL.
+        SUMMARY:  Field and well vectors.
+        SCHEDULE: WELSPECS and COMPDAT for all wells, and WCONHIST for
+                  all wells in each report step.
+
+      All random values are drawn from a generator seeded with
+      Options::seed; the same options will always produce exactly the same
+      deck, also across platforms and compilers. The grid property arrays
+      are written with runs of Options::repeat equal values, i.e. with
+      repeat counts like 'n*value' when repeat > 1.
+    */
+
+    class SyntheticDeck {
+    public:
+        struct Options {
+            size_t nx = 10;
+            size_t ny = 10;
+            size_t nz = 5;
+            size_t wells = 4;
+            size_t steps = 12;
+            size_t repeat = 1;
+            size_t regions = 4;
+            size_t faults = 1;
+            uint64_t seed = 1;
+        };
+
+        explicit SyntheticDeck( const Options& options );
+
+        const Options& options() const;
+        const std::string& runspec() const;
+        const std::string& geometry() const;
+        const std::string& properties() const;
+        const std::string& props() const;
+        const std::string& regions() const;
+        const std::string& solution() const;
+        const std::string& summary() const;
+        const std::string& schedule() const;
+
+        /*
+          The complete deck as one string, suitable for
+          Parser::parseString().
+        */
+        std::string str() const;
+
+        /*
+          Write the complete deck to one file.
+        */
+        void write( const std::string& filename ) const;
+
+        /*
+          Write the deck as a DATA file which INCLUDEs the grid geometry,
+          the grid properties and the schedule section from separate files
+          next to it. The include files are named after the DATA file,
+          i.e. writeSplit( "dir/CASE.DATA" ) creates dir/CASE_GRID.INC,
+          dir/CASE_PROPS.INC and dir/CASE_SCHEDULE.INC.
+        */
+        void writeSplit( const std::string& filename ) const;
+
+    private:
+        Options m_options;
+        std::string m_runspec;
+        std::string m_geometry;
+        std::string m_properties;
+        std::string m_props;
+        std::string m_regions;
+        std::string m_solution;
+        std::string m_summary;
+        std::string m_schedule;
+    };
+}
+
+#endif
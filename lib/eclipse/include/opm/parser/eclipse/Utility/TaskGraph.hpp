@@ -0,0 +1,81 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#ifndef OPM_UTILITY_TASK_GRAPH_HPP
+#define OPM_UTILITY_TASK_GRAPH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Opm {
+
+    /*
+      A set of tasks with dependencies, run on a pool of threads. A task
+      can only depend on tasks which have been added before it, so the
+      graph is acyclic, and the order of add() is a valid sequential
+      order; run( 1 ) runs the tasks in that order on the calling thread.
+
+      Each task runs in a Trace::Span with the name of the task, which
+      shows the overlap of the tasks in the trace.
+
+      If a task throws, the tasks which depend on it are not run, and
+      when all other tasks have completed run() rethrows the exception
+      of the first failed task in the order of add(); the error reported
+      is therefore the same as for a sequential run, independently of
+      the scheduling.
+    */
+    class TaskGraph {
+    public:
+        using Task = std::function< void() >;
+
+        /*
+          Add a task which is run when the tasks with the given indices
+          have completed; returns the index of the new task. Throws
+          std::invalid_argument if a dependency is not an earlier task.
+        */
+        size_t add( const std::string& name,
+                    Task task,
+                    const std::vector< size_t >& dependencies = {} );
+
+        size_t size() const;
+
+        /*
+          Run all the tasks, using the calling thread and num_threads - 1
+          worker threads; num_threads == 0 uses one thread per hardware
+          thread, bounded by the number of tasks.
+        */
+        void run( size_t num_threads = 0 );
+
+    private:
+        struct Node {
+            std::string name;
+            Task task;
+            size_t num_dependencies;
+            std::vector< size_t > dependents;
+        };
+
+        std::vector< Node > m_nodes;
+    };
+
+}
+
+#endif
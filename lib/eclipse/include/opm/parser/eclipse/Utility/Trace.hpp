@@ -0,0 +1,82 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_UTILITY_TRACE_HPP
+#define OPM_UTILITY_TRACE_HPP
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace Opm {
+namespace Trace {
+
+    /*
+      Timeline tracing of the parse and state construction. When tracing
+      is enabled every Span records a complete event with name, category,
+      start time, duration and thread id; the events are written as a
+      Chrome trace-event JSON file which can be loaded in chrome://tracing
+      or https://ui.perfetto.dev.
+
+      Tracing is enabled either by setting the environment variable
+      OPM_TRACE_FILE to the name of the output file, or by calling
+      enable( filename ) explicitly. The file is written when flush() is
+      called, and when the program exits if there are events which have
+      not been flushed. When tracing is not enabled a Span costs a check
+      of an atomic flag.
+    */
+
+    void enable( const std::string& filename );
+    void disable();
+    bool enabled();
+
+    /*
+      flush() writes all events recorded so far to the trace file,
+      replacing the file written by an earlier flush(); the events are
+      kept, so the file always holds the complete trace. write() writes
+      the recorded events as a trace-event JSON document to the stream,
+      and clear() discards the recorded events.
+    */
+    void flush();
+    void write( std::ostream& os );
+    size_t size();
+    void clear();
+
+    class Span {
+    public:
+        Span( const char* name, const char* category );
+        Span( const std::string& name, const char* category );
+        Span( const std::string& name, const char* category, const std::string& detail );
+        ~Span();
+
+        Span( const Span& ) = delete;
+        Span& operator=( const Span& ) = delete;
+
+    private:
+        bool m_active;
+        std::string m_name;
+        std::string m_detail;
+        const char* m_category;
+        int64_t m_start;
+    };
+
+}
+}
+
+#endif
@@ -104,6 +104,7 @@ set( keywords
      000_Eclipse100/G/GAS
      000_Eclipse100/G/GCONINJE
      000_Eclipse100/G/GCONPROD
+     000_Eclipse100/G/GDFILE
      000_Eclipse100/G/GDORIENT
      000_Eclipse100/G/GECON
      000_Eclipse100/G/GEFAC
@@ -120,6 +121,7 @@ set( keywords
      000_Eclipse100/G/GSATPROD
      000_Eclipse100/I/IMBNUM
      000_Eclipse100/I/IMKRVD
+     000_Eclipse100/I/IMPORT
      000_Eclipse100/I/IMPES
      000_Eclipse100/I/IMPTVD
      000_Eclipse100/I/INCLUDE
@@ -0,0 +1,129 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE ActiveIndexTests
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/EclipseState/Grid/ActiveIndex.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    void checkAgainstNaive( const std::vector< int >& actnum ) {
+        const ActiveIndex index( actnum.size(), actnum.data() );
+
+        std::vector< int > global;
+        for( size_t g = 0; g < actnum.size(); g++ ) {
+            BOOST_CHECK_EQUAL( index.active( g ), actnum[ g ] > 0 );
+            if( actnum[ g ] > 0 ) {
+                BOOST_CHECK_EQUAL( index.activeIndex( g ), global.size() );
+                BOOST_CHECK_EQUAL( index.activeIndexOrNegative( g ), int( global.size() ) );
+                global.push_back( g );
+            } else {
+                BOOST_CHECK_EQUAL( index.activeIndexOrNegative( g ), -1 );
+            }
+        }
+
+        BOOST_CHECK_EQUAL( index.size(), actnum.size() );
+        BOOST_CHECK_EQUAL( index.numActive(), global.size() );
+        BOOST_CHECK_EQUAL( index.allActive(), global.size() == actnum.size() );
+        BOOST_CHECK_EQUAL_COLLECTIONS( index.globalIndices().begin(), index.globalIndices().end(),
+                                       global.begin(), global.end() );
+
+        for( size_t a = 0; a < global.size(); a++ )
+            BOOST_CHECK_EQUAL( index.globalIndex( a ), size_t( global[ a ] ) );
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(Empty) {
+    const ActiveIndex index;
+    BOOST_CHECK_EQUAL( index.size(), 0U );
+    BOOST_CHECK_EQUAL( index.numActive(), 0U );
+    BOOST_CHECK( index.allActive() );
+}
+
+BOOST_AUTO_TEST_CASE(AllActive) {
+    const ActiveIndex index( 130, nullptr );
+    BOOST_CHECK_EQUAL( index.numActive(), 130U );
+    BOOST_CHECK( index.allActive() );
+    for( size_t g = 0; g < 130; g++ )
+        BOOST_CHECK_EQUAL( index.activeIndex( g ), g );
+
+    checkAgainstNaive( std::vector< int >( 130, 1 ) );
+}
+
+BOOST_AUTO_TEST_CASE(NoneActive) {
+    checkAgainstNaive( std::vector< int >( 200, 0 ) );
+}
+
+BOOST_AUTO_TEST_CASE(Patterns) {
+    /* Sizes around the word size, and ACTNUM values other than 0 and 1. */
+    for( size_t size : { 1, 63, 64, 65, 127, 128, 129, 1000 } ) {
+        std::vector< int > actnum( size );
+        uint64_t state = size;
+        for( auto& a : actnum ) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            const int r = int( state >> 61 );
+            a = r < 3 ? 0 : r - 2;
+        }
+        checkAgainstNaive( actnum );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(Equality) {
+    std::vector< int > actnum( 100, 1 );
+    const ActiveIndex all( 100, nullptr );
+    BOOST_CHECK( ActiveIndex( 100, actnum.data() ) == all );
+
+    actnum[ 70 ] = 0;
+    BOOST_CHECK( !( ActiveIndex( 100, actnum.data() ) == all ) );
+}
+
+BOOST_AUTO_TEST_CASE(GridMapping) {
+    EclipseGrid grid( 10, 10, 3 );
+    std::vector< int > actnum( grid.getCartesianSize(), 1 );
+    for( size_t g = 0; g < actnum.size(); g += 3 )
+        actnum[ g ] = 0;
+
+    grid.resetACTNUM( actnum.data() );
+    const auto& active_map = grid.getActiveMap();
+
+    BOOST_CHECK_EQUAL( grid.getNumActive(), active_map.size() );
+    for( size_t a = 0; a < grid.getNumActive(); a++ ) {
+        const size_t g = active_map[ a ];
+        BOOST_CHECK_EQUAL( grid.getGlobalIndex( a ), g );
+        BOOST_CHECK_EQUAL( grid.activeIndex( g ), a );
+        BOOST_CHECK( grid.cellActive( g ) );
+    }
+
+    BOOST_CHECK( !grid.cellActive( 0 ) );
+    BOOST_CHECK_THROW( grid.activeIndex( 0 ), std::invalid_argument );
+
+    const EclipseGrid copy( grid, std::vector< int >() );
+    BOOST_CHECK_EQUAL( copy.getNumActive(), grid.getNumActive() );
+
+    const EclipseGrid all_active( grid, std::vector< int >( grid.getCartesianSize(), 1 ) );
+    BOOST_CHECK( all_active.allActive() );
+}
@@ -0,0 +1,171 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE AllocationBudgetTests
+
+#include <memory>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+#include "AllocationCounter.hpp"
+
+using namespace Opm;
+
+/*
+  These tests assert allocation budgets for parsing and grid construction;
+  the allocations are counted by the operator new replacement in
+  benchmarks/AllocationCounter.cpp. The budgets are deliberately given as
+  the difference between two input sizes, so that the fixed cost of e.g.
+  the keyword lookup does not enter.
+*/
+
+namespace {
+
+    std::string poroDeck( size_t nx, size_t ny, size_t nz, const std::string& data ) {
+        return "RUNSPEC\n"
+               "DIMENS\n " + std::to_string( nx ) + " " + std::to_string( ny ) + " " + std::to_string( nz ) + " /\n"
+               "GRID\n"
+               "PORO\n" + data + " /\n";
+    }
+
+    std::string repeatedPoro( size_t n ) {
+        return poroDeck( n, 1, 1, std::to_string( n ) + "*0.25" );
+    }
+
+    std::string distinctPoro( size_t n ) {
+        std::string data;
+        for( size_t i = 0; i < n; i++ )
+            data += std::to_string( 0.1 + ( i % 1000 ) * 0.0001 ) + ( i % 8 == 7 ? "\n" : " " );
+
+        return poroDeck( n, 1, 1, data );
+    }
+
+    std::string gridDeck( size_t nx, size_t ny, size_t nz ) {
+        const auto n = std::to_string( nx * ny * nz );
+        const auto top = std::to_string( nx * ny );
+        return "RUNSPEC\n"
+               "DIMENS\n " + std::to_string( nx ) + " " + std::to_string( ny ) + " " + std::to_string( nz ) + " /\n"
+               "GRID\n"
+               "DX\n " + n + "*100 /\n"
+               "DY\n " + n + "*100 /\n"
+               "DZ\n " + n + "*10 /\n"
+               "TOPS\n " + top + "*2000 /\n";
+    }
+
+    Benchmark::Allocations parse( const std::string& input ) {
+        Parser parser;
+        ParseContext parseContext;
+
+        const Benchmark::AllocationScope scope;
+        const auto deck = parser.parseString( input, parseContext );
+        return scope.elapsed();
+    }
+
+    Benchmark::Allocations grid( const Deck& deck ) {
+        const Benchmark::AllocationScope scope;
+        const EclipseGrid grid( deck );
+        return scope.elapsed();
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(CounterCountsAllocations) {
+    const Benchmark::AllocationScope scope;
+    std::unique_ptr< double[] > values( new double[ 1000 ] );
+
+    const auto elapsed = scope.elapsed();
+    BOOST_CHECK_EQUAL( elapsed.count, 1U );
+    BOOST_CHECK_EQUAL( elapsed.bytes, 1000 * sizeof( double ) );
+}
+
+/*
+  A repeat counted value 'n*v' is expanded with one insert into the item,
+  i.e. parsing PORO of N values performs O(1) allocations. The small slack
+  allows for the longer strings of the larger deck.
+*/
+BOOST_AUTO_TEST_CASE(RepeatedPoroConstantAllocations) {
+    const auto small = parse( repeatedPoro( 10 ) );
+    const auto large = parse( repeatedPoro( 100000 ) );
+
+    BOOST_TEST_MESSAGE( "N*v: " << small.count << " allocations for N = 10, "
+                        << large.count << " for N = 100000" );
+
+    BOOST_CHECK( large.count <= small.count + 2 );
+    BOOST_CHECK( large.bytes - small.bytes >= ( 100000 - 10 ) * sizeof( double ) );
+}
+
+/*
+  Distinct values are split into string_view tokens stored in blocks, and
+  converted directly into the value vector; there must be no allocation
+  per value.
+*/
+BOOST_AUTO_TEST_CASE(DistinctPoroAllocationsPerValue) {
+    const size_t n = 20000;
+    const auto small = parse( distinctPoro( n ) );
+    const auto large = parse( distinctPoro( 2 * n ) );
+
+    const double per_value = double( large.count - small.count ) / n;
+    BOOST_TEST_MESSAGE( "distinct values: " << per_value << " allocations per value" );
+
+    BOOST_CHECK( per_value < 0.1 );
+}
+
+/*
+  The EclipseGrid does not allocate per cell; the arrays are allocated
+  once, and only the growth of a few of them depends on the size.
+*/
+BOOST_AUTO_TEST_CASE(EclipseGridConstantAllocations) {
+    Parser parser;
+    ParseContext parseContext;
+    const auto small_deck = parser.parseString( gridDeck( 5, 5, 5 ), parseContext );
+    const auto large_deck = parser.parseString( gridDeck( 40, 40, 10 ), parseContext );
+
+    const auto small = grid( small_deck );
+    const auto large = grid( large_deck );
+
+    BOOST_TEST_MESSAGE( "EclipseGrid: " << small.count << " allocations for 125 cells, "
+                        << large.count << " for 16000 cells" );
+
+    BOOST_CHECK( large.count <= small.count + 16 );
+}
+
+#ifdef OPM_PARSE_PROFILING
+BOOST_AUTO_TEST_CASE(KeywordStatisticsAllocations) {
+    Benchmark::installParseStatisticsCounter();
+
+    Parser parser;
+    ParseContext parseContext;
+    parser.setProfiling( true );
+
+    const size_t n = 1000;
+    const auto deck = parser.parseString( distinctPoro( n ), parseContext );
+    const auto& statistics = deck.getParseStatistics();
+    const auto& poro = statistics.keywords().at( "PORO" );
+
+    BOOST_CHECK( poro.allocations > 0 );
+    BOOST_CHECK( poro.allocated_bytes >= n * sizeof( double ) );
+    BOOST_CHECK( statistics.total().allocations >= poro.allocations );
+}
+#endif
@@ -0,0 +1,289 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE BinaryBufferTests
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Utility/BinaryBuffer.hpp>
+#include <opm/parser/eclipse/Utility/SyntheticDeck.hpp>
+
+using namespace Opm;
+
+BOOST_AUTO_TEST_CASE(RoundTrip) {
+    BinaryWriter writer;
+    writer.write( int32_t( -7 ) );
+    writer.write( std::string( "WELL-1" ) );
+    writer.writeArray( std::vector< double >{ 1.5, 2.5, 3.5 } );
+    writer.write( uint8_t( 1 ) );
+    writer.writeArray( std::vector< int >{ 4, 5 } );
+    writer.writeArray( std::vector< bool >{ true, false, true } );
+    writer.writeArray( std::vector< std::string >{ "A", "", "BC" } );
+
+    const auto buffer = writer.release();
+
+    BinaryReader reader( buffer.data(), buffer.size() );
+    BOOST_CHECK_EQUAL( -7, reader.read< int32_t >() );
+    BOOST_CHECK_EQUAL( "WELL-1", reader.readString() );
+
+    /* The view points straight into the buffer. */
+    const auto view = reader.readView< double >();
+    BOOST_CHECK_EQUAL( 3U, view.size );
+    const auto* bytes = reinterpret_cast< const char* >( view.data );
+    BOOST_CHECK( bytes > buffer.data() && bytes < buffer.data() + buffer.size() );
+    BOOST_CHECK_EQUAL( 0U, reinterpret_cast< uintptr_t >( view.data ) % 8 );
+    BOOST_CHECK_EQUAL( 2.5, view.data[ 1 ] );
+
+    BOOST_CHECK_EQUAL( 1, reader.read< uint8_t >() );
+    const std::vector< int > ints = { 4, 5 };
+    BOOST_CHECK( ints == reader.readArray< int >() );
+    const std::vector< bool > bools = { true, false, true };
+    BOOST_CHECK( bools == reader.readBoolArray() );
+    const std::vector< std::string > strings = { "A", "", "BC" };
+    BOOST_CHECK( strings == reader.readStringArray() );
+    BOOST_CHECK( reader.atEnd() );
+    BOOST_CHECK_THROW( reader.read< int32_t >(), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE(InvalidBuffer) {
+    BinaryWriter writer;
+    writer.writeArray( std::vector< double >( 10, 1.0 ) );
+    auto buffer = writer.release();
+
+    BOOST_CHECK_THROW( BinaryReader( buffer.data(), 8 ), std::runtime_error );
+
+    BinaryReader truncated( buffer.data(), buffer.size() - 8 );
+    BOOST_CHECK_THROW( truncated.readView< double >(), std::runtime_error );
+
+    buffer[ 8 ]++;
+    BOOST_CHECK_THROW( BinaryReader( buffer.data(), buffer.size() ), std::runtime_error );
+    buffer[ 8 ]--;
+    buffer[ 0 ] = 'X';
+    BOOST_CHECK_THROW( BinaryReader( buffer.data(), buffer.size() ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_CASE(ReadFile) {
+    BinaryWriter writer;
+    writer.writeArray( std::vector< int >{ 1, 2, 3 } );
+
+    const auto filename = ( boost::filesystem::temp_directory_path()
+                          / boost::filesystem::unique_path( "BinaryBuffer-%%%%-%%%%.bin" ) ).string();
+    writer.writeFile( filename );
+
+    {
+        BinaryReader reader( filename );
+        const auto view = reader.readView< int >();
+        BOOST_CHECK_EQUAL( 3U, view.size );
+        BOOST_CHECK_EQUAL( 3, view.data[ 2 ] );
+        BOOST_CHECK( reader.atEnd() );
+    }
+
+    boost::filesystem::remove( filename );
+    BOOST_CHECK_THROW( BinaryReader reader( filename ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(ReadShared) {
+    BinaryWriter writer;
+    writer.writeArray( std::vector< double >{ 1.5, 2.5, 3.5 } );
+    writer.writeArray( std::vector< double >{ 1.5, 2.5, 3.5 } );
+    const auto buffer = std::make_shared< const std::vector< char > >( writer.release() );
+    const char* begin = buffer->data();
+    const char* end = begin + buffer->size();
+
+    std::shared_ptr< const double > shared, copied;
+    size_t size;
+    {
+        BinaryReader owner( buffer );
+        shared = owner.readShared< double >( size );
+        BOOST_CHECK_EQUAL( 3U, size );
+
+        BinaryReader borrower( buffer->data(), buffer->size() );
+        borrower.readView< double >();
+        copied = borrower.readShared< double >( size );
+    }
+
+    /* A reader which owns the buffer shares it; otherwise the array is copied. */
+    const auto* bytes = reinterpret_cast< const char* >( shared.get() );
+    BOOST_CHECK( bytes > begin && bytes < end );
+    BOOST_CHECK_EQUAL( 2U, buffer.use_count() );
+    bytes = reinterpret_cast< const char* >( copied.get() );
+    BOOST_CHECK( bytes < begin || bytes >= end );
+    BOOST_CHECK_EQUAL( 2.5, shared.get()[ 1 ] );
+    BOOST_CHECK_EQUAL( 3.5, copied.get()[ 2 ] );
+}
+
+BOOST_AUTO_TEST_CASE(SerializeDeck) {
+    SyntheticDeck::Options options;
+    options.wells = 3;
+    options.steps = 4;
+
+    ParseContext parseContext;
+    const auto deck = Parser().parseString( SyntheticDeck( options ).str(), parseContext );
+
+    BinaryWriter writer;
+    deck.serialize( writer );
+    const auto buffer = writer.release();
+
+    BinaryReader reader( buffer.data(), buffer.size() );
+    const Deck copy( reader );
+    BOOST_CHECK( reader.atEnd() );
+
+    BOOST_CHECK_EQUAL( deck.size(), copy.size() );
+    for( size_t index = 0; index < deck.size(); index++ )
+        BOOST_CHECK( deck.getKeyword( index ).equal( copy.getKeyword( index ), true, false ) );
+
+    BOOST_CHECK_EQUAL( deck.getDataFile(), copy.getDataFile() );
+    BOOST_CHECK( deck.getActiveUnitSystem().getType() == copy.getActiveUnitSystem().getType() );
+    BOOST_CHECK_EQUAL( deck.getKeyword( "PORO" ).getLineNumber(), copy.getKeyword( "PORO" ).getLineNumber() );
+
+    const EclipseState state( copy, parseContext );
+    const Schedule schedule( copy, state, parseContext );
+    BOOST_CHECK_EQUAL( options.nx * options.ny * options.nz, state.getInputGrid().getCartesianSize() );
+    BOOST_CHECK_EQUAL( 3U, schedule.numWells() );
+    BOOST_CHECK( copy.getKeyword( "PORO" ).getSIDoubleData() == deck.getKeyword( "PORO" ).getSIDoubleData() );
+}
+
+BOOST_AUTO_TEST_CASE(SerializeEclipseState) {
+    SyntheticDeck::Options options;
+    options.faults = 2;
+
+    ParseContext parseContext;
+    const auto deck = Parser().parseString( SyntheticDeck( options ).str(), parseContext );
+    const EclipseState state( deck, parseContext );
+
+    BinaryWriter writer;
+    deck.serialize( writer );
+    state.serialize( writer );
+    auto buffer = std::make_shared< const std::vector< char > >( writer.release() );
+
+    BinaryReader reader( buffer );
+    const Deck deckCopy( reader );
+    const EclipseState copy( deckCopy, parseContext, reader );
+    BOOST_CHECK( reader.atEnd() );
+
+    /* The grid arrays are still in use after the reader is gone. */
+    buffer.reset();
+
+    const auto& grid = state.getInputGrid();
+    const auto& gridCopy = copy.getInputGrid();
+    BOOST_CHECK( grid.getNXYZ() == gridCopy.getNXYZ() );
+    BOOST_CHECK_EQUAL( grid.getNumActive(), gridCopy.getNumActive() );
+    std::vector< double > coord, coordCopy, zcorn, zcornCopy;
+    grid.exportCOORD( coord );
+    gridCopy.exportCOORD( coordCopy );
+    grid.exportZCORN( zcorn );
+    gridCopy.exportZCORN( zcornCopy );
+    BOOST_CHECK( coord == coordCopy );
+    BOOST_CHECK( zcorn == zcornCopy );
+    for( size_t g = 0; g < grid.getCartesianSize(); g++ )
+        BOOST_CHECK_EQUAL( grid.getCellVolume( g ), gridCopy.getCellVolume( g ) );
+
+    const auto& props = state.get3DProperties();
+    const auto& propsCopy = copy.get3DProperties();
+    for( const auto& keyword : { "PORO", "PERMX", "PORV" } ) {
+        BOOST_CHECK_EQUAL( props.hasDeckDoubleGridProperty( keyword ), propsCopy.hasDeckDoubleGridProperty( keyword ) );
+        BOOST_CHECK( props.getDoubleGridProperty( keyword ).getData() == propsCopy.getDoubleGridProperty( keyword ).getData() );
+    }
+    for( const auto& keyword : { "ACTNUM", "SATNUM", "FIPNUM" } )
+        BOOST_CHECK( props.getIntGridProperty( keyword ).getData() == propsCopy.getIntGridProperty( keyword ).getData() );
+
+    const auto& mult = state.getTransMult();
+    const auto& multCopy = copy.getTransMult();
+    for( const auto dir : { FaceDir::XPlus, FaceDir::XMinus, FaceDir::YPlus, FaceDir::YMinus, FaceDir::ZPlus, FaceDir::ZMinus } ) {
+        BOOST_CHECK( mult.getMultipliers( dir ).exportDense() == multCopy.getMultipliers( dir ).exportDense() );
+        BOOST_CHECK_EQUAL( mult.getMultipliers( dir ).isDense(), multCopy.getMultipliers( dir ).isDense() );
+    }
+    BOOST_CHECK_EQUAL( mult.getRegionMultiplier( 0, 1, FaceDir::XPlus ), multCopy.getRegionMultiplier( 0, 1, FaceDir::XPlus ) );
+    BOOST_CHECK_EQUAL( state.getFaults().size(), copy.getFaults().size() );
+}
+
+/*
+  The cells of a grid with DX varying in j and k do not share corners,
+  so the grid can not be written as COORD and ZCORN.
+*/
+BOOST_AUTO_TEST_CASE(SerializeCartesianGrid) {
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 3 3 2 /\n"
+        "GRID\n"
+        "DX\n"
+        " 3*10 3*15 3*20 3*13 3*18 3*23 /\n"
+        "DY\n"
+        " 6*10 6*12 6*14 /\n"
+        "DZ\n"
+        " 18*5 /\n"
+        "TOPS\n"
+        " 9*1000 /\n"
+        "ACTNUM\n"
+        " 4*1 0 13*1 /\n"
+        "EDIT\n"
+        "\n";
+
+    const EclipseGrid grid( Parser().parseString( deckData, ParseContext() ) );
+
+    BinaryWriter writer;
+    grid.serialize( writer );
+    const auto buffer = writer.release();
+
+    BinaryReader reader( buffer.data(), buffer.size() );
+    const EclipseGrid copy( reader );
+    BOOST_CHECK( reader.atEnd() );
+
+    BOOST_CHECK_EQUAL( grid.getNumActive(), copy.getNumActive() );
+    BOOST_CHECK( !copy.cellActive( 4 ) );
+    for( size_t g = 0; g < grid.getCartesianSize(); g++ ) {
+        BOOST_CHECK_EQUAL( grid.getCellVolume( g ), copy.getCellVolume( g ) );
+        BOOST_CHECK( grid.getCellCenter( g ) == copy.getCellCenter( g ) );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SerializeNNC) {
+    NNC nnc;
+    nnc.addNNC( 0, 7, 0.5 );
+    nnc.addNNC( 3, 2, 1.25 );
+
+    BinaryWriter writer;
+    nnc.serialize( writer );
+    const auto buffer = writer.release();
+
+    BinaryReader reader( buffer.data(), buffer.size() );
+    const NNC copy( reader );
+    BOOST_REQUIRE_EQUAL( 2U, copy.numNNC() );
+    BOOST_CHECK_EQUAL( 3U, copy.nncdata()[ 1 ].cell1 );
+    BOOST_CHECK_EQUAL( 2U, copy.nncdata()[ 1 ].cell2 );
+    BOOST_CHECK_EQUAL( 1.25, copy.nncdata()[ 1 ].trans );
+
+    BinaryWriter empty;
+    empty.write( uint64_t( 1 ) );
+    const auto truncated = empty.release();
+    BinaryReader invalid( truncated.data(), truncated.size() );
+    BOOST_CHECK_THROW( NNC{ invalid }, std::runtime_error );
+}
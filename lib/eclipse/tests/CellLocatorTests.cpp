@@ -0,0 +1,242 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#define BOOST_TEST_MODULE CellLocatorTests
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/CellLocator.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    /*
+      A corner point grid with sloping pillars, where the ZCORN values
+      are displaced by up to +/- perturbation.
+    */
+    EclipseGrid cornerPointGrid( int nx, int ny, int nz, double shear, double perturbation ) {
+        std::array< int, 3 > dims = {{ nx, ny, nz }};
+        CoordMapper cm( nx, ny );
+        ZcornMapper zm( nx, ny, nz );
+        std::vector< double > coord( cm.size() );
+        std::vector< double > zcorn( zm.size() );
+
+        for( int j = 0; j <= ny; j++ ) {
+            for( int i = 0; i <= nx; i++ ) {
+                for( size_t layer = 0; layer < 2; layer++ ) {
+                    const double z = 900 + 500 * layer;
+                    coord[ cm.index( i, j, 0, layer ) ] = 100 * i + shear * z;
+                    coord[ cm.index( i, j, 1, layer ) ] = 50 * j;
+                    coord[ cm.index( i, j, 2, layer ) ] = z;
+                }
+            }
+        }
+
+        for( int k = 0; k < nz; k++ ) {
+            for( int j = 0; j < ny; j++ ) {
+                for( int i = 0; i < nx; i++ ) {
+                    for( int c = 0; c < 8; c++ ) {
+                        const int pi = i + ( c & 1 );
+                        const int pj = j + ( ( c >> 1 ) & 1 );
+                        const int pk = k + ( c >> 2 );
+                        const double noise = perturbation * std::sin( 1.3 * pi + 2.1 * pj + 0.7 * pk );
+                        zcorn[ zm.index( i, j, k, c ) ] = 1000 + 10 * pk + 2.0 * pi + 1.5 * pj + noise;
+                    }
+                }
+            }
+        }
+
+        return EclipseGrid( dims, std::move( coord ), std::move( zcorn ) );
+    }
+
+    std::vector< CellLocator::corners > allCorners( const EclipseGrid& grid ) {
+        std::vector< CellLocator::corners > cells( grid.getCartesianSize() );
+        for( size_t g = 0; g < cells.size(); g++ )
+            for( int c = 0; c < 8; c++ )
+                cells[ g ][ c ] = grid.getCornerPos( g % grid.getNX(),
+                                                     ( g / grid.getNX() ) % grid.getNY(),
+                                                     g / ( grid.getNX() * grid.getNY() ), c );
+        return cells;
+    }
+
+    /* A deterministic sequence of numbers in [0,1). */
+    double nextRandom( unsigned long& state ) {
+        state = ( state * 6364136223846793005UL + 1442695040888963407UL );
+        return double( state >> 11 ) / double( 1UL << 53 );
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(RegularGrid) {
+    const EclipseGrid grid( 4, 3, 2, 10, 20, 5 );
+    const auto& locator = grid.locator();
+
+    for( size_t g = 0; g < grid.getCartesianSize(); g++ ) {
+        const auto ijk = grid.getIJK( g );
+        const CellLocator::point center = {{ 5.0 + 10 * ijk[ 0 ], 10.0 + 20 * ijk[ 1 ], 2.5 + 5 * ijk[ 2 ] }};
+        BOOST_CHECK_EQUAL( locator.findCell( center ), int( g ) );
+    }
+
+    BOOST_CHECK_EQUAL( locator.findCell( {{ -1, 10, 2 }} ), -1 );
+    BOOST_CHECK_EQUAL( locator.findCell( {{ 5, 10, 10.5 }} ), -1 );
+    BOOST_CHECK_EQUAL( locator.findCell( {{ 39.9, 59.9, 9.9 }} ), 23 );
+
+    /* A vertical segment through the column (1,2). */
+    const auto column = locator.findCells( {{ 15, 50, -10 }}, {{ 15, 50, 20 }} );
+    BOOST_CHECK( column == std::vector< size_t >( { 9, 21 } ) );
+
+    /* A horizontal segment along the row (j,k) = (1,1), in both directions. */
+    const auto row = locator.findCells( {{ -5, 30, 7.5 }}, {{ 45, 30, 7.5 }} );
+    BOOST_CHECK( row == std::vector< size_t >( { 16, 17, 18, 19 } ) );
+
+    const auto reversed = locator.findCells( {{ 45, 30, 7.5 }}, {{ 12, 30, 7.5 }} );
+    BOOST_CHECK( reversed == std::vector< size_t >( { 19, 18, 17 } ) );
+
+    /* Segments starting inside, outside the grid and of zero length. */
+    BOOST_CHECK( locator.findCells( {{ 5, 10, 2 }}, {{ 5, 10, 3 }} ) == std::vector< size_t >( { 0 } ) );
+    BOOST_CHECK( locator.findCells( {{ 5, 10, 2 }}, {{ 5, 10, 2 }} ) == std::vector< size_t >( { 0 } ) );
+    BOOST_CHECK( locator.findCells( {{ 50, 10, 2 }}, {{ 60, 10, 2 }} ).empty() );
+
+    /* Copies of the grid share the locator. */
+    const EclipseGrid copy( grid );
+    BOOST_CHECK( &copy.locator() == &locator );
+}
+
+BOOST_AUTO_TEST_CASE(CornerPointGridAgainstBruteForce) {
+    const auto grid = cornerPointGrid( 6, 5, 4, 0.1, 3.0 );
+    const auto& locator = grid.locator();
+    const auto cells = allCorners( grid );
+
+    for( size_t g = 0; g < cells.size(); g++ ) {
+        CellLocator::point center = {{ 0, 0, 0 }};
+        for( const auto& p : cells[ g ] )
+            for( int d = 0; d < 3; d++ )
+                center[ d ] += p[ d ] / 8;
+
+        BOOST_CHECK( CellLocator::contains( cells[ g ], center ) );
+        BOOST_CHECK_EQUAL( locator.findCell( center ), int( g ) );
+    }
+
+    unsigned long state = 17;
+    for( int n = 0; n < 500; n++ ) {
+        const CellLocator::point p = {{ -20 + 700 * nextRandom( state ),
+                                        -20 + 290 * nextRandom( state ),
+                                        990 + 70 * nextRandom( state ) }};
+        int expected = -1;
+        for( size_t g = 0; g < cells.size() && expected < 0; g++ )
+            if( CellLocator::contains( cells[ g ], p ) ) expected = int( g );
+
+        BOOST_CHECK_EQUAL( locator.findCell( p ), expected );
+    }
+
+    for( int n = 0; n < 50; n++ ) {
+        const CellLocator::point a = {{ -50 + 750 * nextRandom( state ),
+                                        -50 + 350 * nextRandom( state ),
+                                        980 + 90 * nextRandom( state ) }};
+        const CellLocator::point b = {{ -50 + 750 * nextRandom( state ),
+                                        -50 + 350 * nextRandom( state ),
+                                        980 + 90 * nextRandom( state ) }};
+
+        std::vector< size_t > expected;
+        for( size_t g = 0; g < cells.size(); g++ ) {
+            double t;
+            if( CellLocator::intersects( cells[ g ], a, b, t ) ) expected.push_back( g );
+        }
+
+        auto found = locator.findCells( a, b );
+        std::sort( found.begin(), found.end() );
+        BOOST_CHECK( found == expected );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(SegmentThroughColumn) {
+    const auto grid = cornerPointGrid( 3, 3, 5, 0.2, 2.0 );
+    const auto& locator = grid.locator();
+
+    /* A sloping well path through the middle column, from the top to the bottom. */
+    const auto cells = locator.findCells( {{ 150 + 0.2 * 900, 75, 950 }}, {{ 150 + 0.2 * 1100, 75, 1100 }} );
+    BOOST_REQUIRE_EQUAL( cells.size(), 5U );
+    for( size_t k = 0; k < 5; k++ ) {
+        const auto ijk = grid.getIJK( cells[ k ] );
+        BOOST_CHECK_EQUAL( ijk[ 0 ], 1 );
+        BOOST_CHECK_EQUAL( ijk[ 1 ], 1 );
+        BOOST_CHECK_EQUAL( ijk[ 2 ], int( k ) );
+    }
+}
+
+/*
+  With DX varying in j and k the cells do not share corners with their
+  neighbours; the locator must use the corners of each cell, as given
+  by getCornerPos().
+*/
+BOOST_AUTO_TEST_CASE(DXVaryingInJAndK) {
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 3 3 2 /\n"
+        "GRID\n"
+        "DX\n"
+        " 3*10 3*15 3*20 3*13 3*18 3*23 /\n"
+        "DY\n"
+        " 18*10 /\n"
+        "DZ\n"
+        " 18*5 /\n"
+        "TOPS\n"
+        " 9*1000 /\n"
+        "EDIT\n"
+        "\n";
+
+    Parser parser;
+    const EclipseGrid grid( parser.parseString( deckData, ParseContext() ) );
+    const auto& locator = grid.locator();
+    const auto cells = allCorners( grid );
+
+    for( size_t g = 0; g < cells.size(); g++ )
+        BOOST_CHECK_EQUAL( locator.findCell( grid.getCellCenter( g ) ), int( g ) );
+
+    unsigned long state = 5;
+    for( int n = 0; n < 500; n++ ) {
+        const CellLocator::point p = {{ -5 + 75 * nextRandom( state ),
+                                        -5 + 40 * nextRandom( state ),
+                                        995 + 15 * nextRandom( state ) }};
+        int expected = -1;
+        for( size_t g = 0; g < cells.size() && expected < 0; g++ )
+            if( CellLocator::contains( cells[ g ], p ) ) expected = int( g );
+
+        BOOST_CHECK_EQUAL( locator.findCell( p ), expected );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(InvalidInput) {
+    auto coord = std::make_shared< const std::vector< double > >( 10 );
+    auto zcorn = std::make_shared< const std::vector< double > >( 8 );
+    BOOST_CHECK_THROW( CellLocator( GridDims( 1, 1, 1 ), coord, zcorn ), std::invalid_argument );
+}
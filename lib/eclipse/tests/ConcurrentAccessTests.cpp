@@ -0,0 +1,227 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#define BOOST_TEST_MODULE ConcurrentAccessTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Deck/DeckItem.hpp>
+#include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
+#include <opm/parser/eclipse/Deck/DeckRecord.hpp>
+#include <opm/parser/eclipse/EclipseState/Eclipse3DProperties.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/CellLocator.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridProperties.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+using namespace Opm;
+
+/*
+  The readers run the same queries concurrently, and the results are
+  compared with those of a state which is queried from one thread. The
+  Boost.Test macros are not thread safe, so the threads only record
+  what they see. Build with ENABLE_THREAD_SANITIZER to check for races.
+*/
+
+namespace {
+
+    const size_t numThreads = 8;
+
+    Deck makeDeck() {
+        const std::string deckData =
+            "RUNSPEC\n"
+            "DIMENS\n"
+            " 10 8 5 /\n"
+            "GRID\n"
+            "DX\n"
+            " 400*100 /\n"
+            "DY\n"
+            " 400*50 /\n"
+            "DZ\n"
+            " 400*2 /\n"
+            "TOPS\n"
+            " 80*1000 /\n"
+            "PORO\n"
+            " 400*0.25 /\n"
+            "PERMX\n"
+            " 400*100 /\n"
+            "ACTNUM\n"
+            " 13*1 0 200*1 0 185*1 /\n"
+            "EDIT\n"
+            "PROPS\n"
+            "REGIONS\n"
+            "SOLUTION\n";
+
+        return Parser().parseString( deckData, ParseContext() );
+    }
+
+    template< typename F >
+    void runConcurrently( F f ) {
+        std::vector< std::thread > threads;
+        for( size_t t = 0; t < numThreads; t++ )
+            threads.emplace_back( f, t );
+
+        for( auto& thread : threads )
+            thread.join();
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(DeckItemSIData) {
+    const auto deck = makeDeck();
+    const auto& item = deck.getKeyword( "DX" ).getRecord( 0 ).getItem( 0 );
+
+    std::vector< const std::vector< double >* > data( numThreads );
+    runConcurrently( [&]( size_t t ) {
+        data[ t ] = &item.getSIDoubleData();
+    } );
+
+    for( const auto* d : data )
+        BOOST_CHECK_EQUAL( data[ 0 ], d );
+
+    BOOST_CHECK_EQUAL( 400U, data[ 0 ]->size() );
+    BOOST_CHECK_CLOSE( 100, data[ 0 ]->front(), 1e-12 );
+
+    const DeckItem copy( item );
+    BOOST_CHECK( copy.getSIDoubleData() == item.getSIDoubleData() );
+}
+
+BOOST_AUTO_TEST_CASE(GridLazyState) {
+    const auto deck = makeDeck();
+    const EclipseGrid grid( deck );
+    const EclipseGrid serial( deck );
+
+    std::vector< const GridGeometry* > geometries( numThreads );
+    std::vector< const CellLocator* > locators( numThreads );
+    std::vector< std::vector< double > > volumes( numThreads );
+    std::vector< std::vector< double > > depths( numThreads );
+    std::vector< int > found( numThreads );
+
+    runConcurrently( [&]( size_t t ) {
+        geometries[ t ] = &grid.geometry();
+        volumes[ t ] = grid.getCellVolumes( true );
+
+        const EclipseGrid copy( grid );
+        depths[ t ] = copy.getCellDepths( t % 2 == 0 );
+
+        locators[ t ] = &grid.locator();
+        const auto& center = grid.getCellCenters( false )[ 17 ];
+        found[ t ] = copy.locator().findCell( center );
+    } );
+
+    for( size_t t = 0; t < numThreads; t++ ) {
+        BOOST_CHECK_EQUAL( geometries[ 0 ], geometries[ t ] );
+        BOOST_CHECK_EQUAL( locators[ 0 ], locators[ t ] );
+        BOOST_CHECK( volumes[ t ] == serial.getCellVolumes( true ) );
+        BOOST_CHECK( depths[ t ] == serial.getCellDepths( t % 2 == 0 ) );
+        BOOST_CHECK_EQUAL( 17, found[ t ] );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AutoCreatedProperties) {
+    const auto deck = makeDeck();
+    const EclipseState state( deck, ParseContext() );
+    const EclipseState serial( deck, ParseContext() );
+    const auto& props = state.get3DProperties();
+
+    std::vector< std::vector< double > > porv( numThreads );
+    std::vector< std::vector< int > > satnum( numThreads );
+    std::vector< std::vector< double > > ntg( numThreads );
+
+    runConcurrently( [&]( size_t t ) {
+        porv[ t ] = props.getDoubleGridProperty( "PORV" ).getData();
+        satnum[ t ] = props.getIntGridProperty( "SATNUM" ).getData();
+        ntg[ t ] = props.getDoubleGridProperty( "NTG" ).getData();
+        props.getIntProperties().hasKeyword( "FIPNUM" );
+        props.getIntProperties().getKeyword( "FIPNUM" );
+    } );
+
+    const auto& expected = serial.get3DProperties();
+    for( size_t t = 0; t < numThreads; t++ ) {
+        BOOST_CHECK( porv[ t ] == expected.getDoubleGridProperty( "PORV" ).getData() );
+        BOOST_CHECK( satnum[ t ] == expected.getIntGridProperty( "SATNUM" ).getData() );
+        BOOST_CHECK( ntg[ t ] == expected.getDoubleGridProperty( "NTG" ).getData() );
+    }
+
+    BOOST_CHECK( props.getIntProperties().hasKeyword( "FIPNUM" ) );
+    BOOST_CHECK( !props.getIntProperties().hasDeckKeyword( "FIPNUM" ) );
+}
+
+BOOST_AUTO_TEST_CASE(Finalize) {
+    const auto deck = makeDeck();
+    const EclipseState state( deck, ParseContext() );
+    state.finalize();
+
+    const auto& doubleProps = state.get3DProperties().getDoubleProperties();
+    BOOST_CHECK( doubleProps.hasKeyword( "PORV" ) );
+    BOOST_CHECK( !doubleProps.hasDeckKeyword( "PORV" ) );
+    BOOST_CHECK( doubleProps.hasDeckKeyword( "PORO" ) );
+
+    const auto& grid = state.getInputGrid();
+    std::vector< size_t > sizes( numThreads );
+    runConcurrently( [&]( size_t t ) {
+        double sum = 0;
+        for( const auto& property : doubleProps )
+            sum += property.getData().size();
+        sizes[ t ] = sum + grid.getCellVolumes( true ).size();
+    } );
+
+    for( size_t t = 0; t < numThreads; t++ )
+        BOOST_CHECK_EQUAL( sizes[ 0 ], sizes[ t ] );
+
+    BOOST_CHECK_EQUAL( 398U, grid.getCellVolumes( true ).size() );
+}
+
+BOOST_AUTO_TEST_CASE(FinalizedGetKeyword) {
+    const auto deck = makeDeck();
+    const EclipseState state( deck, ParseContext() );
+    state.finalize();
+
+    const auto& intProps = state.get3DProperties().getIntProperties();
+    BOOST_CHECK_THROW( intProps.getKeyword( "ROCKNUM" ), std::invalid_argument );
+    BOOST_CHECK_THROW( intProps.getKeyword( "NOT-SUPPORTED" ), std::invalid_argument );
+    BOOST_CHECK( !intProps.hasKeyword( "ROCKNUM" ) );
+
+    intProps.getOrCreateKeyword( "ROCKNUM" );
+    BOOST_CHECK( intProps.hasKeyword( "ROCKNUM" ) );
+    BOOST_CHECK_EQUAL( 1, intProps.getKeyword( "ROCKNUM" ).iget( 0 ) );
+
+    /* A copy of the properties creates properties under a mutex of its own. */
+    const auto copy = state.get3DProperties();
+    std::vector< std::vector< double > > ntg( numThreads );
+    runConcurrently( [&]( size_t t ) {
+        ntg[ t ] = copy.getDoubleGridProperty( "NTG" ).getData();
+        copy.getIntGridProperty( "MISCNUM" );
+    } );
+
+    for( size_t t = 0; t < numThreads; t++ )
+        BOOST_CHECK( ntg[ t ] == std::vector< double >( 400, 1.0 ) );
+
+    BOOST_CHECK( copy.getIntProperties().hasKeyword( "MISCNUM" ) );
+    BOOST_CHECK( !intProps.hasKeyword( "MISCNUM" ) );
+}
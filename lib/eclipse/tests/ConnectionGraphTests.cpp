@@ -0,0 +1,241 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#define BOOST_TEST_MODULE ConnectionGraphTests
+
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/ConnectionGraph.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 3 2 2 /\n"
+        "GRID\n"
+        "DX\n"
+        " 12*10 /\n"
+        "DY\n"
+        " 12*10 /\n"
+        "DZ\n"
+        " 12*5 /\n"
+        "TOPS\n"
+        " 6*100 /\n"
+        "ACTNUM\n"
+        " 1 1 1 1 0 1  1 1 1 1 1 1 /\n"
+        "MULTX\n"
+        " 0.5 11*1 /\n"
+        "MULTZ-\n"
+        " 6*1 0.25 5*1 /\n"
+        "FLUXNUM\n"
+        " 1 1 2 1 1 2  1 1 2 1 1 2 /\n"
+        "FAULTS\n"
+        "  'F1'  1 1  1 2  1 2  'X' /\n"
+        "/\n"
+        "MULTFLT\n"
+        "  'F1' 0.1 /\n"
+        "/\n"
+        "MULTREGT\n"
+        "  1 2 0.75 XYZ ALL F /\n"
+        "/\n"
+        "EDIT\n"
+        "NNC\n"
+        "  1 1 1  3 2 2  7.5 /\n"
+        "  2 2 1  1 1 2  1.0 /\n"
+        "/\n"
+        "PROPS\n"
+        "SOLUTION\n";
+
+    EclipseState makeState() {
+        ParseContext parseContext;
+        const auto deck = Parser().parseString( deckData, parseContext );
+        return EclipseState( deck, parseContext );
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(CartesianAndNNC) {
+    const auto state = makeState();
+    const auto& grid = state.getInputGrid();
+    const auto graph = state.getConnectionGraph();
+
+    BOOST_CHECK_EQUAL( graph.numCells(), 11U );
+    const auto& offsets = graph.offsets();
+    const auto& neighbours = graph.neighbours();
+    const auto& faces = graph.faces();
+    const auto& mult = graph.multipliers();
+    const auto& trans = graph.nncTrans();
+
+    /*
+      Cell (0,0,0) connects to (1,0,0) through the fault and MULTX, to
+      (0,1,0) and (0,0,1), and to (2,1,1) through the first NNC, which
+      crosses from FLUXNUM region 1 to 2; the second NNC is from an
+      inactive cell.
+    */
+    const int a0 = grid.activeIndex( 0 );
+    BOOST_REQUIRE_EQUAL( offsets[ a0 + 1 ] - offsets[ a0 ], 4U );
+    size_t c = offsets[ a0 ];
+    BOOST_CHECK_EQUAL( neighbours[ c ], grid.activeIndex( 1 ) );
+    BOOST_CHECK_EQUAL( faces[ c ], FaceDir::XPlus );
+    BOOST_CHECK_CLOSE( mult[ c ], 0.5 * 0.1, 1e-12 );
+    BOOST_CHECK_EQUAL( trans[ c ], 0 );
+
+    c++;
+    BOOST_CHECK_EQUAL( neighbours[ c ], grid.activeIndex( 3 ) );
+    BOOST_CHECK_EQUAL( faces[ c ], FaceDir::YPlus );
+    BOOST_CHECK_CLOSE( mult[ c ], 1.0, 1e-12 );
+
+    c++;
+    BOOST_CHECK_EQUAL( neighbours[ c ], grid.activeIndex( 6 ) );
+    BOOST_CHECK_EQUAL( faces[ c ], FaceDir::ZPlus );
+    BOOST_CHECK_CLOSE( mult[ c ], 0.25, 1e-12 );
+
+    c++;
+    BOOST_CHECK_EQUAL( neighbours[ c ], grid.activeIndex( 11 ) );
+    BOOST_CHECK_EQUAL( faces[ c ], 0 );
+    BOOST_CHECK_CLOSE( mult[ c ], 0.75, 1e-12 );
+    BOOST_CHECK_EQUAL( trans[ c ], state.getInputNNC().nncdata()[ 0 ].trans );
+}
+
+BOOST_AUTO_TEST_CASE(MatchesTransMult) {
+    const auto state = makeState();
+    const auto& grid = state.getInputGrid();
+    const auto& transMult = state.getTransMult();
+    const auto graph = state.getConnectionGraph();
+
+    const auto& offsets = graph.offsets();
+    const auto& neighbours = graph.neighbours();
+    const auto& faces = graph.faces();
+    const auto& mult = graph.multipliers();
+
+    size_t cartesian = 0;
+    for( size_t a = 0; a < graph.numCells(); a++ ) {
+        for( size_t c = offsets[ a ]; c < offsets[ a + 1 ]; c++ ) {
+            const size_t n = neighbours[ c ];
+
+            /* The graph is symmetric. */
+            bool found = false;
+            for( size_t r = offsets[ n ]; r < offsets[ n + 1 ]; r++ )
+                if( size_t( neighbours[ r ] ) == a && mult[ r ] == mult[ c ] ) found = true;
+            BOOST_CHECK( found );
+
+            if( faces[ c ] == 0 ) continue;
+            cartesian++;
+
+            size_t g1 = grid.getGlobalIndex( a );
+            size_t g2 = grid.getGlobalIndex( n );
+            if( g1 > g2 ) std::swap( g1, g2 );
+
+            FaceDir::DirEnum plus, minus;
+            if( g2 - g1 == 1 ) { plus = FaceDir::XPlus; minus = FaceDir::XMinus; }
+            else if( g2 - g1 == grid.getNX() ) { plus = FaceDir::YPlus; minus = FaceDir::YMinus; }
+            else { plus = FaceDir::ZPlus; minus = FaceDir::ZMinus; }
+
+            const double expected = transMult.getMultiplier( g1, plus )
+                                  * transMult.getMultiplier( g2, minus )
+                                  * transMult.getRegionMultiplier( g1, g2, plus );
+            BOOST_CHECK_CLOSE( mult[ c ], expected, 1e-12 );
+        }
+    }
+
+    /*
+      There are 20 Cartesian connections in the 3x2x2 grid, and the
+      inactive cell (1,1,0) takes part in four of them.
+    */
+    BOOST_CHECK_EQUAL( cartesian, 2 * ( 20 - 4 ) );
+    BOOST_CHECK_EQUAL( graph.numConnections(), cartesian + 2 );
+}
+
+namespace {
+
+    /*
+      A 3x1x1 grid where the last cell is in FLUXNUM region 2, with an
+      NNC from the first to the last cell and a MULTREGT record between
+      the regions with the given NNC behaviour.
+    */
+    EclipseState makeNNCState( const std::string& nncBehaviour ) {
+        const std::string data =
+            "RUNSPEC\n"
+            "DIMENS\n"
+            " 3 1 1 /\n"
+            "GRID\n"
+            "DX\n"
+            " 3*10 /\n"
+            "DY\n"
+            " 3*10 /\n"
+            "DZ\n"
+            " 3*5 /\n"
+            "TOPS\n"
+            " 3*100 /\n"
+            "FLUXNUM\n"
+            " 1 1 2 /\n"
+            "MULTREGT\n"
+            "  1 2 0.5 XYZ " + nncBehaviour + " F /\n"
+            "/\n"
+            "EDIT\n"
+            "NNC\n"
+            "  1 1 1  3 1 1  2.0 /\n"
+            "/\n"
+            "PROPS\n"
+            "SOLUTION\n";
+
+        ParseContext parseContext;
+        const auto deck = Parser().parseString( data, parseContext );
+        return EclipseState( deck, parseContext );
+    }
+
+    /* The multiplier of the connection from active cell a to active cell n. */
+    double connectionMultiplier( const ConnectionGraph& graph, size_t a, size_t n, bool nnc ) {
+        for( size_t c = graph.offsets()[ a ]; c < graph.offsets()[ a + 1 ]; c++ )
+            if( size_t( graph.neighbours()[ c ] ) == n && ( graph.faces()[ c ] == 0 ) == nnc )
+                return graph.multipliers()[ c ];
+
+        BOOST_FAIL( "Connection not found" );
+        return 0;
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(MULTREGTAppliesToNNC) {
+    const auto all = makeNNCState( "ALL" ).getConnectionGraph();
+    BOOST_CHECK_CLOSE( connectionMultiplier( all, 0, 2, true ), 0.5, 1e-12 );
+    BOOST_CHECK_CLOSE( connectionMultiplier( all, 2, 0, true ), 0.5, 1e-12 );
+    BOOST_CHECK_CLOSE( connectionMultiplier( all, 1, 2, false ), 0.5, 1e-12 );
+    BOOST_CHECK_CLOSE( connectionMultiplier( all, 0, 1, false ), 1.0, 1e-12 );
+
+    const auto nnc = makeNNCState( "NNC" ).getConnectionGraph();
+    BOOST_CHECK_CLOSE( connectionMultiplier( nnc, 0, 2, true ), 0.5, 1e-12 );
+    BOOST_CHECK_CLOSE( connectionMultiplier( nnc, 1, 2, false ), 1.0, 1e-12 );
+
+    const auto nonnc = makeNNCState( "NONNC" ).getConnectionGraph();
+    BOOST_CHECK_CLOSE( connectionMultiplier( nonnc, 0, 2, true ), 1.0, 1e-12 );
+    BOOST_CHECK_CLOSE( connectionMultiplier( nonnc, 1, 2, false ), 0.5, 1e-12 );
+}
@@ -0,0 +1,238 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#define BOOST_TEST_MODULE EclipseArrayFileTests
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Utility/EclipseArrayFile.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    /* Writes big endian Fortran records as found in unformatted Eclipse files. */
+    class UnformattedWriter {
+    public:
+        explicit UnformattedWriter( const std::string& filename ) :
+            stream( filename, std::ios::binary )
+        {}
+
+        void intArray( const std::string& name, const std::vector< int32_t >& values ) {
+            this->header( name, values.size(), "INTE" );
+            this->record( values.size() * 4, [&] {
+                for( const auto v : values ) this->put32( uint32_t( v ) );
+            } );
+        }
+
+        void doubleArray( const std::string& name, const std::vector< double >& values ) {
+            this->header( name, values.size(), "DOUB" );
+            this->record( values.size() * 8, [&] {
+                for( const auto v : values ) {
+                    uint64_t bits;
+                    std::memcpy( &bits, &v, sizeof bits );
+                    this->put32( uint32_t( bits >> 32 ) );
+                    this->put32( uint32_t( bits ) );
+                }
+            } );
+        }
+
+        void floatArray( const std::string& name, const std::vector< float >& values ) {
+            this->header( name, values.size(), "REAL" );
+            this->record( values.size() * 4, [&] {
+                for( const auto v : values ) {
+                    uint32_t bits;
+                    std::memcpy( &bits, &v, sizeof bits );
+                    this->put32( bits );
+                }
+            } );
+        }
+
+        void header( std::string name, size_t count, const std::string& type ) {
+            name.resize( 8, ' ' );
+            this->record( 16, [&] {
+                this->stream.write( name.data(), 8 );
+                this->put32( uint32_t( count ) );
+                this->stream.write( type.data(), 4 );
+            } );
+        }
+
+    private:
+        void put32( uint32_t v ) {
+            const char bytes[] = { char( v >> 24 ), char( v >> 16 ), char( v >> 8 ), char( v ) };
+            this->stream.write( bytes, 4 );
+        }
+
+        template< typename F >
+        void record( size_t bytes, F body ) {
+            this->put32( uint32_t( bytes ) );
+            body();
+            this->put32( uint32_t( bytes ) );
+        }
+
+        std::ofstream stream;
+    };
+
+    const std::string grid_deck =
+        "RUNSPEC\n"
+        "DIMENS\n 2 2 1 /\n"
+        "GRID\n"
+        "IMPORT\n";
+
+}
+
+BOOST_AUTO_TEST_CASE(ReadUnformatted) {
+    using namespace boost::filesystem;
+    const path root = temp_directory_path() / unique_path( "%%%%-%%%%" );
+    create_directories( root );
+    const auto filename = ( root / "ARRAYS.GRDECL" ).string();
+
+    {
+        UnformattedWriter writer( filename );
+        writer.intArray( "SATNUM", { 1, 2, 3, 4 } );
+        writer.doubleArray( "PORO", { 0.1, 0.2, 0.3, 0.4 } );
+        writer.floatArray( "NTG", { 0.5, 1.0 } );
+    }
+
+    const auto arrays = readEclipseArrays( filename, false );
+    BOOST_REQUIRE_EQUAL( 3U, arrays.size() );
+
+    BOOST_CHECK_EQUAL( "SATNUM", arrays[ 0 ].name );
+    BOOST_CHECK( type_tag::integer == arrays[ 0 ].type );
+    BOOST_CHECK( arrays[ 0 ].ival == std::vector< int >( { 1, 2, 3, 4 } ) );
+
+    BOOST_CHECK_EQUAL( "PORO", arrays[ 1 ].name );
+    BOOST_CHECK( arrays[ 1 ].dval == std::vector< double >( { 0.1, 0.2, 0.3, 0.4 } ) );
+
+    BOOST_CHECK_EQUAL( "NTG", arrays[ 2 ].name );
+    BOOST_CHECK_EQUAL( 2U, arrays[ 2 ].size() );
+    BOOST_CHECK_EQUAL( 0.5, arrays[ 2 ].dval[ 0 ] );
+
+    BOOST_CHECK_THROW( readEclipseArrays( ( root / "MISSING" ).string(), false ), std::invalid_argument );
+
+    {
+        std::ofstream truncated( filename, std::ios::binary | std::ios::trunc );
+        truncated.write( "\0\0\0\x10SATNUM", 10 );
+    }
+    BOOST_CHECK_THROW( readEclipseArrays( filename, false ), std::runtime_error );
+
+    /* Negative counts, and counts larger than the rest of the file, are rejected before reserving. */
+    const auto invalid_header = []( const std::runtime_error& e ) {
+        return std::string( e.what() ).find( "Invalid array header" ) != std::string::npos;
+    };
+    {
+        UnformattedWriter writer( filename );
+        writer.header( "PORO", size_t( uint32_t( -1 ) ), "DOUB" );
+    }
+    BOOST_CHECK_EXCEPTION( readEclipseArrays( filename, false ), std::runtime_error, invalid_header );
+
+    {
+        UnformattedWriter writer( filename );
+        writer.header( "PORO", 1000000, "DOUB" );
+        writer.doubleArray( "NTG", { 0.5, 1.0 } );
+    }
+    BOOST_CHECK_EXCEPTION( readEclipseArrays( filename, false ), std::runtime_error, invalid_header );
+
+    remove_all( root );
+}
+
+BOOST_AUTO_TEST_CASE(ReadFormatted) {
+    using namespace boost::filesystem;
+    const path root = temp_directory_path() / unique_path( "%%%%-%%%%" );
+    create_directories( root );
+    const auto filename = ( root / "ARRAYS.FGRDECL" ).string();
+
+    {
+        std::ofstream stream( filename );
+        stream << " 'PORO    '           3 'DOUB'\n"
+               << "   0.10000000000000D+00   0.20000000000000D+00   0.30000000000000D+00\n"
+               << " 'ACTNUM  '           3 'INTE'\n"
+               << "           1           0           1\n";
+    }
+
+    const auto arrays = readEclipseArrays( filename, true );
+    BOOST_REQUIRE_EQUAL( 2U, arrays.size() );
+    BOOST_CHECK_EQUAL( "PORO", arrays[ 0 ].name );
+    BOOST_CHECK_CLOSE( 0.2, arrays[ 0 ].dval[ 1 ], 1e-12 );
+    BOOST_CHECK_EQUAL( "ACTNUM", arrays[ 1 ].name );
+    BOOST_CHECK( arrays[ 1 ].ival == std::vector< int >( { 1, 0, 1 } ) );
+
+    const auto invalid_header = []( const std::runtime_error& e ) {
+        return std::string( e.what() ).find( "Invalid array header" ) != std::string::npos;
+    };
+    for( const auto* count : { "-1", "1000000", "3x" } ) {
+        std::ofstream stream( filename, std::ios::trunc );
+        stream << " 'PORO    '  " << count << " 'DOUB'\n"
+               << "   0.10000000000000D+00   0.20000000000000D+00   0.30000000000000D+00\n";
+        stream.close();
+        BOOST_CHECK_EXCEPTION( readEclipseArrays( filename, true ), std::runtime_error, invalid_header );
+    }
+
+    remove_all( root );
+}
+
+BOOST_AUTO_TEST_CASE(ImportKeyword) {
+    using namespace boost::filesystem;
+    const path root = temp_directory_path() / unique_path( "%%%%-%%%%" );
+    create_directories( root );
+
+    {
+        UnformattedWriter writer( ( root / "PROPS.BIN" ).string() );
+        writer.doubleArray( "PERMX", { 100, 200, 300, 400 } );
+        writer.doubleArray( "FIPNUM", { 1, 2, 2, 1 } );
+        writer.intArray( "NOTAKW", { 1 } );
+    }
+    {
+        std::ofstream stream( ( root / "CASE.DATA" ).string() );
+        stream << grid_deck << " 'PROPS.BIN' /\n";
+    }
+
+    const auto deck = Parser().parseFile( ( root / "CASE.DATA" ).string(), ParseContext() );
+    BOOST_CHECK( !deck.hasKeyword( "IMPORT" ) );
+    BOOST_CHECK( !deck.hasKeyword( "NOTAKW" ) );
+
+    const auto& permx = deck.getKeyword( "PERMX" ).getSIDoubleData();
+    BOOST_REQUIRE_EQUAL( 4U, permx.size() );
+    BOOST_CHECK_CLOSE( 200 * 9.869233e-16, permx[ 1 ], 1e-4 );
+
+    BOOST_CHECK( deck.getKeyword( "FIPNUM" ).getIntData() == std::vector< int >( { 1, 2, 2, 1 } ) );
+    BOOST_CHECK_EQUAL( 1U, deck.getMessageContainer().size() );
+
+    remove_all( root );
+}
+
+BOOST_AUTO_TEST_CASE(ImportMissingFile) {
+    ParseContext parseContext;
+    parseContext.update( ParseContext::PARSE_MISSING_INCLUDE, InputError::THROW_EXCEPTION );
+    BOOST_CHECK_THROW( Parser().parseString( grid_deck + " 'NO_SUCH_FILE' /\n", parseContext ), std::invalid_argument );
+
+    parseContext.update( ParseContext::PARSE_MISSING_INCLUDE, InputError::IGNORE );
+    const auto deck = Parser().parseString( grid_deck + " 'NO_SUCH_FILE' /\n", parseContext );
+    BOOST_CHECK( !deck.hasKeyword( "PORO" ) );
+}
@@ -26,6 +26,9 @@
 #include <boost/test/unit_test.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/ecl_util.h>
+
 #include <opm/parser/eclipse/Deck/Deck.hpp>
 #include <opm/parser/eclipse/Deck/DeckKeyword.hpp>
 #include <opm/parser/eclipse/Deck/Section.hpp>
@@ -1087,6 +1090,44 @@ BOOST_AUTO_TEST_CASE(ZcornMapper) {
 }
 
 
+BOOST_AUTO_TEST_CASE(ZcornOverlaps) {
+    const Opm::EclipseGrid ref( 4, 3, 6, 10, 20, 5 );
+    const auto zmp = ref.zcornMapper();
+    std::vector<double> coord;
+    std::vector<double> zcorn;
+    ref.exportCOORD( coord );
+    ref.exportZCORN( zcorn );
+
+    /* Overlaps in several columns, one of them spanning two layers. */
+    zcorn[ zmp.index(0,0,0,4) ] = zcorn[ zmp.index(0,0,2,0) ] + 0.1;
+    zcorn[ zmp.index(3,2,4,1) ] = zcorn[ zmp.index(3,2,4,0) ] - 1;
+    zcorn[ zmp.index(1,2,5,7) ] = zcorn[ zmp.index(1,2,5,3) ] - 1;
+
+    const auto original = zcorn;
+    const size_t overlaps = zmp.countOverlaps( zcorn.data() );
+    BOOST_CHECK_EQUAL( overlaps, 5U );
+    BOOST_CHECK( zcorn == original );
+    BOOST_CHECK( !zmp.validZCORN( zcorn.data() ));
+
+    std::array<int, 3> dims = {{ 4, 3, 6 }};
+    const Opm::EclipseGrid grid( dims, std::move( coord ), std::vector<double>( original ));
+    BOOST_CHECK_EQUAL( grid.countZCORNOverlaps(), overlaps );
+
+    /* exportZCORN() reuses the buffer, and agrees with the mapper. */
+    std::vector<double> exported( zcorn.size() );
+    const double* buffer = exported.data();
+    BOOST_CHECK_EQUAL( grid.exportZCORN( exported ), overlaps );
+    BOOST_CHECK( exported.data() == buffer );
+    BOOST_CHECK_EQUAL( zmp.fixupZCORN( zcorn.data() ), overlaps );
+    BOOST_CHECK( exported == zcorn );
+    BOOST_CHECK( zmp.validZCORN( exported ));
+    BOOST_CHECK_EQUAL( zmp.countOverlaps( exported.data() ), 0U );
+
+    BOOST_CHECK_EQUAL( exported[ zmp.index(0,0,1,0) ], original[ zmp.index(0,0,0,4) ] );
+    BOOST_CHECK_EQUAL( exported[ zmp.index(0,0,2,4) ], original[ zmp.index(0,0,2,4) ] );
+}
+
+
 
 BOOST_AUTO_TEST_CASE(MoveTest) {
     int nx = 3;
@@ -1395,3 +1436,275 @@ BOOST_AUTO_TEST_CASE(CoordMapper) {
 
     BOOST_CHECK_EQUAL( cmp.index(10,7,2,1) + 1 , cmp.size( ));
 }
+
+
+BOOST_AUTO_TEST_CASE(BulkGeometry) {
+    Opm::EclipseGrid grid( 3, 4, 2, 10, 20, 5 );
+    std::vector<int> actnum( grid.getCartesianSize(), 1 );
+    actnum[1] = 0;
+    actnum[7] = 0;
+    actnum[20] = 0;
+    grid.resetACTNUM( actnum.data() );
+
+    const auto& volumes = grid.getCellVolumes();
+    const auto& depths = grid.getCellDepths();
+    const auto& thicknesses = grid.getCellThicknesses();
+    const auto& centers = grid.getCellCenters();
+    const auto& dims = grid.getCellDimensions();
+
+    BOOST_CHECK_EQUAL( volumes.size(), grid.getCartesianSize() );
+    BOOST_CHECK_EQUAL( centers.size(), grid.getCartesianSize() );
+    for (size_t g = 0; g < grid.getCartesianSize(); g++) {
+        BOOST_CHECK_EQUAL( volumes[g], grid.getCellVolume( g ));
+        BOOST_CHECK_EQUAL( depths[g], grid.getCellDepth( g ));
+        BOOST_CHECK_EQUAL( thicknesses[g], grid.getCellThicknes( g ));
+        BOOST_CHECK( centers[g] == grid.getCellCenter( g ));
+        BOOST_CHECK( dims[g] == grid.getCellDims( g ));
+    }
+
+    /* The vectors are memoized. */
+    BOOST_CHECK_EQUAL( &volumes, &grid.getCellVolumes() );
+    BOOST_CHECK_EQUAL( &centers, &grid.getCellCenters() );
+
+    const auto& active_depths = grid.getCellDepths( true );
+    const auto& active_centers = grid.getCellCenters( true );
+    BOOST_CHECK_EQUAL( active_depths.size(), grid.getNumActive() );
+    BOOST_CHECK_EQUAL( grid.getCellVolumes( true ).size(), grid.getNumActive() );
+    for (size_t a = 0; a < grid.getNumActive(); a++) {
+        const size_t g = grid.getGlobalIndex( a );
+        BOOST_CHECK_EQUAL( active_depths[a], depths[g] );
+        BOOST_CHECK( active_centers[a] == centers[g] );
+        BOOST_CHECK( grid.getCellDimensions( true )[a] == dims[g] );
+        BOOST_CHECK_EQUAL( grid.getCellThicknesses( true )[a], thicknesses[g] );
+    }
+
+    /* The active vectors follow a change of ACTNUM. */
+    actnum.assign( grid.getCartesianSize(), 1 );
+    actnum[0] = 0;
+    grid.resetACTNUM( actnum.data() );
+    BOOST_CHECK_EQUAL( grid.getCellDepths( true ).size(), grid.getCartesianSize() - 1 );
+    BOOST_CHECK_EQUAL( grid.getCellDepths( true )[0], depths[1] );
+}
+
+
+BOOST_AUTO_TEST_CASE(AdoptCornerPointBuffers) {
+    const Opm::EclipseGrid ref( 3, 4, 2, 10, 20, 5 );
+    std::vector<double> coord;
+    std::vector<double> zcorn;
+    ref.exportCOORD( coord );
+    ref.exportZCORN( zcorn );
+
+    std::array<int, 3> dims = {{ 3, 4, 2 }};
+    std::vector<int> actnum( ref.getCartesianSize(), 1 );
+    actnum[5] = 0;
+
+    Opm::EclipseGrid grid( dims, std::move( coord ), std::move( zcorn ), actnum.data() );
+    BOOST_CHECK_EQUAL( grid.getNumActive(), ref.getCartesianSize() - 1 );
+    BOOST_CHECK( !grid.cellActive( 5 ));
+
+    /* The grid has taken the buffers. */
+    BOOST_CHECK( coord.empty() );
+    BOOST_CHECK( zcorn.empty() );
+
+    for (size_t g = 0; g < ref.getCartesianSize(); g++) {
+        BOOST_CHECK_CLOSE( grid.getCellVolume( g ), ref.getCellVolume( g ), 1e-8 );
+        BOOST_CHECK_CLOSE( grid.getCellDepth( g ), ref.getCellDepth( g ), 1e-8 );
+    }
+
+    for (int c = 0; c < 8; c++) {
+        const auto p = grid.getCornerPos( 2, 3, 1, c );
+        const auto q = ref.getCornerPos( 2, 3, 1, c );
+        for (int d = 0; d < 3; d++)
+            BOOST_CHECK_CLOSE( p[d], q[d], 1e-8 );
+    }
+
+    /* The ERT grid is created on demand, with the active cells of the grid. */
+    Opm::EclipseGrid ref_actnum( ref, actnum );
+    BOOST_CHECK( grid.c_ptr() != nullptr );
+    BOOST_CHECK( grid.equal( ref_actnum ));
+
+    std::vector<double> bad_coord( 10 );
+    std::vector<double> bad_zcorn( 8 * 24 );
+    BOOST_CHECK_THROW( Opm::EclipseGrid( dims, std::move( bad_coord ), std::move( bad_zcorn )), std::invalid_argument );
+}
+
+
+BOOST_AUTO_TEST_CASE(CopyOnWrite) {
+    const Opm::EclipseGrid grid( 3, 4, 2, 10, 20, 5 );
+    const size_t size = grid.getCartesianSize();
+    const auto& geometry = grid.geometry();
+
+    /* Copies share the ERT grid and the geometry. */
+    Opm::EclipseGrid copy( grid );
+    BOOST_CHECK( copy.c_ptr() == grid.c_ptr() );
+    BOOST_CHECK( &copy.geometry() == &geometry );
+
+    /* A change of ACTNUM in the copy does not touch the original. */
+    std::vector<int> actnum( size, 1 );
+    actnum[3] = 0;
+    copy.resetACTNUM( actnum.data() );
+    BOOST_CHECK_EQUAL( copy.getNumActive(), size - 1 );
+    BOOST_CHECK_EQUAL( grid.getNumActive(), size );
+    BOOST_CHECK( copy.c_ptr() != grid.c_ptr() );
+    BOOST_CHECK_EQUAL( ecl_grid_get_nactive( copy.c_ptr() ), int( size - 1 ));
+    BOOST_CHECK_EQUAL( ecl_grid_get_nactive( grid.c_ptr() ), int( size ));
+    BOOST_CHECK( &copy.geometry() == &geometry );
+
+    /* A grid with a new ACTNUM shares the geometry of the source grid. */
+    actnum[3] = 1;
+    actnum[7] = 0;
+    const Opm::EclipseGrid derived( grid, actnum );
+    BOOST_CHECK( &derived.geometry() == &geometry );
+    BOOST_CHECK( !derived.cellActive( 7 ));
+    BOOST_CHECK( grid.cellActive( 7 ));
+    BOOST_CHECK_EQUAL( derived.getCellVolumes( true ).size(), size - 1 );
+    BOOST_CHECK_EQUAL( grid.getCellVolumes( true ).size(), size );
+    BOOST_CHECK_EQUAL( ecl_grid_get_nactive( derived.c_ptr() ), int( size - 1 ));
+    BOOST_CHECK_EQUAL( ecl_grid_get_nactive( grid.c_ptr() ), int( size ));
+
+    /* The same for a grid with adopted buffers, where there is no ERT grid yet. */
+    std::vector<double> coord;
+    std::vector<double> zcorn;
+    grid.exportCOORD( coord );
+    grid.exportZCORN( zcorn );
+    std::array<int, 3> dims = {{ 3, 4, 2 }};
+    const Opm::EclipseGrid adopted( dims, std::move( coord ), std::move( zcorn ));
+    const auto& adopted_geometry = adopted.geometry();
+    const Opm::EclipseGrid adopted_derived( adopted, actnum );
+    BOOST_CHECK( &adopted_derived.geometry() == &adopted_geometry );
+    BOOST_CHECK_EQUAL( ecl_grid_get_nactive( adopted_derived.c_ptr() ), int( size - 1 ));
+    BOOST_CHECK_EQUAL( ecl_grid_get_nactive( adopted.c_ptr() ), int( size ));
+    BOOST_CHECK( adopted_derived.equal( derived ));
+}
+
+
+BOOST_AUTO_TEST_CASE(ConsumeDeck) {
+    const Opm::EclipseGrid ref( 3, 4, 2, 10, 20, 5 );
+    std::vector<double> coord;
+    std::vector<double> zcorn;
+    ref.exportCOORD( coord );
+    ref.exportZCORN( zcorn );
+
+    std::string deckData = "RUNSPEC\nDIMENS\n 3 4 2 /\nGRID\nCOORD\n";
+    for (double v : coord)
+        deckData += " " + std::to_string( v );
+    deckData += " /\nZCORN\n";
+    for (double v : zcorn)
+        deckData += " " + std::to_string( v );
+    deckData += " /\n";
+
+    Opm::Parser parser;
+    auto deck = parser.parseString( deckData, Opm::ParseContext() );
+    const Opm::EclipseGrid copied( deck );
+    BOOST_CHECK_EQUAL( deck.getKeyword( "ZCORN" ).getDataSize(), zcorn.size() );
+
+    const Opm::EclipseGrid consumed( deck, nullptr, true );
+    BOOST_CHECK_EQUAL( deck.getKeyword( "ZCORN" ).getDataSize(), 0U );
+    BOOST_CHECK_EQUAL( deck.getKeyword( "COORD" ).getDataSize(), 0U );
+    BOOST_CHECK( deck.getKeyword( "ZCORN" ).getSIDoubleData().empty() );
+
+    std::vector<double> exported;
+    consumed.exportZCORN( exported );
+    BOOST_CHECK( exported == zcorn );
+    for (size_t g = 0; g < ref.getCartesianSize(); g++)
+        BOOST_CHECK_CLOSE( consumed.getCellVolume( g ), copied.getCellVolume( g ), 1e-6 );
+
+    BOOST_CHECK( consumed.equal( copied ));
+}
+
+
+BOOST_AUTO_TEST_CASE(GDFILE) {
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 10 10 10 /\n"
+        "GRID\n"
+        "GDFILE\n"
+        " 'grid/CASE.EGRID' /\n";
+
+    Opm::Parser parser;
+    auto deck = parser.parseString( deckData, Opm::ParseContext() );
+    const auto& record = deck.getKeyword( "GDFILE" ).getRecord( 0 );
+    BOOST_CHECK_EQUAL( record.getItem( "filename" ).get< std::string >( 0 ), "grid/CASE.EGRID" );
+    BOOST_CHECK_EQUAL( record.getItem( "formatted" ).get< std::string >( 0 ), "U" );
+
+    /* A relative path is relative to the directory of the data file. */
+    deck.setDataFile( "/does/not/exist/CASE.DATA" );
+    BOOST_CHECK_EXCEPTION( Opm::EclipseGrid{ deck }, std::invalid_argument,
+                           []( const std::invalid_argument& e ) {
+                               return std::string( e.what() ).find( "/does/not/exist/grid/CASE.EGRID" ) != std::string::npos;
+                           });
+}
+
+
+BOOST_AUTO_TEST_CASE(GDFILE_EGRID) {
+    const char* sourceData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 2 2 2 /\n"
+        "GRID\n"
+        "MAPAXES\n"
+        " 0.0 100.0 0.0 0.0 100.0 0.0 /\n"
+        "COORD\n"
+        " 0 0 0  0 0 10   5 0 0  5 0 10   10 0 0  10 0 10\n"
+        " 0 5 0  0 5 10   5 5 0  5 5 10   10 5 0  10 5 10\n"
+        " 0 10 0 0 10 10  5 10 0 5 10 10  10 10 0 10 10 10 /\n"
+        "ZCORN\n"
+        " 16*0 32*5 16*10 /\n"
+        "ACTNUM\n"
+        " 1 0 1 1 1 1 0 1 /\n";
+
+    Opm::Parser parser;
+    const Opm::EclipseGrid source( parser.parseString( sourceData, Opm::ParseContext() ));
+
+    const auto root = boost::filesystem::temp_directory_path()
+                    / boost::filesystem::unique_path( "GDFILE-%%%%-%%%%" );
+    boost::filesystem::create_directories( root / "grid" );
+    const auto egrid = ( root / "grid" / "CASE.EGRID" ).string();
+    ecl_grid_fwrite_EGRID2( const_cast< ecl_grid_type* >( source.c_ptr() ), egrid.c_str(), ECL_METRIC_UNITS );
+
+    const auto gdfileDeck = []( const std::string& dimens ) {
+        const std::string deckData =
+            "RUNSPEC\n"
+            "DIMENS\n"
+            " " + dimens + " /\n"
+            "GRID\n"
+            "GDFILE\n"
+            " 'grid/CASE.EGRID' /\n";
+        return Opm::Parser().parseString( deckData, Opm::ParseContext() );
+    };
+
+    {
+        auto deck = gdfileDeck( "2 2 2" );
+        deck.setDataFile( ( root / "CASE.DATA" ).string() );
+        const Opm::EclipseGrid grid( deck );
+
+        BOOST_CHECK_EQUAL( grid.getNX(), 2U );
+        BOOST_CHECK_EQUAL( grid.getNY(), 2U );
+        BOOST_CHECK_EQUAL( grid.getNZ(), 2U );
+        BOOST_CHECK_EQUAL( grid.getNumActive(), 6U );
+        BOOST_CHECK( !grid.cellActive( 1 ));
+        BOOST_CHECK( !grid.cellActive( 6 ));
+        for (size_t g = 0; g < grid.getCartesianSize(); g++) {
+            BOOST_CHECK_EQUAL( grid.cellActive( g ), source.cellActive( g ));
+            BOOST_CHECK_CLOSE( grid.getCellVolume( g ), source.getCellVolume( g ), 1e-6 );
+        }
+
+        std::vector<double> mapaxes;
+        grid.exportMAPAXES( mapaxes );
+        const std::vector<double> expected = { 0.0, 100.0, 0.0, 0.0, 100.0, 0.0 };
+        BOOST_CHECK_EQUAL_COLLECTIONS( mapaxes.begin(), mapaxes.end(), expected.begin(), expected.end() );
+    }
+
+    /* The dimensions of the file must agree with DIMENS. */
+    {
+        auto deck = gdfileDeck( "2 2 3" );
+        deck.setDataFile( ( root / "CASE.DATA" ).string() );
+        BOOST_CHECK_EXCEPTION( Opm::EclipseGrid{ deck }, std::invalid_argument,
+                               []( const std::invalid_argument& e ) {
+                                   return std::string( e.what() ).find( "has dimensions 2x2x2 - expected 2x2x3" ) != std::string::npos;
+                               });
+    }
+
+    boost::filesystem::remove_all( root );
+}
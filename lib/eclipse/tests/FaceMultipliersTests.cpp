@@ -0,0 +1,97 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <stdexcept>
+#include <vector>
+
+#define BOOST_TEST_MODULE FaceMultipliersTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/EclipseState/Grid/FaceMultipliers.hpp>
+
+using namespace Opm;
+
+BOOST_AUTO_TEST_CASE(Empty) {
+    const FaceMultipliers mult( 100 );
+
+    BOOST_CHECK_EQUAL( 100U, mult.size() );
+    BOOST_CHECK( !mult.isDense() );
+    BOOST_CHECK_EQUAL( 0U, mult.numMultipliers() );
+    BOOST_CHECK_EQUAL( 1.0, mult[ 0 ] );
+    BOOST_CHECK_EQUAL( 1.0, mult[ 99 ] );
+    BOOST_CHECK( std::vector< double >( 100, 1.0 ) == mult.exportDense() );
+}
+
+BOOST_AUTO_TEST_CASE(SparseUpdates) {
+    FaceMultipliers mult( 100 );
+
+    mult.multiplyFaces( { { 50, 0.5 }, { 10, 0.1 }, { 50, 0.25 } } );
+    BOOST_CHECK( !mult.isDense() );
+    BOOST_CHECK_EQUAL( 2U, mult.numMultipliers() );
+    BOOST_CHECK( std::vector< size_t >( { 10, 50 } ) == mult.indices() );
+    BOOST_CHECK_EQUAL( 0.1, mult[ 10 ] );
+    BOOST_CHECK_EQUAL( 0.125, mult[ 50 ] );
+    BOOST_CHECK_EQUAL( 1.0, mult[ 11 ] );
+
+    /* Merged with the existing entries; a product of 1 is removed. */
+    mult.multiplyFaces( { { 50, 8.0 }, { 5, 2.0 }, { 99, 3.0 } } );
+    BOOST_CHECK( std::vector< size_t >( { 5, 10, 99 } ) == mult.indices() );
+    BOOST_CHECK( std::vector< double >( { 2.0, 0.1, 3.0 } ) == mult.values() );
+    BOOST_CHECK_EQUAL( 1.0, mult[ 50 ] );
+
+    BOOST_CHECK_THROW( mult.multiplyFaces( { { 100, 2.0 } } ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(FillRatio) {
+    FaceMultipliers mult( 80 );
+
+    /* 10 of 80 cells is still sparse, 11 is dense. */
+    std::vector< std::pair< size_t, double > > updates;
+    for( size_t g = 0; g < 10; g++ )
+        updates.emplace_back( 2 * g, 0.5 );
+    mult.multiplyFaces( updates );
+    BOOST_CHECK( !mult.isDense() );
+
+    mult.multiplyFaces( { { 1, 0.5 } } );
+    BOOST_CHECK( mult.isDense() );
+    BOOST_CHECK_EQUAL( 80U, mult.data().size() );
+    BOOST_CHECK_EQUAL( 11U, mult.numMultipliers() );
+    BOOST_CHECK_EQUAL( 0.5, mult[ 1 ] );
+    BOOST_CHECK_EQUAL( 1.0, mult[ 3 ] );
+
+    mult.multiplyFaces( { { 1, 2.0 }, { 2, 2.0 } } );
+    BOOST_CHECK( !mult.isDense() );
+    BOOST_CHECK_EQUAL( 9U, mult.numMultipliers() );
+    BOOST_CHECK( mult.data().empty() );
+}
+
+BOOST_AUTO_TEST_CASE(DenseUpdates) {
+    FaceMultipliers mult( 4 );
+
+    mult.multiplyFaces( { { 2, 4.0 } } );
+    mult.multiply( std::vector< double >( { 0.5, 1.0, 0.5, 1.0 } ) );
+    BOOST_CHECK( mult.isDense() );
+    BOOST_CHECK( std::vector< double >( { 0.5, 1.0, 2.0, 1.0 } ) == mult.exportDense() );
+
+    mult.multiply( std::vector< double >( 4, 1.0 ) );
+    BOOST_CHECK( std::vector< double >( { 0.5, 1.0, 2.0, 1.0 } ) == mult.data() );
+
+    BOOST_CHECK_THROW( mult.multiply( std::vector< double >( 3, 1.0 ) ), std::invalid_argument );
+}
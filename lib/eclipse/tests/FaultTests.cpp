@@ -29,6 +29,8 @@
 #include <opm/parser/eclipse/EclipseState/Grid/FaultCollection.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/Fault.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaultFace.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaultIndex.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridDims.hpp>
 #include <opm/parser/eclipse/EclipseState/Grid/FaceDir.hpp>
 
 
@@ -138,3 +140,42 @@ BOOST_AUTO_TEST_CASE(AddFaultsToCollection) {
     BOOST_CHECK(faults.hasFault("FAULTX"));
     BOOST_CHECK_EQUAL( faultx.getName() , faults.getFault(1).getName());
 }
+
+
+
+BOOST_AUTO_TEST_CASE(FaultIndex) {
+    Opm::FaultCollection faults;
+    faults.addFault("F1");
+    faults.addFault("F2");
+    faults.getFault("F1").addFace( Opm::FaultFace( 4,3,2, 1,1, 0,2, 0,1, Opm::FaceDir::XPlus ) );
+    faults.getFault("F2").addFace( Opm::FaultFace( 4,3,2, 0,3, 1,1, 1,1, Opm::FaceDir::YMinus ) );
+    faults.getFault("F2").addFace( Opm::FaultFace( 4,3,2, 1,1, 1,1, 1,1, Opm::FaceDir::XPlus ) );
+
+    const Opm::GridDims dims( 4,3,2 );
+    const Opm::FaultIndex index( dims, faults );
+    BOOST_CHECK_EQUAL( index.size() , 6U + 4U + 1U );
+
+    for (size_t i = 1; i < index.size(); i++) {
+        const auto& prev = index.faces()[i - 1];
+        const auto& face = index.faces()[i];
+        BOOST_CHECK( prev.globalIndex < face.globalIndex ||
+                     (prev.globalIndex == face.globalIndex && prev.faceDir <= face.faceDir) );
+    }
+
+    /* Listed by both faults; the first is returned. */
+    BOOST_CHECK_EQUAL( index.getFault( dims.getGlobalIndex(1,1,1) , Opm::FaceDir::XPlus ) , 0 );
+    BOOST_CHECK_EQUAL( index.getFault( dims.getGlobalIndex(1,2,0) , Opm::FaceDir::XPlus ) , 0 );
+    BOOST_CHECK_EQUAL( index.getFault( dims.getGlobalIndex(3,1,1) , Opm::FaceDir::YMinus ) , 1 );
+
+    /* The same faces seen from the neighbouring cells. */
+    BOOST_CHECK_EQUAL( index.getFault( dims.getGlobalIndex(2,0,0) , Opm::FaceDir::XMinus ) , 0 );
+    BOOST_CHECK_EQUAL( index.getFault( dims.getGlobalIndex(3,0,1) , Opm::FaceDir::YPlus ) , 1 );
+
+    BOOST_CHECK( !index.hasFault( dims.getGlobalIndex(1,1,1) , Opm::FaceDir::XMinus ) );
+    BOOST_CHECK( !index.hasFault( dims.getGlobalIndex(3,1,0) , Opm::FaceDir::YMinus ) );
+    BOOST_CHECK( !index.hasFault( dims.getGlobalIndex(3,2,1) , Opm::FaceDir::XPlus ) );
+    BOOST_CHECK_THROW( index.getFault( 24 , Opm::FaceDir::XPlus ) , std::invalid_argument );
+
+    const Opm::FaultIndex empty;
+    BOOST_CHECK_EQUAL( empty.size() , 0U );
+}
@@ -0,0 +1,243 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define BOOST_TEST_MODULE GridGeometryTests
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/GridGeometry.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+#include <ert/ecl/ecl_grid.h>
+
+using namespace Opm;
+
+namespace {
+
+    /*
+      A corner point grid with sloping pillars, x = i*dx + shear*z. The
+      layer surfaces are planes when perturbation is zero, so all cells
+      are parallelepipeds; otherwise the ZCORN values are displaced by
+      up to +/- perturbation in a deterministic pattern.
+    */
+    EclipseGrid cornerPointGrid( int nx, int ny, int nz, double shear, double perturbation ) {
+        std::array< int, 3 > dims = {{ nx, ny, nz }};
+        CoordMapper cm( nx, ny );
+        ZcornMapper zm( nx, ny, nz );
+        std::vector< double > coord( cm.size() );
+        std::vector< double > zcorn( zm.size() );
+
+        for( int j = 0; j <= ny; j++ ) {
+            for( int i = 0; i <= nx; i++ ) {
+                for( size_t layer = 0; layer < 2; layer++ ) {
+                    const double z = 900 + 500 * layer;
+                    coord[ cm.index( i, j, 0, layer ) ] = 100 * i + shear * z;
+                    coord[ cm.index( i, j, 1, layer ) ] = 50 * j;
+                    coord[ cm.index( i, j, 2, layer ) ] = z;
+                }
+            }
+        }
+
+        for( int k = 0; k < nz; k++ ) {
+            for( int j = 0; j < ny; j++ ) {
+                for( int i = 0; i < nx; i++ ) {
+                    for( int c = 0; c < 8; c++ ) {
+                        const int pi = i + ( c & 1 );
+                        const int pj = j + ( ( c >> 1 ) & 1 );
+                        const int pk = k + ( c >> 2 );
+                        const double noise = perturbation * std::sin( 1.3 * pi + 2.1 * pj + 0.7 * pk );
+                        zcorn[ zm.index( i, j, k, c ) ] = 1000 + 10 * pk + 2.0 * pi + 1.5 * pj + noise;
+                    }
+                }
+            }
+        }
+
+        return EclipseGrid( dims, coord, zcorn );
+    }
+
+    void checkAgainstERT( const EclipseGrid& grid, double volume_tolerance ) {
+        const auto* ecl_grid = grid.c_ptr();
+        const auto& geometry = grid.geometry();
+
+        for( size_t g = 0; g < grid.getCartesianSize(); g++ ) {
+            const int gi = static_cast< int >( g );
+            double x, y, z;
+            ecl_grid_get_xyz1( ecl_grid, gi, &x, &y, &z );
+
+            BOOST_CHECK_CLOSE( geometry.volume()[ g ], ecl_grid_get_cell_volume1( ecl_grid, gi ), volume_tolerance );
+            BOOST_CHECK_CLOSE( geometry.centerX()[ g ], x, 1e-8 );
+            BOOST_CHECK_CLOSE( geometry.centerY()[ g ], y, 1e-8 );
+            BOOST_CHECK_CLOSE( geometry.depth()[ g ], z, 1e-8 );
+            BOOST_CHECK_CLOSE( geometry.depth()[ g ], ecl_grid_get_cdepth1( ecl_grid, gi ), 1e-8 );
+            BOOST_CHECK_CLOSE( geometry.thickness()[ g ], ecl_grid_get_cell_thickness1( ecl_grid, gi ), 1e-8 );
+        }
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(RegularGrid) {
+    const EclipseGrid grid( 4, 3, 2, 10, 20, 5 );
+    const auto& geometry = grid.geometry();
+
+    BOOST_CHECK_EQUAL( geometry.volume().size(), 24U );
+    for( size_t g = 0; g < grid.getCartesianSize(); g++ ) {
+        const auto ijk = grid.getIJK( g );
+
+        BOOST_CHECK_CLOSE( geometry.volume()[ g ], 1000, 1e-10 );
+        BOOST_CHECK_CLOSE( geometry.centerX()[ g ], 5 + 10 * ijk[ 0 ], 1e-10 );
+        BOOST_CHECK_CLOSE( geometry.centerY()[ g ], 10 + 20 * ijk[ 1 ], 1e-10 );
+        BOOST_CHECK_CLOSE( geometry.depth()[ g ], 2.5 + 5 * ijk[ 2 ], 1e-10 );
+        BOOST_CHECK_CLOSE( geometry.thickness()[ g ], 5, 1e-10 );
+        BOOST_CHECK_CLOSE( geometry.dx()[ g ], 10, 1e-10 );
+        BOOST_CHECK_CLOSE( geometry.dy()[ g ], 20, 1e-10 );
+
+        BOOST_CHECK_EQUAL( grid.getCellVolume( g ), geometry.volume()[ g ] );
+        BOOST_CHECK_EQUAL( grid.getCellDepth( g ), geometry.depth()[ g ] );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ParallelepipedVolume) {
+    /* A unit cube sheared in x and y along z, and stretched along z. */
+    std::array< std::array< double, 3 >, 8 > corners;
+    for( int c = 0; c < 8; c++ ) {
+        const double s = c & 1;
+        const double t = ( c >> 1 ) & 1;
+        const double u = c >> 2;
+        corners[ c ] = {{ s + 0.5 * u, t + 0.25 * u, 3 * u }};
+    }
+
+    BOOST_CHECK_CLOSE( GridGeometry::cellVolume( corners ), 3.0, 1e-10 );
+}
+
+BOOST_AUTO_TEST_CASE(CollapsedCellHasZeroVolume) {
+    std::array< std::array< double, 3 >, 8 > corners;
+    for( int c = 0; c < 8; c++ )
+        corners[ c ] = {{ double( c & 1 ), double( ( c >> 1 ) & 1 ), 7.0 }};
+
+    BOOST_CHECK_EQUAL( GridGeometry::cellVolume( corners ), 0.0 );
+}
+
+BOOST_AUTO_TEST_CASE(InvalidInputSize) {
+    const GridDims dims( 2, 2, 2 );
+    const std::vector< double > coord( 6 * 3 * 3 );
+    const std::vector< double > zcorn( 8 * 8 );
+
+    BOOST_CHECK_THROW( GridGeometry( dims, std::vector< double >( 10 ), zcorn ), std::invalid_argument );
+    BOOST_CHECK_THROW( GridGeometry( dims, coord, std::vector< double >( 10 ) ), std::invalid_argument );
+    BOOST_CHECK_NO_THROW( GridGeometry( dims, coord, zcorn ) );
+}
+
+/*
+  For cells with planar faces all volume computations agree, and the
+  native geometry must reproduce the ERT values.
+*/
+BOOST_AUTO_TEST_CASE(AgreesWithERTPlanarCells) {
+    checkAgainstERT( cornerPointGrid( 5, 4, 3, 0.0, 0.0 ), 1e-8 );
+    checkAgainstERT( cornerPointGrid( 5, 4, 3, 0.2, 0.0 ), 1e-8 );
+}
+
+/*
+  For warped cells the ERT volume is an approximation; the native volume
+  is exact for the trilinear cell. With the corners displaced by up to 5%
+  of the cell thickness the two agree to within 1%.
+*/
+BOOST_AUTO_TEST_CASE(AgreesWithERTWarpedCells) {
+    checkAgainstERT( cornerPointGrid( 5, 4, 3, 0.1, 0.5 ), 1.0 );
+}
+
+BOOST_AUTO_TEST_CASE(CellDimsAgreeWithERT) {
+    const auto grid = cornerPointGrid( 5, 4, 3, 0.0, 0.0 );
+    const auto& geometry = grid.geometry();
+
+    for( size_t g = 0; g < grid.getCartesianSize(); g++ ) {
+        const int gi = static_cast< int >( g );
+        BOOST_CHECK_CLOSE( geometry.dx()[ g ], ecl_grid_get_cell_dx1( grid.c_ptr(), gi ), 1e-8 );
+        BOOST_CHECK_CLOSE( geometry.dy()[ g ], ecl_grid_get_cell_dy1( grid.c_ptr(), gi ), 1e-8 );
+
+        const auto dims = grid.getCellDims( g );
+        BOOST_CHECK_EQUAL( dims[ 0 ], geometry.dx()[ g ] );
+        BOOST_CHECK_EQUAL( dims[ 1 ], geometry.dy()[ g ] );
+        BOOST_CHECK_EQUAL( dims[ 2 ], geometry.thickness()[ g ] );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(GeometryIsCached) {
+    const auto grid = cornerPointGrid( 3, 3, 3, 0.1, 0.5 );
+    const auto* geometry = &grid.geometry();
+
+    BOOST_CHECK_EQUAL( geometry, &grid.geometry() );
+
+    const auto copy = grid;
+    BOOST_CHECK_EQUAL( geometry, &copy.geometry() );
+
+    std::vector< double > zcorn;
+    grid.exportZCORN( zcorn );
+    for( auto& z : zcorn ) z += 100;
+
+    const EclipseGrid shifted( grid, zcorn, {} );
+    BOOST_CHECK( geometry != &shifted.geometry() );
+    BOOST_CHECK_CLOSE( shifted.getCellDepth( 0 ), grid.getCellDepth( 0 ) + 100, 1e-10 );
+}
+
+/*
+  With DX varying in j and k the cells do not share corners with their
+  neighbours, and the geometry must be computed from the corners of
+  each cell in the ERT grid.
+*/
+BOOST_AUTO_TEST_CASE(DXVaryingInJAndKAgreesWithERT) {
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 3 3 2 /\n"
+        "GRID\n"
+        "DX\n"
+        " 3*10 3*15 3*20 3*13 3*18 3*23 /\n"
+        "DY\n"
+        " 18*10 /\n"
+        "DZ\n"
+        " 18*5 /\n"
+        "TOPS\n"
+        " 9*1000 /\n"
+        "EDIT\n"
+        "\n";
+
+    Parser parser;
+    const EclipseGrid grid( parser.parseString( deckData, ParseContext() ) );
+    const auto& geometry = grid.geometry();
+
+    checkAgainstERT( grid, 1e-8 );
+    for( size_t g = 0; g < grid.getCartesianSize(); g++ ) {
+        const auto ijk = grid.getIJK( g );
+        const double dx = 10 + 5 * ijk[ 1 ] + 3 * ijk[ 2 ];
+        const int gi = static_cast< int >( g );
+
+        BOOST_CHECK_CLOSE( geometry.dx()[ g ], dx, 1e-8 );
+        BOOST_CHECK_CLOSE( geometry.dx()[ g ], ecl_grid_get_cell_dx1( grid.c_ptr(), gi ), 1e-8 );
+        BOOST_CHECK_CLOSE( geometry.dy()[ g ], ecl_grid_get_cell_dy1( grid.c_ptr(), gi ), 1e-8 );
+        BOOST_CHECK_CLOSE( grid.getCellVolume( g ), dx * 10 * 5, 1e-8 );
+        BOOST_CHECK_CLOSE( grid.getCellCenter( g )[ 0 ], grid.getCornerPos( ijk[ 0 ], ijk[ 1 ], ijk[ 2 ], 0 )[ 0 ] + dx / 2, 1e-8 );
+    }
+}
@@ -535,6 +535,30 @@ BOOST_AUTO_TEST_CASE(addKeyword) {
 }
 
 
+BOOST_AUTO_TEST_CASE(moveProperties) {
+    typedef Opm::GridProperties<int>::SupportedKeywordInfo SupportedKeywordInfo;
+    std::vector<SupportedKeywordInfo> supportedKeywords = {
+        SupportedKeywordInfo("SATNUM" , 0, "1")
+    };
+    Opm::EclipseGrid grid(10,7,9);
+    Opm::GridProperties<int> gridProperties(grid, std::move( supportedKeywords ));
+    const auto keyword = []( const Opm::GridProperties<int>& properties ) {
+        return &properties.getKeyword("SATNUM");
+    };
+    const auto* satnum = keyword( gridProperties );
+
+    // moving hands over the properties instead of copying them
+    Opm::GridProperties<int> moved( std::move( gridProperties ));
+    BOOST_CHECK_EQUAL( keyword( moved ), satnum );
+    BOOST_CHECK_EQUAL( gridProperties.size(), 0U );
+
+    Opm::GridProperties<int> assigned;
+    assigned = std::move( moved );
+    BOOST_CHECK_EQUAL( keyword( assigned ), satnum );
+    BOOST_CHECK( assigned.supportsKeyword("SATNUM"));
+}
+
+
 BOOST_AUTO_TEST_CASE(hasKeyword_assertKeyword) {
     typedef Opm::GridProperties<int>::SupportedKeywordInfo SupportedKeywordInfo;
     std::vector<SupportedKeywordInfo> supportedKeywords = {
@@ -19,6 +19,7 @@
 
 #include <stdexcept>
 #include <iostream>
+#include <sstream>
 #include <boost/filesystem.hpp>
 
 #define BOOST_TEST_MODULE MULTREGTScannerTests
@@ -264,3 +265,72 @@ BOOST_AUTO_TEST_CASE(MULTREGT_COPY_MULTNUM) {
         BOOST_CHECK_EQUAL(fdata[i], data[i]);
     }
 }
+
+static Opm::Deck createRegionChainDeck(size_t nx) {
+    std::ostringstream deckData;
+    deckData << "RUNSPEC\n"
+             << "DIMENS\n"
+             << nx << " 1 2 /\n"
+             << "GRID\n"
+             << "DX\n" << 2 * nx << "*0.25 /\n"
+             << "DY\n" << 2 * nx << "*0.25 /\n"
+             << "DZ\n" << 2 * nx << "*0.25 /\n"
+             << "TOPS\n" << nx << "*0.25 /\n"
+             << "MULTNUM\n";
+    for (size_t k = 0; k < 2; k++)
+        for (size_t i = 0; i < nx; i++)
+            deckData << i + 1 << " ";
+    deckData << "/\n"
+             << "MULTREGT\n";
+    for (size_t i = 1; i < nx; i += 2)
+        deckData << i << " " << i + 1 << " " << 0.01 * i << " X ALL M /\n";
+    deckData << "2 5 3.0 XYZ NNC M /\n"
+             << "/\n"
+             << "EDIT\n";
+
+    Opm::Parser parser;
+    return parser.parseString(deckData.str(), Opm::ParseContext()) ;
+}
+
+BOOST_AUTO_TEST_CASE(RegionTableLookup) {
+    /* 12 regions are kept in a dense table, 300 in a sparse one. */
+    for (size_t nx : { 12, 300 }) {
+        Opm::Deck deck = createRegionChainDeck( nx );
+        Opm::TableManager tm(deck);
+        Opm::EclipseGrid eg(deck);
+        Opm::Eclipse3DProperties props(deck, tm, eg);
+        const auto& multregt = deck.getKeyword( "MULTREGT" );
+        Opm::MULTREGTScanner scanner( props, { &multregt } );
+
+        std::vector< size_t > cells1;
+        std::vector< size_t > cells2;
+        std::vector< Opm::FaceDir::DirEnum > faces;
+        for (size_t i = 0; i + 1 < nx; i++) {
+            const double expected = (i % 2 == 0) ? 0.01 * (i + 1) : 1.0;
+            BOOST_CHECK_CLOSE( expected, scanner.getRegionMultiplier( i , i + 1 , Opm::FaceDir::XPlus ), 1e-10);
+            BOOST_CHECK_CLOSE( expected, scanner.getRegionMultiplier( i + 1 , i , Opm::FaceDir::XMinus ), 1e-10);
+            BOOST_CHECK_EQUAL( 1.0, scanner.getRegionMultiplier( i , i + 1 , Opm::FaceDir::YPlus ));
+
+            cells1.push_back( i );
+            cells2.push_back( i + 1 );
+            faces.push_back( Opm::FaceDir::XPlus );
+            cells1.push_back( i );
+            cells2.push_back( i + nx );
+            faces.push_back( Opm::FaceDir::ZPlus );
+        }
+
+        /* Region 2 -> 5 applies in all directions, but only between cells which are not i,j neighbours. */
+        BOOST_CHECK_EQUAL( 3.0, scanner.getRegionMultiplier( 1 , 4 , Opm::FaceDir::YPlus ));
+        BOOST_CHECK_EQUAL( 3.0, scanner.getRegionMultiplier( 1 , nx + 4 , Opm::FaceDir::ZPlus ));
+        BOOST_CHECK_EQUAL( 3.0, scanner.getRegionMultiplier( nx + 4 , 1 , Opm::FaceDir::ZMinus ));
+
+        const auto multipliers = scanner.getRegionMultipliers( cells1, cells2, faces );
+        BOOST_CHECK_EQUAL( cells1.size(), multipliers.size() );
+        for (size_t c = 0; c < multipliers.size(); c++)
+            BOOST_CHECK_EQUAL( scanner.getRegionMultiplier( cells1[c], cells2[c], faces[c] ), multipliers[c] );
+
+        cells2.pop_back();
+        BOOST_CHECK_THROW( scanner.getRegionMultipliers( cells1, cells2, faces ), std::invalid_argument );
+        BOOST_CHECK_THROW( scanner.getRegionMultiplier( 0, 2 * nx, Opm::FaceDir::XPlus ), std::out_of_range );
+    }
+}
@@ -0,0 +1,106 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <vector>
+
+#define BOOST_TEST_MODULE NNCIndexTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/EclipseState/Grid/NNC.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNCIndex.hpp>
+
+using namespace Opm;
+
+BOOST_AUTO_TEST_CASE(Empty) {
+    const NNCIndex index;
+    BOOST_CHECK_EQUAL( 0U, index.size() );
+    BOOST_CHECK( index.cellConnections( 3 ).empty() );
+    BOOST_CHECK( !index.hasConnection( 0, 1 ) );
+    BOOST_CHECK_EQUAL( 1U, index.offsets().size() );
+}
+
+BOOST_AUTO_TEST_CASE(SortAndCombine) {
+    NNC nnc;
+    nnc.addNNC( 7, 2, 1.0 );
+    nnc.addNNC( 2, 9, 0.5 );
+    nnc.addNNC( 2, 7, 0.25 );
+    nnc.addNNC( 5, 5, 3.0 );
+    nnc.addNNC( 1, 9, 2.0 );
+
+    const NNCIndex index( nnc );
+    BOOST_CHECK_EQUAL( 4U, index.size() );
+
+    const auto& connections = index.connections();
+    BOOST_CHECK_EQUAL( 1U, connections[ 0 ].cell1 );
+    BOOST_CHECK_EQUAL( 9U, connections[ 0 ].cell2 );
+    BOOST_CHECK_EQUAL( 2U, connections[ 1 ].cell1 );
+    BOOST_CHECK_EQUAL( 7U, connections[ 1 ].cell2 );
+    BOOST_CHECK_EQUAL( 1.25, connections[ 1 ].trans );
+    BOOST_CHECK_EQUAL( 2U, connections[ 2 ].cell1 );
+    BOOST_CHECK_EQUAL( 9U, connections[ 2 ].cell2 );
+    BOOST_CHECK_EQUAL( 5U, connections[ 3 ].cell1 );
+    BOOST_CHECK_EQUAL( 5U, connections[ 3 ].cell2 );
+
+    BOOST_CHECK( index.hasConnection( 7, 2 ) );
+    BOOST_CHECK( index.hasConnection( 9, 1 ) );
+    BOOST_CHECK( !index.hasConnection( 1, 2 ) );
+    BOOST_CHECK_EQUAL( 1.25, index.find( 7, 2 )->trans );
+    BOOST_CHECK( index.find( 7, 9 ) == nullptr );
+
+    BOOST_CHECK( std::vector< size_t >( { 1, 2, 5, 7, 9 } ) == index.cells() );
+    BOOST_CHECK( std::vector< size_t >( { 0, 1, 3, 4, 5, 7 } ) == index.offsets() );
+
+    const auto range = index.cellConnections( 9 );
+    BOOST_CHECK( std::vector< size_t >( { 0, 2 } ) == std::vector< size_t >( range.begin(), range.end() ) );
+    BOOST_CHECK_EQUAL( 1U, index.cellConnections( 5 ).size() );
+    BOOST_CHECK( index.cellConnections( 4 ).empty() );
+}
+
+BOOST_AUTO_TEST_CASE(Merge) {
+    NNCIndex index( std::vector< NNCdata >( { { 0, 4, 1.0 }, { 3, 1, 2.0 } } ) );
+
+    index.merge( { { 4, 0, 0.5 }, { 2, 3, 1.0 } } );
+    BOOST_CHECK_EQUAL( 3U, index.size() );
+    BOOST_CHECK_EQUAL( 1.5, index.find( 0, 4 )->trans );
+    BOOST_CHECK_EQUAL( 2.0, index.find( 1, 3 )->trans );
+    BOOST_CHECK_EQUAL( 1.0, index.find( 3, 2 )->trans );
+    BOOST_CHECK_EQUAL( 2U, index.cellConnections( 3 ).size() );
+}
+
+BOOST_AUTO_TEST_CASE(LargeInput) {
+    /* Large enough to be sorted in several chunks. */
+    std::vector< NNCdata > nncs;
+    const size_t n = 200000;
+    for( size_t i = 0; i < n; i++ )
+        nncs.push_back( { ( i * 7919 ) % n, ( i * 104729 + 1 ) % n, 1.0 } );
+    nncs.push_back( nncs[ 10 ] );
+
+    const NNCIndex index( nncs );
+    const auto& connections = index.connections();
+    for( size_t i = 0; i < connections.size(); i++ ) {
+        BOOST_CHECK( connections[ i ].cell1 <= connections[ i ].cell2 );
+        if( i > 0 )
+            BOOST_CHECK( connections[ i - 1 ].cell1 < connections[ i ].cell1 ||
+                         ( connections[ i - 1 ].cell1 == connections[ i ].cell1 &&
+                           connections[ i - 1 ].cell2 < connections[ i ].cell2 ) );
+    }
+
+    BOOST_CHECK_EQUAL( 2.0, index.find( nncs[ 10 ].cell1, nncs[ 10 ].cell2 )->trans );
+}
@@ -17,6 +17,9 @@
   along with OPM.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <future>
+#include <stdexcept>
+
 #define BOOST_TEST_MODULE ParserTests
 #include <boost/test/unit_test.hpp>
 
@@ -1873,3 +1876,144 @@ AQUTAB
   BOOST_CHECK_EQUAL( 1, aqutab.size());
 }
 
+
+
+BOOST_AUTO_TEST_CASE(ParseStatisticsCounters) {
+  const auto * deck_string = R"(
+RUNSPEC
+
+DIMENS
+  10 10 10 /
+
+GRID
+
+PORO
+  1000*0.25 /
+
+PERMX
+  500*100 500*200 /
+
+PERMY
+  1000*100 /
+)";
+
+  Parser parser;
+  {
+      const auto deck = parser.parseString( deck_string, ParseContext());
+      BOOST_CHECK( !deck.hasParseStatistics() );
+      BOOST_CHECK_THROW( deck.getParseStatistics(), std::invalid_argument );
+  }
+
+  parser.setProfiling( true );
+  const auto deck = parser.parseString( deck_string, ParseContext());
+  if (!parser.profiling()) {
+      BOOST_CHECK( !deck.hasParseStatistics() );
+      return;
+  }
+
+  BOOST_CHECK( deck.hasParseStatistics() );
+  const auto& stats = deck.getParseStatistics();
+  const auto& keywords = stats.keywords();
+
+  BOOST_CHECK_EQUAL( 6U, keywords.size() );
+  const auto& poro = keywords.at( "PORO" );
+  BOOST_CHECK_EQUAL( 1U, poro.count );
+  BOOST_CHECK_EQUAL( 1U, poro.records );
+  BOOST_CHECK_EQUAL( 1U, poro.items );
+  BOOST_CHECK_EQUAL( 1000U, poro.values );
+  BOOST_CHECK( poro.bytes > 0 );
+  BOOST_CHECK( poro.lex_time >= 0 );
+  BOOST_CHECK( poro.scan_time >= 0 );
+
+  const auto& dimens = keywords.at( "DIMENS" );
+  BOOST_CHECK_EQUAL( 1U, dimens.records );
+  BOOST_CHECK_EQUAL( 3U, dimens.items );
+  BOOST_CHECK_EQUAL( 0, dimens.convert_time );
+
+  const auto total = stats.total();
+  BOOST_CHECK_EQUAL( 6U, total.count );
+  BOOST_CHECK_EQUAL( 3003U, total.values );
+  BOOST_CHECK_EQUAL( 1U, stats.files().size() );
+
+  const auto sorted = stats.sortedKeywords();
+  BOOST_CHECK_EQUAL( sorted.size(), keywords.size() );
+  for (size_t i = 1; i < sorted.size(); i++)
+      BOOST_CHECK( sorted[i - 1].second.total_time() >= sorted[i].second.total_time() );
+
+  std::stringstream ss;
+  stats.report( ss );
+  BOOST_CHECK( ss.str().find( "PORO" ) != std::string::npos );
+
+  /* A copy of the deck has statistics of its own. */
+  const double poro_convert = poro.convert_time;
+  Deck copy( deck );
+  BOOST_CHECK( &copy.getParseStatistics() != &stats );
+  copy.getParseStatistics().addConvert( "PORO", "", 1.0, 0 );
+  BOOST_CHECK_EQUAL( poro_convert, keywords.at( "PORO" ).convert_time );
+  BOOST_CHECK_EQUAL( poro_convert + 1.0, copy.getParseStatistics().keywords().at( "PORO" ).convert_time );
+}
+
+
+
+BOOST_AUTO_TEST_CASE(ParseHeadHandler) {
+  const auto * deck_string = R"(
+RUNSPEC
+
+FIELD
+
+DIMENS
+  1 1 1 /
+
+AQUDIMS
+ * * 2 /
+
+GRID
+
+TOPS
+  100 /
+
+PROPS
+
+AQUTAB
+  0    1
+  0.10 1.1
+  0.20 1.2 /
+)";
+
+  Parser parser;
+  size_t head_size = 0;
+  double head_tops = 0;
+  const auto deck = parser.parseString( deck_string, ParseContext(), "PROPS",
+      [&]( const Deck& head ) {
+          head_size = head.size();
+          return std::async( std::launch::async, [&] {
+              head_tops = head.getKeyword( "TOPS" ).getSIDoubleData()[ 0 ];
+          } );
+      } );
+
+  BOOST_CHECK_EQUAL( 6U, head_size );
+  BOOST_CHECK_CLOSE( 30.48, head_tops, 1e-10 );
+
+  const auto reference = parser.parseString( deck_string, ParseContext() );
+  BOOST_CHECK_EQUAL( reference.size(), deck.size() );
+  for( size_t i = 0; i < deck.size(); i++ )
+      BOOST_CHECK( reference.getKeyword( i ).equal( deck.getKeyword( i ) ) );
+
+  BOOST_CHECK( deck.getActiveUnitSystem().getType() == UnitSystem::UnitType::UNIT_TYPE_FIELD );
+  BOOST_CHECK_CLOSE( 30.48, deck.getKeyword( "TOPS" ).getSIDoubleData()[ 0 ], 1e-10 );
+  BOOST_CHECK_EQUAL( 1U, deck.getKeyword( "AQUTAB" ).size() );
+
+  size_t full_size = 0;
+  parser.parseString( deck_string, ParseContext(), "SCHEDULE",
+      [&]( const Deck& head ) {
+          full_size = head.size();
+          return std::future< void >();
+      } );
+  BOOST_CHECK_EQUAL( deck.size(), full_size );
+
+  const auto failing = []( const Deck& ) {
+      return std::async( std::launch::async, [] { throw std::runtime_error( "head failed" ); } );
+  };
+  BOOST_CHECK_THROW( parser.parseString( deck_string, ParseContext(), "PROPS", failing ), std::runtime_error );
+  BOOST_CHECK_THROW( parser.parseString( deck_string, ParseContext(), "TOPS", failing ), std::invalid_argument );
+}
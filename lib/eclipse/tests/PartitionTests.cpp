@@ -0,0 +1,149 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#define BOOST_TEST_MODULE PartitionTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/Partition.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    const char* deckData =
+        "RUNSPEC\n"
+        "DIMENS\n"
+        " 4 2 1 /\n"
+        "GRID\n"
+        "DX\n"
+        " 8*10 /\n"
+        "DY\n"
+        " 8*10 /\n"
+        "DZ\n"
+        " 8*5 /\n"
+        "TOPS\n"
+        " 8*100 /\n"
+        "PORO\n"
+        " 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 /\n"
+        "EDIT\n"
+        "NNC\n"
+        "  1 1 1  4 2 1  2.5 /\n"
+        "  3 1 1  4 2 1  1.5 /\n"
+        "/\n"
+        "PROPS\n"
+        "SOLUTION\n";
+
+    EclipseState makeState() {
+        ParseContext parseContext;
+        const auto deck = Parser().parseString( deckData, parseContext );
+        return EclipseState( deck, parseContext );
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(Bisect) {
+    const auto state = makeState();
+    const auto& grid = state.getInputGrid();
+
+    const std::vector< int > halves = { 0, 0, 1, 1, 0, 0, 1, 1 };
+    BOOST_CHECK( halves == Partition::bisect( grid, 2 ) );
+
+    const auto quarters = Partition::bisect( grid, 4 );
+    for( int rank = 0; rank < 4; rank++ )
+        BOOST_CHECK_EQUAL( 2, std::count( quarters.begin(), quarters.end(), rank ) );
+
+    const std::vector< int > single( 8, 0 );
+    BOOST_CHECK( single == Partition::bisect( grid, 1 ) );
+    BOOST_CHECK_THROW( Partition::bisect( grid, 0 ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(LocalCells) {
+    const auto state = makeState();
+    const auto owner = Partition::bisect( state.getInputGrid(), 2 );
+    const auto partition = state.getPartition( owner, 0 );
+
+    BOOST_CHECK_EQUAL( 0, partition.rank() );
+    BOOST_CHECK_EQUAL( 4U, partition.numOwned() );
+    BOOST_CHECK_EQUAL( 7U, partition.numCells() );
+
+    const std::vector< size_t > global = { 0, 1, 4, 5, 2, 6, 7 };
+    BOOST_CHECK( global == partition.globalIndex() );
+    BOOST_CHECK( partition.isOwned( 3 ) );
+    BOOST_CHECK( !partition.isOwned( 4 ) );
+    BOOST_CHECK_EQUAL( 6, partition.localIndex( 7 ) );
+    BOOST_CHECK_EQUAL( 2, partition.localIndex( 4 ) );
+    BOOST_CHECK_EQUAL( -1, partition.localIndex( 3 ) );
+
+    BOOST_CHECK_THROW( state.getPartition( { 0, 1 }, 0 ), std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(LocalGraph) {
+    const auto state = makeState();
+    const auto partition = state.getPartition( Partition::bisect( state.getInputGrid(), 2 ), 0 );
+
+    const auto& offsets = partition.offsets();
+    const auto& neighbours = partition.neighbours();
+    BOOST_CHECK_EQUAL( 5U, offsets.size() );
+
+    /* Cell 0 connects to 1 and 4, and to the halo cell 7 through the NNC. */
+    BOOST_CHECK_EQUAL( 3U, offsets[ 1 ] );
+    BOOST_CHECK_EQUAL( 1, neighbours[ 0 ] );
+    BOOST_CHECK_EQUAL( 2, neighbours[ 1 ] );
+    BOOST_CHECK_EQUAL( 6, neighbours[ 2 ] );
+    BOOST_CHECK_EQUAL( 0, partition.faces()[ 2 ] );
+    BOOST_CHECK_EQUAL( state.getInputNNC().nncdata()[ 0 ].trans, partition.nncTrans()[ 2 ] );
+
+    /* Cell 1 connects to 0, the halo cell 2 and 5. */
+    BOOST_CHECK_EQUAL( 6U, offsets[ 2 ] );
+    BOOST_CHECK_EQUAL( 0, neighbours[ 3 ] );
+    BOOST_CHECK_EQUAL( 4, neighbours[ 4 ] );
+    BOOST_CHECK_EQUAL( 3, neighbours[ 5 ] );
+}
+
+BOOST_AUTO_TEST_CASE(Extract) {
+    const auto state = makeState();
+    const auto partition = state.getPartition( Partition::bisect( state.getInputGrid(), 2 ), 1 );
+
+    const auto& poro = state.get3DProperties().getDoubleGridProperty( "PORO" ).getData();
+    const auto local = partition.extract( poro );
+    /* The owned cells 2, 3, 6, 7 and the halo cells 0, 1, 5. */
+    BOOST_CHECK_EQUAL( 7U, local.size() );
+    BOOST_CHECK_CLOSE( 0.3, local[ 0 ], 1e-12 );
+    BOOST_CHECK_CLOSE( 0.8, local[ 3 ], 1e-12 );
+    BOOST_CHECK_CLOSE( 0.1, local[ 4 ], 1e-12 );
+
+    const std::vector< int > active = { 10, 11, 12, 13, 14, 15, 16, 17 };
+    BOOST_CHECK_EQUAL( 16, partition.extract( active )[ 2 ] );
+    BOOST_CHECK_THROW( partition.extract( std::vector< int >( 3 ) ), std::invalid_argument );
+
+    BOOST_CHECK_EQUAL( 2U, partition.nncs( state.getInputNNC() ).size() );
+    const auto other = state.getPartition( Partition::bisect( state.getInputGrid(), 2 ), 0 );
+    const auto nncs = other.nncs( state.getInputNNC() );
+    BOOST_CHECK_EQUAL( 1U, nncs.size() );
+    BOOST_CHECK_EQUAL( 0U, nncs[ 0 ].cell1 );
+}
@@ -0,0 +1,127 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <string>
+#include <vector>
+
+#define BOOST_TEST_MODULE PinchProcessorTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/NNCIndex.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/PinchProcessor.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+
+using namespace Opm;
+
+namespace {
+
+    /*
+      Two columns of six layers, where layers 2 and 5 are thinner than
+      the PINCH threshold. In the first column layer 4 is inactive, in
+      the second column layer 3 is removed by MINPV.
+    */
+    EclipseState makeState( const std::string& pinch ) {
+        const std::string deckData =
+            "RUNSPEC\n"
+            "DIMENS\n"
+            " 2 1 6 /\n"
+            "GRID\n"
+            "DX\n"
+            " 12*10 /\n"
+            "DY\n"
+            " 12*10 /\n"
+            "DZ\n"
+            " 2*1 2*0.05 2*1 2*1 2*0.05 2*1 /\n"
+            "TOPS\n"
+            " 2*100 /\n"
+            "PORO\n"
+            " 5*0.2 0.0001 6*0.2 /\n"
+            "ACTNUM\n"
+            " 6*1 0 5*1 /\n"
+            "MULTZ\n"
+            " 2*1 0.5 9*1 /\n"
+            + pinch +
+            "MINPV\n"
+            " 0.05 /\n"
+            "PROPS\n"
+            "SOLUTION\n";
+
+        ParseContext parseContext;
+        const auto deck = Parser().parseString( deckData, parseContext );
+        return EclipseState( deck, parseContext );
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(NoGap) {
+    const auto state = makeState( "PINCH\n 0.1 NOGAP 1* TOPBOT ALL /\n" );
+    const auto pinch = state.getPinchProcessor();
+
+    BOOST_CHECK_EQUAL( 5U, pinch.numRemoved() );
+    const std::vector< int > actnum = { 1, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 1 };
+    BOOST_CHECK( actnum == pinch.actnum() );
+
+    /* The inactive layer 4 blocks the connection from layer 3 to 6 in the first column. */
+    const auto& connections = pinch.connections();
+    BOOST_CHECK_EQUAL( 3U, connections.size() );
+    BOOST_CHECK_EQUAL( 0U, connections[ 0 ].cell1 );
+    BOOST_CHECK_EQUAL( 4U, connections[ 0 ].cell2 );
+    BOOST_CHECK_EQUAL( 0.5, connections[ 0 ].multz );
+    BOOST_CHECK_EQUAL( 1U, connections[ 1 ].cell1 );
+    BOOST_CHECK_EQUAL( 7U, connections[ 1 ].cell2 );
+    BOOST_CHECK_EQUAL( 1.0, connections[ 1 ].multz );
+    BOOST_CHECK_EQUAL( 7U, connections[ 2 ].cell1 );
+    BOOST_CHECK_EQUAL( 11U, connections[ 2 ].cell2 );
+
+    NNCIndex index( state.getInputNNC() );
+    index.merge( pinch.nncs() );
+    BOOST_CHECK_EQUAL( 3U, index.size() );
+    BOOST_CHECK( index.hasConnection( 11, 7 ) );
+}
+
+BOOST_AUTO_TEST_CASE(Gap) {
+    const auto pinch = makeState( "PINCH\n 0.1 GAP 1* TOPBOT TOP /\n" ).getPinchProcessor();
+    const auto& connections = pinch.connections();
+
+    BOOST_CHECK_EQUAL( 4U, connections.size() );
+    BOOST_CHECK_EQUAL( 1.0, connections[ 0 ].multz );
+    BOOST_CHECK_EQUAL( 4U, connections[ 1 ].cell1 );
+    BOOST_CHECK_EQUAL( 10U, connections[ 1 ].cell2 );
+}
+
+BOOST_AUTO_TEST_CASE(MaxEmptyGap) {
+    const auto pinch = makeState( "PINCH\n 0.1 GAP 0.5 TOPBOT TOP /\n" ).getPinchProcessor();
+    const auto& connections = pinch.connections();
+
+    BOOST_CHECK_EQUAL( 2U, connections.size() );
+    BOOST_CHECK_EQUAL( 0U, connections[ 0 ].cell1 );
+    BOOST_CHECK_EQUAL( 7U, connections[ 1 ].cell1 );
+}
+
+BOOST_AUTO_TEST_CASE(MinpvOnly) {
+    const auto pinch = makeState( "" ).getPinchProcessor();
+
+    BOOST_CHECK_EQUAL( 1U, pinch.numRemoved() );
+    BOOST_CHECK_EQUAL( 0, pinch.actnum()[ 5 ] );
+    BOOST_CHECK( pinch.connections().empty() );
+}
@@ -0,0 +1,117 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include <string>
+
+#define BOOST_TEST_MODULE StateLoaderTests
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
+#include <opm/parser/eclipse/EclipseState/StateLoader.hpp>
+#include <opm/parser/eclipse/EclipseState/Tables/TableManager.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Utility/SyntheticDeck.hpp>
+
+using namespace Opm;
+
+namespace {
+    SyntheticDeck::Options smallOptions() {
+        SyntheticDeck::Options options;
+        options.nx = 6;
+        options.ny = 5;
+        options.nz = 3;
+        options.wells = 3;
+        options.steps = 4;
+        options.seed = 5;
+        return options;
+    }
+
+    void checkEqual( const StateLoader& loader, const Deck& deck ) {
+        ParseContext parseContext;
+        const EclipseState state( deck, parseContext );
+        const Schedule schedule( deck, state, parseContext );
+
+        const auto& loaded_deck = loader.getDeck();
+        BOOST_CHECK_EQUAL( deck.size(), loaded_deck.size() );
+        for( size_t i = 0; i < deck.size(); i++ )
+            BOOST_CHECK( deck.getKeyword( i ).equal( loaded_deck.getKeyword( i ) ) );
+        BOOST_CHECK( loaded_deck.getActiveUnitSystem().getType() == deck.getActiveUnitSystem().getType() );
+
+        const auto& loaded_state = loader.getEclipseState();
+        const auto& grid = state.getInputGrid();
+        const auto& loaded_grid = loaded_state.getInputGrid();
+        BOOST_CHECK_EQUAL( grid.getNumActive(), loaded_grid.getNumActive() );
+        for( size_t g = 0; g < grid.getCartesianSize(); g++ )
+            BOOST_CHECK_CLOSE( grid.getCellVolume( g ), loaded_grid.getCellVolume( g ), 1e-10 );
+
+        BOOST_CHECK_EQUAL( state.getTableManager().getSwofTables().size(),
+                           loaded_state.getTableManager().getSwofTables().size() );
+        BOOST_CHECK( state.get3DProperties().getDoubleGridProperty( "PORV" ).getData()
+                     == loaded_state.get3DProperties().getDoubleGridProperty( "PORV" ).getData() );
+        BOOST_CHECK_EQUAL( state.getMessageContainer().size(), loaded_state.getMessageContainer().size() );
+
+        const auto& loaded_schedule = loader.getSchedule();
+        BOOST_CHECK_EQUAL( schedule.numWells(), loaded_schedule.numWells() );
+        BOOST_CHECK_EQUAL( schedule.getTimeMap().size(), loaded_schedule.getTimeMap().size() );
+    }
+}
+
+BOOST_AUTO_TEST_CASE(LoadString) {
+    const SyntheticDeck synthetic( smallOptions() );
+    Parser parser;
+
+    const auto loader = StateLoader::loadString( parser, synthetic.str() );
+    checkEqual( loader, parser.parseString( synthetic.str(), ParseContext() ) );
+}
+
+BOOST_AUTO_TEST_CASE(LoadFileWithIncludes) {
+    using namespace boost::filesystem;
+    const path root = temp_directory_path() / unique_path( "%%%%-%%%%" );
+    create_directories( root );
+
+    const SyntheticDeck synthetic( smallOptions() );
+    const auto filename = ( root / "SYNTHETIC.DATA" ).string();
+    synthetic.writeSplit( filename );
+
+    Parser parser;
+    const auto loader = StateLoader::loadFile( parser, filename );
+    checkEqual( loader, parser.parseFile( filename, ParseContext() ) );
+
+    remove_all( root );
+}
+
+BOOST_AUTO_TEST_CASE(NoSchedule) {
+    const SyntheticDeck synthetic( smallOptions() );
+    const auto data = "RUNSPEC\n\n" + synthetic.runspec()
+                    + "GRID\n\n" + synthetic.geometry() + synthetic.properties()
+                    + "PROPS\n\n" + synthetic.props()
+                    + "REGIONS\n\n" + synthetic.regions()
+                    + "SOLUTION\n\n" + synthetic.solution();
+    Parser parser;
+
+    const auto loader = StateLoader::loadString( parser, data );
+    checkEqual( loader, parser.parseString( data, ParseContext() ) );
+}
@@ -0,0 +1,133 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define BOOST_TEST_MODULE SyntheticDeckTests
+
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/EclipseGrid.hpp>
+#include <opm/parser/eclipse/EclipseState/Grid/FaultCollection.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/Schedule.hpp>
+#include <opm/parser/eclipse/EclipseState/Schedule/TimeMap.hpp>
+#include <opm/parser/eclipse/EclipseState/SummaryConfig/SummaryConfig.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Utility/SyntheticDeck.hpp>
+
+using namespace Opm;
+
+namespace {
+    SyntheticDeck::Options smallOptions() {
+        SyntheticDeck::Options options;
+        options.nx = 6;
+        options.ny = 5;
+        options.nz = 3;
+        options.wells = 3;
+        options.steps = 4;
+        options.regions = 3;
+        options.faults = 2;
+        options.seed = 17;
+        return options;
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CreateStateFromSyntheticDeck) {
+    const SyntheticDeck synthetic( smallOptions() );
+    ParseContext parseContext;
+    const auto deck = Parser().parseString( synthetic.str(), parseContext );
+
+    EclipseState state( deck, parseContext );
+    const auto& grid = state.getInputGrid();
+    BOOST_CHECK_EQUAL( 6U, grid.getNX() );
+    BOOST_CHECK_EQUAL( 5U, grid.getNY() );
+    BOOST_CHECK_EQUAL( 3U, grid.getNZ() );
+    BOOST_CHECK_EQUAL( 90U, grid.getNumActive() );
+    for( size_t g = 0; g < grid.getCartesianSize(); g++ )
+        BOOST_CHECK( grid.getCellVolume( g ) > 0 );
+
+    BOOST_CHECK_EQUAL( 2U, state.getFaults().size() );
+    BOOST_CHECK( state.get3DProperties().hasDeckIntGridProperty( "MULTNUM" ) );
+    BOOST_CHECK( state.get3DProperties().hasDeckIntGridProperty( "FIPNUM" ) );
+
+    Schedule schedule( deck, state, parseContext );
+    BOOST_CHECK_EQUAL( 3U, schedule.numWells() );
+    BOOST_CHECK_EQUAL( 5U, schedule.getTimeMap().size() );
+
+    SummaryConfig summary( deck, schedule, state.getTableManager(), parseContext );
+    BOOST_CHECK( summary.hasKeyword( "WOPR" ) );
+}
+
+BOOST_AUTO_TEST_CASE(DeterministicFromSeed) {
+    auto options = smallOptions();
+    const SyntheticDeck deck1( options );
+    const SyntheticDeck deck2( options );
+    BOOST_CHECK_EQUAL( deck1.str(), deck2.str() );
+
+    options.seed = 18;
+    const SyntheticDeck deck3( options );
+    BOOST_CHECK( deck1.str() != deck3.str() );
+}
+
+BOOST_AUTO_TEST_CASE(RepeatCompression) {
+    auto options = smallOptions();
+    options.repeat = 5;
+    const SyntheticDeck compressed( options );
+    BOOST_CHECK( compressed.properties().find( "5*" ) != std::string::npos );
+    BOOST_CHECK( compressed.properties().size() < SyntheticDeck( smallOptions() ).properties().size() );
+
+    const auto deck = Parser().parseString( compressed.str(), ParseContext() );
+    const auto& poro = deck.getKeyword( "PORO" ).getSIDoubleData();
+    BOOST_CHECK_EQUAL( 90U, poro.size() );
+    for( size_t g = 0; g < poro.size(); g++ )
+        BOOST_CHECK_EQUAL( poro[ g ], poro[ g - g % 5 ] );
+}
+
+BOOST_AUTO_TEST_CASE(InvalidOptionsThrow) {
+    auto options = smallOptions();
+    options.wells = 31;
+    BOOST_CHECK_THROW( SyntheticDeck{ options }, std::invalid_argument );
+
+    options = smallOptions();
+    options.nz = 0;
+    BOOST_CHECK_THROW( SyntheticDeck{ options }, std::invalid_argument );
+}
+
+BOOST_AUTO_TEST_CASE(SplitIncludeFiles) {
+    using namespace boost::filesystem;
+    const path root = temp_directory_path() / unique_path( "%%%%-%%%%" );
+    create_directories( root );
+
+    const SyntheticDeck synthetic( smallOptions() );
+    synthetic.writeSplit( ( root / "SYNTHETIC.DATA" ).string() );
+    BOOST_CHECK( exists( root / "SYNTHETIC_GRID.INC" ) );
+    BOOST_CHECK( exists( root / "SYNTHETIC_PROPS.INC" ) );
+    BOOST_CHECK( exists( root / "SYNTHETIC_SCHEDULE.INC" ) );
+
+    Parser parser;
+    const auto split = parser.parseFile( ( root / "SYNTHETIC.DATA" ).string(), ParseContext() );
+    const auto single = parser.parseString( synthetic.str(), ParseContext() );
+    BOOST_CHECK_EQUAL( single.size(), split.size() );
+    BOOST_CHECK( split.getKeyword( "ZCORN" ).getSIDoubleData() == single.getKeyword( "ZCORN" ).getSIDoubleData() );
+
+    remove_all( root );
+}
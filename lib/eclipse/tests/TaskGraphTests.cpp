@@ -0,0 +1,108 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#define BOOST_TEST_MODULE TaskGraphTests
+#include <boost/test/unit_test.hpp>
+
+#include <opm/parser/eclipse/Utility/TaskGraph.hpp>
+
+using namespace Opm;
+
+BOOST_AUTO_TEST_CASE(SequentialOrder) {
+    TaskGraph graph;
+    std::vector< int > order;
+
+    const auto a = graph.add( "a", [&] { order.push_back( 0 ); } );
+    const auto b = graph.add( "b", [&] { order.push_back( 1 ); } );
+    graph.add( "c", [&] { order.push_back( 2 ); }, { a, b } );
+    graph.add( "d", [&] { order.push_back( 3 ); }, { a } );
+
+    BOOST_CHECK_EQUAL( 4U, graph.size() );
+    graph.run( 1 );
+
+    const std::vector< int > expected = { 0, 1, 2, 3 };
+    BOOST_CHECK_EQUAL_COLLECTIONS( order.begin(), order.end(), expected.begin(), expected.end() );
+}
+
+BOOST_AUTO_TEST_CASE(InvalidDependency) {
+    TaskGraph graph;
+    graph.add( "a", [] {} );
+
+    BOOST_CHECK_THROW( graph.add( "b", [] {}, { 1 } ), std::invalid_argument );
+    BOOST_CHECK_EQUAL( 1U, graph.size() );
+}
+
+BOOST_AUTO_TEST_CASE(Dependencies) {
+    const size_t width = 16;
+    TaskGraph graph;
+    std::vector< std::atomic< bool > > done( 2 * width + 1 );
+    std::atomic< size_t > violations( 0 );
+
+    for( auto& d : done )
+        d = false;
+
+    /* width independent tasks, each with a dependent, and a final join */
+    std::vector< size_t > second;
+    for( size_t i = 0; i < width; i++ ) {
+        const auto first = graph.add( "first", [&done, i] { done[ i ] = true; } );
+        second.push_back( graph.add( "second", [&done, &violations, i, width] {
+            if( !done[ i ] ) violations++;
+            done[ width + i ] = true;
+        }, { first } ) );
+    }
+
+    graph.add( "join", [&] {
+        for( size_t i = 0; i < 2 * width; i++ )
+            if( !done[ i ] ) violations++;
+        done[ 2 * width ] = true;
+    }, second );
+
+    graph.run( 4 );
+
+    BOOST_CHECK_EQUAL( 0U, violations.load() );
+    BOOST_CHECK( done[ 2 * width ] );
+}
+
+BOOST_AUTO_TEST_CASE(FirstErrorRethrown) {
+    TaskGraph graph;
+    std::mutex mutex;
+    std::vector< size_t > ran;
+    const auto record = [&]( size_t i ) {
+        std::lock_guard< std::mutex > lock( mutex );
+        ran.push_back( i );
+    };
+
+    const auto a = graph.add( "a", [] { throw std::invalid_argument( "a" ); } );
+    graph.add( "b", [] { throw std::runtime_error( "b" ); } );
+    graph.add( "c", [&] { record( 2 ); } );
+    graph.add( "d", [&] { record( 3 ); }, { a } );
+
+    BOOST_CHECK_THROW( graph.run( 3 ), std::invalid_argument );
+
+    /* d depends on the failed task a, and is skipped */
+    BOOST_CHECK_EQUAL( 1U, ran.size() );
+    BOOST_CHECK_EQUAL( 2U, ran[ 0 ] );
+}
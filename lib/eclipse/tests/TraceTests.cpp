@@ -0,0 +1,185 @@
+/*
+  Copyright 2018 Statoil ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+#define BOOST_TEST_MODULE TraceTests
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <opm/json/JsonObject.hpp>
+
+#include <opm/parser/eclipse/Deck/Deck.hpp>
+#include <opm/parser/eclipse/EclipseState/EclipseState.hpp>
+#include <opm/parser/eclipse/Parser/ParseContext.hpp>
+#include <opm/parser/eclipse/Parser/Parser.hpp>
+#include <opm/parser/eclipse/Utility/Trace.hpp>
+
+using namespace Opm;
+
+BOOST_AUTO_TEST_CASE(DisabledSpanRecordsNothing) {
+    Trace::disable();
+    Trace::clear();
+    {
+        Trace::Span span( "disabled", "test" );
+    }
+    BOOST_CHECK_EQUAL( 0U, Trace::size() );
+}
+
+BOOST_AUTO_TEST_CASE(SpansWrittenAsTraceEvents) {
+    Trace::enable( "" );
+    Trace::clear();
+    {
+        Trace::Span outer( "outer", "test" );
+        Trace::Span inner( std::string( "in\"ner" ), "test", "C:\\path" );
+    }
+    std::thread worker( [] { Trace::Span span( "worker", "test" ); } );
+    worker.join();
+    Trace::disable();
+
+    BOOST_CHECK_EQUAL( 3U, Trace::size() );
+
+    std::stringstream ss;
+    Trace::write( ss );
+    Json::JsonObject json( ss.str() );
+    const auto events = json.get_item( "traceEvents" );
+    BOOST_CHECK_EQUAL( 3U, events.size() );
+
+    /* The inner span is destroyed first, and is recorded first. */
+    const auto inner = events.get_array_item( 0 );
+    const auto outer = events.get_array_item( 1 );
+    const auto worker_event = events.get_array_item( 2 );
+    BOOST_CHECK_EQUAL( "in\"ner", inner.get_string( "name" ) );
+    BOOST_CHECK_EQUAL( "C:\\path", inner.get_item( "args" ).get_string( "detail" ) );
+    BOOST_CHECK_EQUAL( "X", outer.get_string( "ph" ) );
+    BOOST_CHECK_EQUAL( "test", outer.get_string( "cat" ) );
+    BOOST_CHECK( outer.get_int( "ts" ) <= inner.get_int( "ts" ) );
+    BOOST_CHECK( outer.get_int( "dur" ) >= inner.get_int( "dur" ) );
+    BOOST_CHECK_EQUAL( outer.get_int( "tid" ), inner.get_int( "tid" ) );
+    BOOST_CHECK( outer.get_int( "tid" ) != worker_event.get_int( "tid" ) );
+
+    Trace::clear();
+}
+
+BOOST_AUTO_TEST_CASE(FlushKeepsEarlierEvents) {
+    const auto filename = ( boost::filesystem::temp_directory_path()
+                          / boost::filesystem::unique_path( "Trace-%%%%-%%%%.json" ) ).string();
+
+    Trace::enable( filename );
+    Trace::clear();
+    {
+        Trace::Span span( "first", "test" );
+    }
+    Trace::flush();
+    {
+        Trace::Span span( "second", "test" );
+    }
+    Trace::flush();
+    Trace::disable();
+
+    {
+        std::ifstream stream( filename );
+        const std::string content( ( std::istreambuf_iterator< char >( stream ) ),
+                                   std::istreambuf_iterator< char >() );
+        Json::JsonObject json( content );
+        const auto events = json.get_item( "traceEvents" );
+        BOOST_CHECK_EQUAL( 2U, events.size() );
+        BOOST_CHECK_EQUAL( "first", events.get_array_item( 0 ).get_string( "name" ) );
+        BOOST_CHECK_EQUAL( "second", events.get_array_item( 1 ).get_string( "name" ) );
+    }
+
+    Trace::enable( "" );
+    Trace::disable();
+    Trace::clear();
+    boost::filesystem::remove( filename );
+}
+
+BOOST_AUTO_TEST_CASE(ParseAndStateSpans) {
+    const std::string input = R"(
+RUNSPEC
+DIMENS
+ 2 2 1 /
+GRID
+DX
+ 4*1 /
+DY
+ 4*1 /
+DZ
+ 4*1 /
+TOPS
+ 4*1 /
+PORO
+ 4*0.25 /
+PROPS
+REGIONS
+SCHEDULE
+)";
+
+    Trace::enable( "" );
+    Trace::clear();
+    {
+        ParseContext parseContext;
+        const auto deck = Parser().parseString( input, parseContext );
+        EclipseState state( deck, parseContext );
+        state.get3DProperties().getDoubleGridProperty( "PORV" );
+    }
+    Trace::disable();
+
+    std::stringstream ss;
+    Trace::write( ss );
+    const auto trace = ss.str();
+    for( const auto& name : { "Parser::parseString", "lex", "PORO",
+                              "Parser::applyUnitsToDeck", "TableManager",
+                              "EclipseGrid", "Eclipse3DProperties", "PORV",
+                              "ACTNUM", "TransMult", "EclipseState" } )
+        BOOST_CHECK_MESSAGE( trace.find( "\"name\":\"" + std::string( name ) + "\"" ) != std::string::npos,
+                             "Missing span " << name );
+
+    /* The state spans are opened before the members are built, so they
+     * enclose the spans of the member constructors. */
+    Json::JsonObject json( trace );
+    const auto events = json.get_item( "traceEvents" );
+    const auto find = [&events]( const std::string& name ) {
+        for( size_t i = 0; i < events.size(); ++i ) {
+            const auto event = events.get_array_item( i );
+            if( event.get_string( "name" ) == name ) return event;
+        }
+        BOOST_FAIL( "Missing span " << name );
+        return events.get_array_item( 0 );
+    };
+
+    const auto encloses = [&find]( const std::string& outer_name, const std::string& inner_name ) {
+        const auto outer = find( outer_name );
+        const auto inner = find( inner_name );
+        return outer.get_int( "ts" ) <= inner.get_int( "ts" )
+            && outer.get_int( "ts" ) + outer.get_int( "dur" )
+               >= inner.get_int( "ts" ) + inner.get_int( "dur" );
+    };
+
+    BOOST_CHECK( encloses( "EclipseState", "TableManager" ) );
+    BOOST_CHECK( encloses( "EclipseState", "EclipseGrid" ) );
+    BOOST_CHECK( encloses( "EclipseState", "Eclipse3DProperties" ) );
+    BOOST_CHECK( encloses( "EclipseState", "TransMult" ) );
+
+    Trace::clear();
+}
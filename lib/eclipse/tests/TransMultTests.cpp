@@ -43,4 +43,7 @@ BOOST_AUTO_TEST_CASE(Empty) {
 
     BOOST_CHECK_EQUAL( transMult.getMultiplier(9,9,9, Opm::FaceDir::YMinus) , 1.0 );
     BOOST_CHECK_EQUAL( transMult.getMultiplier(100 , Opm::FaceDir::ZMinus) , 1.0 );
+
+    BOOST_CHECK_EQUAL( transMult.getMultipliers(Opm::FaceDir::XPlus).size() , 1000U );
+    BOOST_CHECK_EQUAL( transMult.getMultipliers(Opm::FaceDir::XPlus).numMultipliers() , 0U );
 }